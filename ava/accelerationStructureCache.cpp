@@ -0,0 +1,394 @@
+#include "accelerationStructureCache.hpp"
+#include "detail/accelerationStructureCache.hpp"
+
+#include "buffer.hpp"
+#include "commandBuffer.hpp"
+#include "detail/buffer.hpp"
+#include "detail/commandBuffer.hpp"
+#include "detail/detail.hpp"
+#include "detail/rayTracing.hpp"
+#include "detail/state.hpp"
+#include "detail/utility.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace ava
+{
+    static bool isVersionDataCompatible(const uint8_t* versionData)
+    {
+        vk::AccelerationStructureVersionInfoKHR versionInfo{};
+        versionInfo.pVersionData = versionData;
+        return detail::State.device.getAccelerationStructureCompatibilityKHR(versionInfo, detail::State.dispatchLoader) == vk::AccelerationStructureCompatibilityKHR::eCompatible;
+    }
+
+    // Makes builds recorded in earlier submissions visible to the copies and queries which read the acceleration structures
+    static void insertAccelerationStructureReadBarrier(const CommandBuffer& commandBuffer)
+    {
+        vk::MemoryBarrier barrier{};
+        barrier.srcAccessMask = vk::AccessFlagBits::eAccelerationStructureWriteKHR;
+        barrier.dstAccessMask = vk::AccessFlagBits::eAccelerationStructureReadKHR;
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR, vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR, {}, barrier, nullptr, nullptr);
+    }
+
+    static std::vector<vk::DeviceSize> getSerializationSizes(const std::vector<vk::AccelerationStructureKHR>& accelerationStructures)
+    {
+        vk::QueryPoolCreateInfo queryPoolCreateInfo{};
+        queryPoolCreateInfo.queryType = vk::QueryType::eAccelerationStructureSerializationSizeKHR;
+        queryPoolCreateInfo.queryCount = static_cast<uint32_t>(accelerationStructures.size());
+        const auto queryPool = detail::State.device.createQueryPool(queryPoolCreateInfo);
+
+        const auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eGraphics);
+        insertAccelerationStructureReadBarrier(commandBuffer);
+        commandBuffer->commandBuffer.resetQueryPool(queryPool, 0, queryPoolCreateInfo.queryCount);
+        commandBuffer->commandBuffer.writeAccelerationStructuresPropertiesKHR(accelerationStructures, vk::QueryType::eAccelerationStructureSerializationSizeKHR, queryPool, 0, detail::State.dispatchLoader);
+        endSingleTimeCommands(commandBuffer);
+
+        std::vector<vk::DeviceSize> serializationSizes(accelerationStructures.size());
+        const auto result = detail::State.device.getQueryPoolResults(queryPool, 0, queryPoolCreateInfo.queryCount, serializationSizes.size() * sizeof(vk::DeviceSize), serializationSizes.data(), sizeof(vk::DeviceSize), vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+        detail::State.device.destroyQueryPool(queryPool);
+        AVA_CHECK(result == vk::Result::eSuccess, "Cannot save acceleration structure cache when the serialization sizes could not be queried");
+        return serializationSizes;
+    }
+
+    void saveAccelerationStructureCache(const std::string& fileName, const std::vector<BLAS>& blases, const std::vector<TLAS>& tlases)
+    {
+        AVA_CHECK(detail::State.rayTracingEnabled, "Cannot save acceleration structure cache when ray tracing is not enabled");
+        AVA_CHECK(!blases.empty() || !tlases.empty(), "Cannot save acceleration structure cache without any acceleration structures");
+
+        std::vector<vk::AccelerationStructureKHR> accelerationStructures;
+        accelerationStructures.reserve(blases.size() + tlases.size());
+        // Serialised TLASes reference BLASes by address, which are swapped for indices into the cache
+        std::unordered_map<vk::DeviceAddress, uint64_t> blasIndices;
+        for (size_t i = 0; i < blases.size(); i++)
+        {
+            const auto blas = blases[i];
+            AVA_CHECK(blas != nullptr && blas->built && blas->accelerationStructure != nullptr, "Cannot save acceleration structure cache when one of the BLASes is not built");
+            AVA_CHECK(blas->type == detail::BLASType::Triangles && blas->meshBuffer != nullptr, "Cannot save acceleration structure cache with a BLAS which does not own its mesh, only BLASes created from a VIBO or VBO can be saved");
+            accelerationStructures.push_back(blas->accelerationStructure->accelerationStructure);
+            blasIndices[blas->accelerationStructure->accelerationStructureAddress] = i;
+        }
+        for (const auto tlas : tlases)
+        {
+            AVA_CHECK(tlas != nullptr && tlas->built && tlas->accelerationStructure != nullptr, "Cannot save acceleration structure cache when one of the TLASes is not built");
+            accelerationStructures.push_back(tlas->accelerationStructure->accelerationStructure);
+        }
+
+        const auto serializationSizes = getSerializationSizes(accelerationStructures);
+
+        // Lay out the payload, every BLAS's mesh followed by its serialised data, then the TLASes
+        std::vector<detail::AccelerationStructureCacheBLASEntry> blasEntries(blases.size());
+        std::vector<detail::AccelerationStructureCacheTLASEntry> tlasEntries(tlases.size());
+        vk::DeviceSize payloadSize = 0;
+        for (size_t i = 0; i < blases.size(); i++)
+        {
+            const auto blas = blases[i];
+            const auto meshBufferAddress = detail::getBufferDeviceAddress(blas->meshBuffer);
+            auto& entry = blasEntries[i];
+            entry.meshOffset = payloadSize;
+            entry.meshSize = blas->meshBuffer->size;
+            entry.vertexOffset = blas->vertexDeviceAddress - meshBufferAddress;
+            entry.indexOffset = blas->indexDeviceAddress - meshBufferAddress;
+            entry.maxVertex = blas->maxVertex;
+            entry.vertexStride = blas->vertexStride;
+            entry.indexType = static_cast<int32_t>(blas->indexType);
+            entry.indexCount = blas->indexCount;
+            entry.instanceCount = blas->instanceCount;
+            entry.buildFlags = static_cast<uint32_t>(blas->buildFlags);
+            entry.geometryFlags = static_cast<uint32_t>(blas->geometryFlags);
+            entry.compacted = blas->compacted ? 1 : 0;
+            entry.dataOffset = detail::alignUp(entry.meshOffset + entry.meshSize, detail::ACCELERATION_STRUCTURE_CACHE_ALIGNMENT);
+            entry.dataSize = serializationSizes[i];
+            payloadSize = detail::alignUp(entry.dataOffset + entry.dataSize, detail::ACCELERATION_STRUCTURE_CACHE_ALIGNMENT);
+        }
+        for (size_t i = 0; i < tlases.size(); i++)
+        {
+            auto& entry = tlasEntries[i];
+            entry.buildFlags = static_cast<uint32_t>(tlases[i]->lastBuildFlags);
+            entry.geometryFlags = static_cast<uint32_t>(tlases[i]->lastGeometryFlags);
+            entry.dataOffset = payloadSize;
+            entry.dataSize = serializationSizes[blases.size() + i];
+            payloadSize = detail::alignUp(entry.dataOffset + entry.dataSize, detail::ACCELERATION_STRUCTURE_CACHE_ALIGNMENT);
+        }
+
+        auto readbackBuffer = createBuffer(payloadSize, vk::BufferUsageFlagBits::eTransferDst, MemoryLocation::eGpuToCpu, detail::ACCELERATION_STRUCTURE_CACHE_ALIGNMENT);
+        const auto readbackAddress = detail::getBufferDeviceAddress(readbackBuffer);
+
+        const auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eGraphics);
+        insertAccelerationStructureReadBarrier(commandBuffer);
+        for (size_t i = 0; i < blases.size(); i++)
+        {
+            vk::BufferCopy copyRegion{};
+            copyRegion.srcOffset = 0;
+            copyRegion.dstOffset = blasEntries[i].meshOffset;
+            copyRegion.size = blasEntries[i].meshSize;
+            commandBuffer->commandBuffer.copyBuffer(blases[i]->meshBuffer->buffer, readbackBuffer->buffer, copyRegion);
+        }
+        for (size_t i = 0; i < accelerationStructures.size(); i++)
+        {
+            vk::CopyAccelerationStructureToMemoryInfoKHR copyInfo{};
+            copyInfo.src = accelerationStructures[i];
+            copyInfo.dst.deviceAddress = readbackAddress + ((i < blases.size()) ? blasEntries[i].dataOffset : tlasEntries[i - blases.size()].dataOffset);
+            copyInfo.mode = vk::CopyAccelerationStructureModeKHR::eSerialize;
+            commandBuffer->commandBuffer.copyAccelerationStructureToMemoryKHR(copyInfo, detail::State.dispatchLoader);
+        }
+        vk::MemoryBarrier hostBarrier{};
+        hostBarrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        hostBarrier.dstAccessMask = vk::AccessFlagBits::eHostRead;
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR | vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, hostBarrier, nullptr, nullptr);
+        endSingleTimeCommands(commandBuffer);
+
+        detail::State.allocator.invalidateAllocation(readbackBuffer->allocation, 0, vk::WholeSize);
+        const auto payload = static_cast<uint8_t*>(readbackBuffer->mapped);
+
+        for (const auto& entry : tlasEntries)
+        {
+            const auto data = payload + entry.dataOffset;
+            uint64_t handleCount;
+            std::memcpy(&handleCount, data + detail::SERIALIZED_HANDLE_COUNT_OFFSET, sizeof(uint64_t));
+            AVA_CHECK(detail::SERIALIZED_HANDLES_OFFSET + handleCount * sizeof(uint64_t) <= entry.dataSize, "Cannot save acceleration structure cache when a serialized TLAS has more BLAS handles than fit in its data");
+            for (uint64_t h = 0; h < handleCount; h++)
+            {
+                const auto handleData = data + detail::SERIALIZED_HANDLES_OFFSET + h * sizeof(uint64_t);
+                uint64_t handle;
+                std::memcpy(&handle, handleData, sizeof(uint64_t));
+                if (handle == 0)
+                    continue; // Inactive instances stay inactive
+
+                const auto blasIndex = blasIndices.find(handle);
+                AVA_CHECK(blasIndex != blasIndices.end(), "Cannot save acceleration structure cache when a TLAS references a BLAS which is not being saved");
+                const uint64_t cacheHandle = blasIndex->second + 1; // 0 stays reserved for inactive instances
+                std::memcpy(handleData, &cacheHandle, sizeof(uint64_t));
+            }
+        }
+
+        detail::AccelerationStructureCacheHeader header{};
+        header.magic = detail::ACCELERATION_STRUCTURE_CACHE_MAGIC;
+        header.version = detail::ACCELERATION_STRUCTURE_CACHE_VERSION;
+        const auto firstDataOffset = blases.empty() ? tlasEntries.front().dataOffset : blasEntries.front().dataOffset;
+        std::memcpy(header.versionData, payload + firstDataOffset, detail::SERIALIZED_VERSION_DATA_SIZE);
+        header.blasCount = static_cast<uint32_t>(blasEntries.size());
+        header.tlasCount = static_cast<uint32_t>(tlasEntries.size());
+        header.payloadSize = payloadSize;
+
+        std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            destroyBuffer(readbackBuffer);
+            throw std::runtime_error("Failed to open file: " + fileName);
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(blasEntries.data()), static_cast<std::streamsize>(blasEntries.size() * sizeof(detail::AccelerationStructureCacheBLASEntry)));
+        file.write(reinterpret_cast<const char*>(tlasEntries.data()), static_cast<std::streamsize>(tlasEntries.size() * sizeof(detail::AccelerationStructureCacheTLASEntry)));
+        file.write(reinterpret_cast<const char*>(payload), static_cast<std::streamsize>(payloadSize));
+        file.close();
+
+        destroyBuffer(readbackBuffer);
+    }
+
+    // Written without overflow, as the entries of a corrupted cache can hold any value
+    static bool isCacheRangeValid(const uint64_t offset, const uint64_t size, const uint64_t payloadSize)
+    {
+        return offset <= payloadSize && size <= payloadSize - offset;
+    }
+
+    static uint64_t readSerializedValue(const std::vector<uint8_t>& payload, const uint64_t offset)
+    {
+        uint64_t value;
+        std::memcpy(&value, payload.data() + offset, sizeof(uint64_t));
+        return value;
+    }
+
+    // Deserialised data has to be aligned, fit in the payload and hold a non-zero deserialised size
+    static bool isSerializedDataValid(const uint64_t dataOffset, const uint64_t dataSize, const std::vector<uint8_t>& payload)
+    {
+        if (dataOffset % detail::ACCELERATION_STRUCTURE_CACHE_ALIGNMENT != 0 || !isCacheRangeValid(dataOffset, dataSize, payload.size()) || dataSize < detail::SERIALIZED_HANDLES_OFFSET)
+            return false;
+
+        return readSerializedValue(payload, dataOffset + detail::SERIALIZED_DESERIALIZED_SIZE_OFFSET) != 0;
+    }
+
+    // Checked before anything is allocated, as the entries of a corrupted cache can hold any value
+    static bool areCacheEntriesValid(const std::vector<detail::AccelerationStructureCacheBLASEntry>& blasEntries, const std::vector<detail::AccelerationStructureCacheTLASEntry>& tlasEntries, const std::vector<uint8_t>& payload)
+    {
+        for (const auto& entry : blasEntries)
+        {
+            if (entry.meshSize == 0 || !isCacheRangeValid(entry.meshOffset, entry.meshSize, payload.size()) || entry.vertexOffset >= entry.meshSize || entry.indexOffset > entry.meshSize)
+                return false;
+            const auto indexType = static_cast<vk::IndexType>(entry.indexType);
+            if (indexType != vk::IndexType::eUint16 && indexType != vk::IndexType::eUint32 && indexType != vk::IndexType::eNoneKHR)
+                return false;
+            if (!isSerializedDataValid(entry.dataOffset, entry.dataSize, payload))
+                return false;
+        }
+        for (const auto& entry : tlasEntries)
+        {
+            if (!isSerializedDataValid(entry.dataOffset, entry.dataSize, payload))
+                return false;
+
+            const uint64_t handleCount = readSerializedValue(payload, entry.dataOffset + detail::SERIALIZED_HANDLE_COUNT_OFFSET);
+            if (handleCount > (entry.dataSize - detail::SERIALIZED_HANDLES_OFFSET) / sizeof(uint64_t))
+                return false;
+
+            // Handles are indices into the cache's BLASes plus one, 0 being an inactive instance
+            for (uint64_t h = 0; h < handleCount; h++)
+            {
+                const uint64_t cacheHandle = readSerializedValue(payload, entry.dataOffset + detail::SERIALIZED_HANDLES_OFFSET + h * sizeof(uint64_t));
+                if (cacheHandle != 0 && cacheHandle - 1 >= blasEntries.size())
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    static bool readAccelerationStructureCacheHeader(std::ifstream& file, detail::AccelerationStructureCacheHeader& header)
+    {
+        if (!file.is_open())
+            return false;
+
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || header.magic != detail::ACCELERATION_STRUCTURE_CACHE_MAGIC || header.version != detail::ACCELERATION_STRUCTURE_CACHE_VERSION)
+            return false;
+
+        return isVersionDataCompatible(header.versionData);
+    }
+
+    bool isAccelerationStructureCacheCompatible(const std::string& fileName)
+    {
+        AVA_CHECK(detail::State.rayTracingEnabled, "Cannot check acceleration structure cache compatibility when ray tracing is not enabled");
+
+        std::ifstream file(fileName, std::ios::binary);
+        detail::AccelerationStructureCacheHeader header{};
+        return readAccelerationStructureCacheHeader(file, header);
+    }
+
+    std::optional<AccelerationStructureCache> loadAccelerationStructureCache(const std::string& fileName)
+    {
+        AVA_CHECK(detail::State.rayTracingEnabled, "Cannot load acceleration structure cache when ray tracing is not enabled");
+
+        std::ifstream file(fileName, std::ios::binary);
+        detail::AccelerationStructureCacheHeader header{};
+        if (!readAccelerationStructureCacheHeader(file, header))
+            return std::nullopt;
+
+        // The counts and payload size have to describe the file exactly before anything is sized from them
+        std::error_code fileSizeError;
+        const uint64_t fileSize = std::filesystem::file_size(fileName, fileSizeError);
+        const uint64_t entriesSize = static_cast<uint64_t>(header.blasCount) * sizeof(detail::AccelerationStructureCacheBLASEntry) + static_cast<uint64_t>(header.tlasCount) * sizeof(detail::AccelerationStructureCacheTLASEntry);
+        if (fileSizeError || fileSize < sizeof(header) || entriesSize > fileSize - sizeof(header) || header.payloadSize == 0 || header.payloadSize != fileSize - sizeof(header) - entriesSize)
+            return std::nullopt;
+
+        std::vector<detail::AccelerationStructureCacheBLASEntry> blasEntries(header.blasCount);
+        std::vector<detail::AccelerationStructureCacheTLASEntry> tlasEntries(header.tlasCount);
+        std::vector<uint8_t> payloadData(header.payloadSize);
+        file.read(reinterpret_cast<char*>(blasEntries.data()), static_cast<std::streamsize>(blasEntries.size() * sizeof(detail::AccelerationStructureCacheBLASEntry)));
+        file.read(reinterpret_cast<char*>(tlasEntries.data()), static_cast<std::streamsize>(tlasEntries.size() * sizeof(detail::AccelerationStructureCacheTLASEntry)));
+        file.read(reinterpret_cast<char*>(payloadData.data()), static_cast<std::streamsize>(payloadData.size()));
+        if (!file.good() || !areCacheEntriesValid(blasEntries, tlasEntries, payloadData))
+            return std::nullopt;
+        file.close();
+
+        // The staging buffer is the source of the whole upload
+        auto stagingBuffer = createBuffer(header.payloadSize, vk::BufferUsageFlagBits::eTransferSrc, MemoryLocation::eCpuToGpu, detail::ACCELERATION_STRUCTURE_CACHE_ALIGNMENT);
+        std::memcpy(stagingBuffer->mapped, payloadData.data(), payloadData.size());
+        payloadData = {};
+
+        const auto payload = static_cast<uint8_t*>(stagingBuffer->mapped);
+        auto getDeserializedSize = [payload](const uint64_t dataOffset)
+        {
+            vk::AccelerationStructureBuildSizesInfoKHR buildSizesInfo{};
+            std::memcpy(&buildSizesInfo.accelerationStructureSize, payload + dataOffset + detail::SERIALIZED_DESERIALIZED_SIZE_OFFSET, sizeof(uint64_t));
+            return buildSizesInfo;
+        };
+
+        AccelerationStructureCache cache{};
+        cache.blases.reserve(blasEntries.size());
+        for (const auto& entry : blasEntries)
+        {
+            const auto meshBuffer = createBuffer(entry.meshSize, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR, MemoryLocation::eGpuOnly, 0);
+            const auto meshBufferAddress = detail::getBufferDeviceAddress(meshBuffer);
+
+            const auto blas = new detail::BLAS();
+            blas->type = detail::BLASType::Triangles;
+            blas->accelerationStructure = detail::createAccelerationStructure(vk::AccelerationStructureTypeKHR::eBottomLevel, getDeserializedSize(entry.dataOffset));
+            blas->meshBuffer = meshBuffer;
+            blas->transformBuffer = nullptr;
+            blas->aabbBuffer = nullptr;
+            blas->maxVertex = entry.maxVertex;
+            blas->vertexStride = entry.vertexStride;
+            blas->indexType = static_cast<vk::IndexType>(entry.indexType);
+            blas->indexCount = entry.indexCount;
+            blas->vertexDeviceAddress = meshBufferAddress + entry.vertexOffset;
+            blas->indexDeviceAddress = meshBufferAddress + entry.indexOffset;
+            blas->instanceCount = entry.instanceCount;
+            blas->built = true;
+            blas->buildFlags = static_cast<vk::BuildAccelerationStructureFlagsKHR>(entry.buildFlags);
+            blas->geometryFlags = static_cast<vk::GeometryFlagsKHR>(entry.geometryFlags);
+            blas->compacted = entry.compacted != 0;
+            cache.blases.push_back(blas);
+        }
+
+        // Point the TLASes' BLAS handles at the new acceleration structures before uploading them
+        for (const auto& entry : tlasEntries)
+        {
+            const auto data = payload + entry.dataOffset;
+            uint64_t handleCount;
+            std::memcpy(&handleCount, data + detail::SERIALIZED_HANDLE_COUNT_OFFSET, sizeof(uint64_t));
+            for (uint64_t h = 0; h < handleCount; h++)
+            {
+                const auto handleData = data + detail::SERIALIZED_HANDLES_OFFSET + h * sizeof(uint64_t);
+                uint64_t cacheHandle;
+                std::memcpy(&cacheHandle, handleData, sizeof(uint64_t));
+                if (cacheHandle == 0)
+                    continue;
+
+                const uint64_t handle = cache.blases[cacheHandle - 1]->accelerationStructure->accelerationStructureAddress;
+                std::memcpy(handleData, &handle, sizeof(uint64_t));
+            }
+        }
+        detail::State.allocator.flushAllocation(stagingBuffer->allocation, 0, vk::WholeSize);
+
+        cache.tlases.reserve(tlasEntries.size());
+        for (const auto& entry : tlasEntries)
+        {
+            const auto tlas = detail::createTopLevelAccelerationStructure();
+            tlas->accelerationStructure = detail::createAccelerationStructure(vk::AccelerationStructureTypeKHR::eTopLevel, getDeserializedSize(entry.dataOffset));
+            tlas->built = true;
+            // There are no instances to update or refit from until the TLAS is rebuilt
+            tlas->lastBuildFlags = static_cast<vk::BuildAccelerationStructureFlagsKHR>(entry.buildFlags) & ~vk::BuildAccelerationStructureFlagsKHR(vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate);
+            tlas->lastGeometryFlags = static_cast<vk::GeometryFlagsKHR>(entry.geometryFlags);
+            tlas->lastBuildHash = 0;
+            cache.tlases.push_back(tlas);
+        }
+
+        const auto stagingAddress = detail::getBufferDeviceAddress(stagingBuffer);
+        const auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eGraphics);
+        for (size_t i = 0; i < blasEntries.size(); i++)
+        {
+            vk::BufferCopy copyRegion{};
+            copyRegion.srcOffset = blasEntries[i].meshOffset;
+            copyRegion.dstOffset = 0;
+            copyRegion.size = blasEntries[i].meshSize;
+            commandBuffer->commandBuffer.copyBuffer(stagingBuffer->buffer, cache.blases[i]->meshBuffer->buffer, copyRegion);
+
+            vk::CopyMemoryToAccelerationStructureInfoKHR copyInfo{};
+            copyInfo.src.deviceAddress = stagingAddress + blasEntries[i].dataOffset;
+            copyInfo.dst = cache.blases[i]->accelerationStructure->accelerationStructure;
+            copyInfo.mode = vk::CopyAccelerationStructureModeKHR::eDeserialize;
+            commandBuffer->commandBuffer.copyMemoryToAccelerationStructureKHR(copyInfo, detail::State.dispatchLoader);
+        }
+        for (size_t i = 0; i < tlasEntries.size(); i++)
+        {
+            vk::CopyMemoryToAccelerationStructureInfoKHR copyInfo{};
+            copyInfo.src.deviceAddress = stagingAddress + tlasEntries[i].dataOffset;
+            copyInfo.dst = cache.tlases[i]->accelerationStructure->accelerationStructure;
+            copyInfo.mode = vk::CopyAccelerationStructureModeKHR::eDeserialize;
+            commandBuffer->commandBuffer.copyMemoryToAccelerationStructureKHR(copyInfo, detail::State.dispatchLoader);
+        }
+        endSingleTimeCommands(commandBuffer);
+
+        destroyBuffer(stagingBuffer);
+        return cache;
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef AVA_ACCELERATIONSTRUCTURECACHE_HPP
+#define AVA_ACCELERATIONSTRUCTURECACHE_HPP
+
+#include "types.hpp"
+
+namespace ava
+{
+    struct AccelerationStructureCache
+    {
+        std::vector<BLAS> blases; // In the order they were saved
+        std::vector<TLAS> tlases;
+    };
+
+    // Serialises built BLASes and TLASes along with the BLASes' mesh buffers into fileName
+    // Only BLASes created from a VIBO or VBO can be saved, as they own their mesh. Every BLAS a TLAS references must be saved with it
+    void saveAccelerationStructureCache(const std::string& fileName, const std::vector<BLAS>& blases, const std::vector<TLAS>& tlases);
+    // False when the file cannot be read, is not a cache or was serialised by an incompatible device or driver
+    bool isAccelerationStructureCacheCompatible(const std::string& fileName);
+    // Restores the BLASes, their mesh buffers and the TLASes with one upload and a single time command
+    // Returns std::nullopt when the cache is not compatible or is corrupted, so the caller can fall back to building. Restored TLASes have to be rebuilt before they can be updated or refit
+    std::optional<AccelerationStructureCache> loadAccelerationStructureCache(const std::string& fileName);
+}
+
+#endif
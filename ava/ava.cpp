@@ -5,6 +5,7 @@
 #include "ava.hpp"
 
 #include "detail/detail.hpp"
+#include "detail/frame.hpp"
 #include "detail/state.hpp"
 
 namespace ava
@@ -30,6 +31,8 @@ namespace ava
     {
         AVA_CHECK(State.device, "Cannot wait idle on an invalid device");
         State.device.waitIdle();
+        // Nothing can be in use anymore
+        releaseRetiredObjects(true);
     }
 
     vk::Extent2D getSwapchainExtent()
@@ -17,7 +17,17 @@
 #include "descriptors.hpp"
 #include "ibo.hpp"
 #include "vbo.hpp"
+#include "instanceBuffer.hpp"
 #include "rayTracing.hpp"
+#include "accelerationStructureCache.hpp"
+#include "culling.hpp"
+#include "geometryArena.hpp"
+#include "texture.hpp"
+#include "textureStreamer.hpp"
+#include "memoryPool.hpp"
+#include "memoryStatistics.hpp"
+#include "defragmentation.hpp"
+#include "transientImageSet.hpp"
 
 namespace ava
 {
@@ -5,15 +5,27 @@
 #include "commandBuffer.hpp"
 #include "detail/commandBuffer.hpp"
 #include "detail/detail.hpp"
+#include "detail/memoryPool.hpp"
 #include "detail/state.hpp"
 
 namespace ava
 {
-    Buffer createBuffer(const vk::DeviceSize size, const vk::BufferUsageFlags bufferUsage, const MemoryLocation bufferLocation, const vk::DeviceSize alignment)
+    // Acceleration structure storage is reported separately from other buffers
+    static MemoryObjectStatistics& getBufferMemoryStatistics(const vk::BufferUsageFlags bufferUsage)
+    {
+        if (bufferUsage & vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR)
+        {
+            return detail::State.accelerationStructureMemory;
+        }
+        return detail::State.bufferMemory;
+    }
+
+    Buffer createBuffer(const vk::DeviceSize size, const vk::BufferUsageFlags bufferUsage, const MemoryLocation bufferLocation, const vk::DeviceSize alignment, const MemoryPool& memoryPool)
     {
         AVA_CHECK(size > 0, "Cannot create a buffer with a size of 0");
         AVA_CHECK(detail::State.device, "Cannot create buffer when State's device is invalid");
         AVA_CHECK(detail::State.allocator, "Cannot create buffer when State's allocator is invalid");
+        AVA_CHECK(memoryPool == nullptr || (!memoryPool->holdsImages && memoryPool->memoryLocation == bufferLocation), "Cannot create buffer with a memory pool which is for images or another memory location");
 
         vk::BufferCreateInfo bufferCreateInfo{};
         bufferCreateInfo.size = size;
@@ -26,8 +38,18 @@ namespace ava
             bufferCreateInfo.usage |= vk::BufferUsageFlagBits::eShaderDeviceAddress;
         }
 
+        // With ray tracing enabled vertex and index buffers can be referenced directly by BLAS geometries
+        if (detail::State.rayTracingEnabled && (bufferUsage & (vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer)) != vk::BufferUsageFlags{})
+        {
+            bufferCreateInfo.usage |= vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR;
+        }
+
         vma::AllocationCreateInfo allocationCreateInfo{};
         allocationCreateInfo.usage = getMemoryUsageFromBufferLocation(bufferLocation);
+        if (memoryPool != nullptr)
+        {
+            allocationCreateInfo.pool = memoryPool->pool;
+        }
         vk::Buffer buffer;
         vma::Allocation allocation;
         if (alignment == 0)
@@ -42,9 +64,15 @@ namespace ava
             buffer = first;
             allocation = second;
         }
+        const bool withinBudget = detail::isMemoryPoolWithinBudget(memoryPool);
+        if (!withinBudget)
+        {
+            detail::State.allocator.destroyBuffer(buffer, allocation);
+        }
+        AVA_CHECK(withinBudget, "Cannot create buffer of " + std::to_string(size) + " bytes when it would take memory pool " + memoryPool->name + " over its budget of " + std::to_string(memoryPool->budget) + " bytes");
         const auto allocationInfo = detail::State.allocator.getAllocationInfo(allocation);
         void* mapped = nullptr;
-        if (bufferLocation == MemoryLocation::eCpuToGpu)
+        if (bufferLocation == MemoryLocation::eCpuToGpu || bufferLocation == MemoryLocation::eGpuToCpu)
         {
             mapped = detail::State.allocator.mapMemory(allocation);
             std::memset(mapped, 0, size);
@@ -54,11 +82,18 @@ namespace ava
         outBuffer->buffer = buffer;
         outBuffer->allocation = allocation;
         outBuffer->allocationInfo = allocationInfo;
-        outBuffer->bufferUsage = bufferUsage;
+        outBuffer->bufferUsage = bufferCreateInfo.usage;
         outBuffer->bufferLocation = bufferLocation;
         outBuffer->alignment = alignment;
         outBuffer->mapped = mapped;
         outBuffer->size = size;
+        outBuffer->creationInfo = bufferCreateInfo;
+        outBuffer->allocationOwner = detail::AllocationOwner{detail::AllocationOwnerType::eBuffer, outBuffer};
+        detail::State.allocator.setAllocationUserData(allocation, &outBuffer->allocationOwner);
+
+        auto& memoryStatistics = getBufferMemoryStatistics(outBuffer->bufferUsage);
+        memoryStatistics.count++;
+        memoryStatistics.bytes += allocationInfo.size;
 
         return outBuffer;
     }
@@ -78,7 +113,20 @@ namespace ava
                 {
                     detail::State.allocator.unmapMemory(buffer->allocation);
                 }
-                detail::State.allocator.destroyBuffer(buffer->buffer, buffer->allocation);
+                if (buffer->defragmentationMove != nullptr)
+                {
+                    // Both the moved from and moved to memory are freed when the pending pass ends
+                    detail::State.device.destroyBuffer(buffer->buffer);
+                    buffer->defragmentationMove->operation = vma::DefragmentationMoveOperation::eDestroy;
+                }
+                else
+                {
+                    detail::State.allocator.destroyBuffer(buffer->buffer, buffer->allocation);
+                }
+
+                auto& memoryStatistics = getBufferMemoryStatistics(buffer->bufferUsage);
+                memoryStatistics.count--;
+                memoryStatistics.bytes -= buffer->allocationInfo.size;
             }
             else
             {
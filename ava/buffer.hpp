@@ -13,9 +13,10 @@ namespace ava
     constexpr vk::BufferUsageFlags DEFAULT_VERTEX_BUFFER_USAGE = vk::BufferUsageFlagBits::eVertexBuffer | DEFAULT_TRANSFER_BUFFER_USAGE;
     constexpr vk::BufferUsageFlags DEFAULT_INDEX_BUFFER_USAGE = vk::BufferUsageFlagBits::eIndexBuffer | DEFAULT_TRANSFER_BUFFER_USAGE;
     constexpr vk::BufferUsageFlags DEFAULT_COMBINED_VERTEX_INDEX_BUFFER_USAGE = DEFAULT_VERTEX_BUFFER_USAGE | DEFAULT_INDEX_BUFFER_USAGE;
+    constexpr vk::BufferUsageFlags DEFAULT_INDIRECT_BUFFER_USAGE = vk::BufferUsageFlagBits::eIndirectBuffer | DEFAULT_STORAGE_BUFFER_USAGE;
 
-    // General buffer creation
-    [[nodiscard]] Buffer createBuffer(vk::DeviceSize size, vk::BufferUsageFlags bufferUsage, MemoryLocation bufferLocation = MemoryLocation::eGpuOnly, vk::DeviceSize alignment = 0);
+    // General buffer creation. A memory pool has to be for buffers of the same memory location
+    [[nodiscard]] Buffer createBuffer(vk::DeviceSize size, vk::BufferUsageFlags bufferUsage, MemoryLocation bufferLocation = MemoryLocation::eGpuOnly, vk::DeviceSize alignment = 0, const MemoryPool& memoryPool = nullptr);
     // Destroys any buffer
     void destroyBuffer(Buffer& buffer);
 
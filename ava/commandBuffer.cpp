@@ -4,6 +4,8 @@
 #include "detail/state.hpp"
 #include "detail/commandBuffer.hpp"
 
+#include "detail/buffer.hpp"
+#include "detail/image.hpp"
 #include "detail/renderPass.hpp"
 
 namespace ava
@@ -77,8 +79,17 @@ namespace ava
             endCommandBuffer(commandBuffer);
         }
 
+        // Images created since the last submission are transitioned to their initial layout first, only on the graphics queue as presentFrame does
+        const auto imageTransitionCommandBuffer = commandBuffer->primaryQueue != vk::QueueFlagBits::eCompute ? recordPendingImageTransitions() : nullptr;
+        std::vector<vk::CommandBuffer> submitCommandBuffers;
+        if (imageTransitionCommandBuffer != nullptr)
+        {
+            submitCommandBuffers.push_back(imageTransitionCommandBuffer->commandBuffer);
+        }
+        submitCommandBuffers.push_back(commandBuffer->commandBuffer);
+
         vk::SubmitInfo submitInfo{};
-        submitInfo.setCommandBuffers(commandBuffer->commandBuffer);
+        submitInfo.setCommandBuffers(submitCommandBuffers);
 
         constexpr vk::FenceCreateInfo fenceCreateInfo{vk::FenceCreateFlagBits::eSignaled};
 
@@ -115,6 +126,7 @@ namespace ava
 
         State.device.destroyFence(fence);
         State.device.freeCommandBuffers(pool, commandBuffer->commandBuffer);
+        freePendingImageTransitions(imageTransitionCommandBuffer);
 
         vk::detail::resultCheck(result, "endSingleTimeCommands failed waiting on submission fence");
     }
@@ -196,6 +208,46 @@ namespace ava
         commandBuffer->commandBuffer.drawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
     }
 
+    void drawIndirect(const ava::CommandBuffer& commandBuffer, const ava::Buffer& buffer, const vk::DeviceSize offset, const uint32_t drawCount, const uint32_t stride)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot drawIndirect with an invalid command buffer");
+        AVA_CHECK(buffer != nullptr && buffer->buffer, "Cannot drawIndirect with an invalid buffer");
+        AVA_CHECK((buffer->bufferUsage & vk::BufferUsageFlagBits::eIndirectBuffer) != vk::BufferUsageFlags{}, "Cannot drawIndirect from a buffer without eIndirectBuffer usage");
+        AVA_CHECK(drawCount <= 1 || State.multiDrawIndirectEnabled, "Cannot drawIndirect with a draw count greater than 1 when the multiDrawIndirect feature is not enabled");
+
+        commandBuffer->commandBuffer.drawIndirect(buffer->buffer, offset, drawCount, stride);
+    }
+
+    void drawIndexedIndirect(const ava::CommandBuffer& commandBuffer, const ava::Buffer& buffer, const vk::DeviceSize offset, const uint32_t drawCount, const uint32_t stride)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot drawIndexedIndirect with an invalid command buffer");
+        AVA_CHECK(buffer != nullptr && buffer->buffer, "Cannot drawIndexedIndirect with an invalid buffer");
+        AVA_CHECK((buffer->bufferUsage & vk::BufferUsageFlagBits::eIndirectBuffer) != vk::BufferUsageFlags{}, "Cannot drawIndexedIndirect from a buffer without eIndirectBuffer usage");
+        AVA_CHECK(drawCount <= 1 || State.multiDrawIndirectEnabled, "Cannot drawIndexedIndirect with a draw count greater than 1 when the multiDrawIndirect feature is not enabled");
+
+        commandBuffer->commandBuffer.drawIndexedIndirect(buffer->buffer, offset, drawCount, stride);
+    }
+
+    void drawIndirectCount(const ava::CommandBuffer& commandBuffer, const ava::Buffer& buffer, const vk::DeviceSize offset, const ava::Buffer& countBuffer, const vk::DeviceSize countOffset, const uint32_t maxDrawCount, const uint32_t stride)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot drawIndirectCount with an invalid command buffer");
+        AVA_CHECK(buffer != nullptr && buffer->buffer, "Cannot drawIndirectCount with an invalid buffer");
+        AVA_CHECK(countBuffer != nullptr && countBuffer->buffer, "Cannot drawIndirectCount with an invalid count buffer");
+        AVA_CHECK(State.drawIndirectCountEnabled, "Cannot drawIndirectCount when the drawIndirectCount feature is not enabled");
+
+        commandBuffer->commandBuffer.drawIndirectCount(buffer->buffer, offset, countBuffer->buffer, countOffset, maxDrawCount, stride);
+    }
+
+    void drawIndexedIndirectCount(const ava::CommandBuffer& commandBuffer, const ava::Buffer& buffer, const vk::DeviceSize offset, const ava::Buffer& countBuffer, const vk::DeviceSize countOffset, const uint32_t maxDrawCount, const uint32_t stride)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot drawIndexedIndirectCount with an invalid command buffer");
+        AVA_CHECK(buffer != nullptr && buffer->buffer, "Cannot drawIndexedIndirectCount with an invalid buffer");
+        AVA_CHECK(countBuffer != nullptr && countBuffer->buffer, "Cannot drawIndexedIndirectCount with an invalid count buffer");
+        AVA_CHECK(State.drawIndirectCountEnabled, "Cannot drawIndexedIndirectCount when the drawIndirectCount feature is not enabled");
+
+        commandBuffer->commandBuffer.drawIndexedIndirectCount(buffer->buffer, offset, countBuffer->buffer, countOffset, maxDrawCount, stride);
+    }
+
     void pushConstants(const ava::CommandBuffer& commandBuffer, const vk::ShaderStageFlags shaderStages, const void* data, const uint32_t size, const uint32_t offset)
     {
         AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot set push constant values with an invalid command buffer");
@@ -25,6 +25,14 @@ namespace ava
     // indexCount of 0 means it will draw the number of indices in the currently bound IBO
     void drawIndexed(const CommandBuffer& commandBuffer, uint32_t indexCount = 0, uint32_t instanceCount = 1, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0);
 
+    // Indirect draws read their commands from a buffer created with eIndirectBuffer usage
+    // A drawCount greater than 1 requires the multiDrawIndirect device feature
+    void drawIndirect(const CommandBuffer& commandBuffer, const Buffer& buffer, vk::DeviceSize offset = 0, uint32_t drawCount = 1, uint32_t stride = sizeof(vk::DrawIndirectCommand));
+    void drawIndexedIndirect(const CommandBuffer& commandBuffer, const Buffer& buffer, vk::DeviceSize offset = 0, uint32_t drawCount = 1, uint32_t stride = sizeof(vk::DrawIndexedIndirectCommand));
+    // Draw count is read from countBuffer at countOffset. Requires the Vulkan 1.2 drawIndirectCount feature
+    void drawIndirectCount(const CommandBuffer& commandBuffer, const Buffer& buffer, vk::DeviceSize offset, const Buffer& countBuffer, vk::DeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride = sizeof(vk::DrawIndirectCommand));
+    void drawIndexedIndirectCount(const CommandBuffer& commandBuffer, const Buffer& buffer, vk::DeviceSize offset, const Buffer& countBuffer, vk::DeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride = sizeof(vk::DrawIndexedIndirectCommand));
+
     void pushConstants(const CommandBuffer& commandBuffer, vk::ShaderStageFlags shaderStages, const void* data, uint32_t size = 0, uint32_t offset = 0);
 
     template <typename T>
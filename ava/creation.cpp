@@ -7,6 +7,7 @@
 #include "detail/state.hpp"
 #include "detail/debugCallback.hpp"
 #include "detail/image.hpp"
+#include "detail/frame.hpp"
 
 namespace ava
 {
@@ -62,6 +63,15 @@ namespace ava
             instanceBuilder.enable_extension(extension);
         }
 
+        // Swapchain maintenance requires surface maintenance on the instance
+        State.surfaceMaintenanceEnabled = false;
+        if (createInfo.enableSwapchainMaintenance && systemInfo->is_extension_available(vk::EXTSurfaceMaintenance1ExtensionName) && systemInfo->is_extension_available(vk::KHRGetSurfaceCapabilities2ExtensionName))
+        {
+            instanceBuilder.enable_extension(vk::KHRGetSurfaceCapabilities2ExtensionName);
+            instanceBuilder.enable_extension(vk::EXTSurfaceMaintenance1ExtensionName);
+            State.surfaceMaintenanceEnabled = true;
+        }
+
         // Create vkb instance
         auto ibRet = instanceBuilder.build();
         AVA_CHECK(ibRet.has_value(), "Failed to create a Vulkan instance: " + ibRet.error().message());
@@ -218,6 +228,8 @@ namespace ava
         }
 
         physicalDeviceSelector.set_required_features(deviceFeatures);
+        State.multiDrawIndirectEnabled = deviceFeatures.multiDrawIndirect;
+        State.drawIndirectCountEnabled = createInfo.apiVersion.major == 1 && createInfo.apiVersion.minor >= 2 && physicalDeviceFeatures12.drawIndirectCount;
 
         // Only add the physicalDeviceFeatures11 if Vulkan >= 1.2
         // This means that physicalPNext can only be used when Vulkan 1.2 or higher is used, meaning extensions can only be used on Vulkan 1.2 and above
@@ -234,6 +246,67 @@ namespace ava
         State.vkbPhysicalDevice = pdsRet.value();
         State.physicalDevice = State.vkbPhysicalDevice.physical_device;
 
+        // Present id & present wait are optional, frame pacing falls back to fences without them
+        if (createInfo.enablePresentWait && State.vkbPhysicalDevice.enable_extensions_if_present({vk::KHRPresentIdExtensionName, vk::KHRPresentWaitExtensionName}))
+        {
+            vk::PhysicalDevicePresentIdFeaturesKHR presentIdFeatures{};
+            presentIdFeatures.presentId = true;
+            vk::PhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{};
+            presentWaitFeatures.presentWait = true;
+
+            const bool presentIdSupported = State.vkbPhysicalDevice.enable_extension_features_if_present(presentIdFeatures);
+            const bool presentWaitSupported = State.vkbPhysicalDevice.enable_extension_features_if_present(presentWaitFeatures);
+            State.presentWaitEnabled = presentIdSupported && presentWaitSupported;
+        }
+
+        if (State.surfaceMaintenanceEnabled && State.vkbPhysicalDevice.enable_extension_if_present(vk::EXTSwapchainMaintenance1ExtensionName))
+        {
+            vk::PhysicalDeviceSwapchainMaintenance1FeaturesEXT swapchainMaintenanceFeatures{};
+            swapchainMaintenanceFeatures.swapchainMaintenance1 = true;
+            State.swapchainMaintenanceEnabled = State.vkbPhysicalDevice.enable_extension_features_if_present(swapchainMaintenanceFeatures);
+        }
+
+        // Pipeline libraries are optional, ray tracing pipelines can always be created monolithically
+        if (State.rayTracingEnabled && State.vkbPhysicalDevice.enable_extension_if_present(vk::KHRPipelineLibraryExtensionName))
+        {
+            State.rayTracingPipelineLibraryEnabled = true;
+        }
+
+        // Host image copy is optional, updateImage falls back to staging buffers without it. Its dependencies are core in Vulkan 1.3
+        const bool hostImageCopyApiSupported = createInfo.apiVersion.major == 1 && createInfo.apiVersion.minor >= 3;
+        if (createInfo.enableHostImageCopy && hostImageCopyApiSupported && State.vkbPhysicalDevice.enable_extension_if_present(vk::EXTHostImageCopyExtensionName))
+        {
+            vk::PhysicalDeviceHostImageCopyFeaturesEXT hostImageCopyFeatures{};
+            hostImageCopyFeatures.hostImageCopy = true;
+            State.hostImageCopyEnabled = State.vkbPhysicalDevice.enable_extension_features_if_present(hostImageCopyFeatures);
+        }
+        if (State.hostImageCopyEnabled)
+        {
+            // First query the layout counts, then the layouts themselves
+            vk::PhysicalDeviceHostImageCopyPropertiesEXT hostImageCopyProperties{};
+            vk::PhysicalDeviceProperties2 properties2{};
+            properties2.pNext = &hostImageCopyProperties;
+            State.physicalDevice.getProperties2(&properties2);
+
+            State.hostImageCopyDstLayouts.resize(hostImageCopyProperties.copyDstLayoutCount);
+            hostImageCopyProperties.copySrcLayoutCount = 0;
+            hostImageCopyProperties.pCopyDstLayouts = State.hostImageCopyDstLayouts.data();
+            State.physicalDevice.getProperties2(&properties2);
+        }
+
+        // Without the memory budget extension VMA estimates heap budgets from heap sizes and its own allocations
+        const bool memoryBudgetApiSupported = createInfo.apiVersion.major == 1 && createInfo.apiVersion.minor >= 1;
+        if (createInfo.enableMemoryBudget && memoryBudgetApiSupported && State.vkbPhysicalDevice.enable_extension_if_present(vk::EXTMemoryBudgetExtensionName))
+        {
+            State.memoryBudgetEnabled = true;
+        }
+
+        // Storage images without a format are optional, only the built-in mipmap downsample pipeline needs them
+        vk::PhysicalDeviceFeatures storageImageWithoutFormatFeatures{};
+        storageImageWithoutFormatFeatures.shaderStorageImageReadWithoutFormat = true;
+        storageImageWithoutFormatFeatures.shaderStorageImageWriteWithoutFormat = true;
+        State.storageImageWithoutFormatEnabled = State.vkbPhysicalDevice.enable_features_if_present(storageImageWithoutFormatFeatures);
+
         // Logical device creation
         vkb::DeviceBuilder deviceBuilder{State.vkbPhysicalDevice};
         auto dbRet = deviceBuilder.build();
@@ -246,6 +319,10 @@ namespace ava
         vma::AllocatorCreateInfo allocatorCreateInfo;
         allocatorCreateInfo.vulkanApiVersion = vk::makeApiVersion(0, createInfo.apiVersion.major, createInfo.apiVersion.minor, createInfo.apiVersion.patch);
         allocatorCreateInfo.flags = createInfo.vmaAllocatorCreateFlags;
+        if (State.memoryBudgetEnabled)
+        {
+            allocatorCreateInfo.flags |= vma::AllocatorCreateFlagBits::eExtMemoryBudget;
+        }
         allocatorCreateInfo.instance = State.instance;
         allocatorCreateInfo.physicalDevice = State.physicalDevice;
         allocatorCreateInfo.device = State.device;
@@ -269,6 +346,10 @@ namespace ava
         State.computeQueueFlags = static_cast<vk::QueueFlags>(State.vkbDevice.queue_families.at(State.computeQueueFamilyIndex).queueFlags);
 
         // Create sync objects
+        AVA_CHECK(createInfo.framesInFlight > 0, "Cannot create state when framesInFlight is 0");
+        State.framesInFlight = createInfo.framesInFlight;
+        State.currentFrame = 0;
+        State.framePacing = createInfo.framePacing;
         vk::SemaphoreCreateInfo semaphoreCreateInfo{};
         vk::FenceCreateInfo fenceCreateInfo{vk::FenceCreateFlagBits::eSignaled};
         for (uint32_t i = 0; i < State.framesInFlight; i++)
@@ -276,7 +357,16 @@ namespace ava
             State.imageAvailableSemaphores.push_back(State.device.createSemaphore(semaphoreCreateInfo));
             State.renderFinishedSemaphores.push_back(State.device.createSemaphore(semaphoreCreateInfo));
             State.inFlightGraphicsFences.push_back(State.device.createFence(fenceCreateInfo));
+            if (State.swapchainMaintenanceEnabled)
+            {
+                // Unsignaled, as a present fence must not be signaled when handed to a present
+                State.presentFences.push_back(State.device.createFence(vk::FenceCreateInfo{}));
+            }
         }
+        State.presentFencePending.assign(State.framesInFlight, false);
+        State.frameSerials.assign(State.framesInFlight, 0);
+        State.submittedFrameSerial = 0;
+        State.completedFrameSerial = 0;
 
         // Create command pools (graphics & compute)
         vk::CommandPoolCreateInfo graphicsPoolCreateInfo;
@@ -294,6 +384,38 @@ namespace ava
         // Allocate frame graphic command buffers
         State.frameGraphicsCommandBuffers = createGraphicsCommandBuffers(State.framesInFlight, false);
 
+        // Frame timestamps are written by small pre-recorded command buffers submitted either side of the frame's command buffer
+        const auto timestampValidBits = State.vkbDevice.queue_families.at(State.graphicsQueueFamilyIndex).timestampValidBits;
+        if (createInfo.enableFrameTimestamps && timestampValidBits > 0)
+        {
+            State.timestampPeriod = State.physicalDevice.getProperties().limits.timestampPeriod;
+            State.timestampMask = timestampValidBits >= 64 ? ~0ull : (1ull << timestampValidBits) - 1;
+
+            vk::QueryPoolCreateInfo queryPoolCreateInfo{};
+            queryPoolCreateInfo.queryType = vk::QueryType::eTimestamp;
+            queryPoolCreateInfo.queryCount = State.framesInFlight * 2;
+            State.frameTimestampQueryPool = State.device.createQueryPool(queryPoolCreateInfo);
+
+            State.frameTimestampBeginCommandBuffers = createGraphicsCommandBuffers(State.framesInFlight, false);
+            State.frameTimestampEndCommandBuffers = createGraphicsCommandBuffers(State.framesInFlight, false);
+            for (uint32_t i = 0; i < State.framesInFlight; i++)
+            {
+                const auto& beginTimestampCommandBuffer = State.frameTimestampBeginCommandBuffers[i];
+                startCommandBuffer(beginTimestampCommandBuffer, {});
+                beginTimestampCommandBuffer->commandBuffer.resetQueryPool(State.frameTimestampQueryPool, i * 2, 2);
+                beginTimestampCommandBuffer->commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, State.frameTimestampQueryPool, i * 2);
+                endCommandBuffer(beginTimestampCommandBuffer);
+
+                const auto& endTimestampCommandBuffer = State.frameTimestampEndCommandBuffers[i];
+                startCommandBuffer(endTimestampCommandBuffer, {});
+                endTimestampCommandBuffer->commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, State.frameTimestampQueryPool, i * 2 + 1);
+                endCommandBuffer(endTimestampCommandBuffer);
+            }
+        }
+        State.frameSubmitted.assign(State.framesInFlight, false);
+        State.frameNumber = 0;
+        State.lastFrameStartTime = {};
+
         // Check lazily allocated memory is available
         const auto memoryProperties = State.physicalDevice.getMemoryProperties();
         for (auto& memoryType : memoryProperties.memoryTypes)
@@ -328,6 +450,9 @@ namespace ava
 
         // Destroy state
         {
+            // The device is idle so every retired object can be released
+            releaseRetiredObjects(true);
+
             // Destroy sync objects
             for (auto& imageAvailableSemaphore : State.imageAvailableSemaphores)
             {
@@ -347,7 +472,33 @@ namespace ava
                     State.device.destroyFence(inFlightGraphicsFence);
             }
             State.inFlightGraphicsFences.clear();
+            for (auto& presentFence : State.presentFences)
+            {
+                if (presentFence)
+                    State.device.destroyFence(presentFence);
+            }
+            State.presentFences.clear();
+            State.presentFencePending.clear();
+            State.frameSerials.clear();
             State.frameGraphicsCommandBuffers.clear();
+            State.frameTimestampBeginCommandBuffers.clear();
+            State.frameTimestampEndCommandBuffers.clear();
+            State.frameSubmitted.clear();
+            if (State.frameTimestampQueryPool)
+            {
+                State.device.destroyQueryPool(State.frameTimestampQueryPool);
+                State.frameTimestampQueryPool = nullptr;
+            }
+
+            if (State.accelerationStructureScratchBuffer != nullptr)
+            {
+                destroyBuffer(State.accelerationStructureScratchBuffer);
+            }
+            if (State.mipmapDownsamplePipeline != nullptr)
+            {
+                destroyComputePipeline(State.mipmapDownsamplePipeline);
+            }
+            State.pendingImageTransitions.clear();
 
             // Destroy command pools
             if (State.graphicsCommandPool)
@@ -405,7 +556,27 @@ namespace ava
             }
             State.resizeNeeded = true;
             State.shaderDeviceAddressEnabled = false;
+            State.multiDrawIndirectEnabled = false;
+            State.drawIndirectCountEnabled = false;
+            State.hostImageCopyEnabled = false;
+            State.hostImageCopyDstLayouts.clear();
+            State.memoryBudgetEnabled = false;
+            State.storageImageWithoutFormatEnabled = false;
+            State.bufferMemory = {};
+            State.imageMemory = {};
+            State.accelerationStructureMemory = {};
+            State.descriptorPools.clear();
+            State.descriptorPoolCount = 0;
+            State.descriptorCount = 0;
+            State.samplerCache.clear();
+            State.presentWaitEnabled = false;
+            State.swapchainMaintenanceEnabled = false;
+            State.lastPresentId = 0;
+            State.cpuFrameTime = 0.0;
+            State.cpuWaitTime = 0.0;
+            State.gpuFrameTime = 0.0;
             State.rayTracingEnabled = false;
+            State.rayTracingPipelineLibraryEnabled = false;
             State.stateCreated = false;
         }
 
@@ -424,6 +595,7 @@ namespace ava
                 vkb::destroy_instance(State.vkbInstance);
                 State.instance = nullptr;
             }
+            State.surfaceMaintenanceEnabled = false;
             State.stateConfigured = false;
         }
     }
@@ -433,24 +605,39 @@ namespace ava
         destroyState(true);
     }
 
-    void createSwapchain(const vk::SurfaceKHR surface, const vk::Extent2D extent, const vk::Format desiredFormat, const vk::ColorSpaceKHR colorSpace, const vk::PresentModeKHR presentMode)
+    // Hands the current swapchain and its images to the retired objects, frames in flight may still be rendering to or presenting them
+    static void retireSwapchain()
     {
-        for (auto& imageView : State.swapchainImageViews)
-        {
-            State.device.destroyImageView(imageView);
-            imageView = nullptr;
-        }
-        for (auto& avaImageView : State.swapchainAvaImageViews)
-        {
-            delete avaImageView;
-            avaImageView = nullptr;
-        }
-        for (auto& avaImage : State.swapchainAvaImages)
+        auto retiredSwapchain = std::shared_ptr<void>(nullptr, [swapchain = State.vkbSwapchain, imageViews = State.swapchainImageViews, avaImages = State.swapchainAvaImages, avaImageViews = State.swapchainAvaImageViews](void*) mutable
         {
-            delete avaImage;
-            avaImage = nullptr;
-        }
+            for (auto& imageView : imageViews)
+            {
+                State.device.destroyImageView(imageView);
+            }
+            for (auto& avaImageView : avaImageViews)
+            {
+                delete avaImageView;
+            }
+            for (auto& avaImage : avaImages)
+            {
+                delete avaImage;
+            }
+            vkb::destroy_swapchain(swapchain);
+        });
+
+        // Without present fences there is no way to know when the last present finished, so wait a full frame cycle beyond the last submission
+        retireObject(retiredSwapchain, State.swapchainMaintenanceEnabled ? 0 : State.framesInFlight);
+
+        State.vkbSwapchain = {};
+        State.swapchain = nullptr;
+        State.swapchainImages.clear();
+        State.swapchainImageViews.clear();
+        State.swapchainAvaImages.clear();
+        State.swapchainAvaImageViews.clear();
+    }
 
+    void createSwapchain(const vk::SurfaceKHR surface, const vk::Extent2D extent, const vk::Format desiredFormat, const vk::ColorSpaceKHR colorSpace, const vk::PresentModeKHR presentMode)
+    {
         vkb::SwapchainBuilder swapchainBuilder{State.vkbDevice, surface};
         vk::SurfaceFormatKHR surfaceFormat{desiredFormat, colorSpace};
         swapchainBuilder
@@ -463,20 +650,10 @@ namespace ava
         }
 
         auto sbRet = swapchainBuilder.build();
+        AVA_CHECK(sbRet.has_value(), "Failed to create Vulkan swapchain: " + sbRet.error().message());
         if (State.vkbSwapchain)
         {
-            if (sbRet.has_value()) // If swapchain recreated
-            {
-                vkb::destroy_swapchain(State.vkbSwapchain);
-            }
-            else
-            {
-                State.vkbSwapchain.swapchain = nullptr;
-            }
-        }
-        else
-        {
-            AVA_CHECK(sbRet.has_value(), "Failed to create Vulkan swapchain: " + sbRet.error().message());
+            retireSwapchain();
         }
 
         State.vkbSwapchain = sbRet.value();
@@ -485,6 +662,7 @@ namespace ava
         State.swapchainImageFormat = static_cast<vk::Format>(State.vkbSwapchain.image_format);
         State.swapchainExtent = State.vkbSwapchain.extent;
         State.swapchainImageCount = State.vkbSwapchain.image_count;
+        State.lastPresentId = 0;
 
         // Assign the swapchain
         State.swapchainImageViews.resize(State.swapchainImageCount);
@@ -8,6 +8,12 @@
 
 namespace ava
 {
+    enum class FramePacing
+    {
+        eThroughput, // startFrame only waits for the frame slot's fence, the CPU can run up to framesInFlight frames ahead
+        eLowLatency, // startFrame waits until the previous frame has been presented (or finished on the GPU without present wait)
+    };
+
     struct CreateInfo
     {
         std::string appName; // App name
@@ -25,6 +31,13 @@ namespace ava
         vk::PhysicalDeviceVulkan14Features deviceVulkan14Features{}; // Set desired Vulkan 1.4 features (Requires Vulkan 1.4!)
         void* physicalPNextChain = nullptr; // Requires Vulkan 1.2 due to the implementation conflicts with vk-bootstrap
         vma::AllocatorCreateFlags vmaAllocatorCreateFlags = {}; // Configure the VMA allocator with these flags. Set these if you are using features like BufferDeviceAddress
+        uint32_t framesInFlight = 2; // Number of frames the CPU can record ahead of the GPU. 1 for lowest latency, 3 or more for throughput
+        FramePacing framePacing = FramePacing::eThroughput; // Can be changed later with setFramePacing
+        bool enablePresentWait = true; // Enables VK_KHR_present_id and VK_KHR_present_wait when supported, used by FramePacing::eLowLatency
+        bool enableSwapchainMaintenance = true; // Enables VK_EXT_swapchain_maintenance1 when supported, its present fences let old swapchains be released as soon as their presents complete
+        bool enableFrameTimestamps = true; // Measures each frame's GPU time with timestamp queries when supported by the graphics queue
+        bool enableHostImageCopy = true; // Enables VK_EXT_host_image_copy when supported (Requires Vulkan 1.3), lets updateImage write straight into images with eHostTransferEXT usage
+        bool enableMemoryBudget = true; // Enables VK_EXT_memory_budget when supported (Requires Vulkan 1.1), so getMemoryStatistics reports the driver's heap budgets and usage rather than estimates
     };
 
     // Configure state before you create your window (also creates Vulkan Instance)
@@ -34,7 +47,8 @@ namespace ava
     void createState(vk::SurfaceKHR surface);
     void destroyState();
 
-    // Also used for recreation of swapchain
+    // Also used for recreation of swapchain. The old swapchain and its images are retired rather than destroyed, so the device does not need to be idle
+    // Objects referencing the old swapchain images (e.g. framebuffers) should be retired with retireObject before being replaced
     void createSwapchain(vk::SurfaceKHR surface, vk::Extent2D extent, vk::Format desiredFormat = vk::Format::eB8G8R8A8Unorm, vk::ColorSpaceKHR colorSpace = vk::ColorSpaceKHR::eSrgbNonlinear, vk::PresentModeKHR presentMode = vk::PresentModeKHR::eFifo);
 }
 
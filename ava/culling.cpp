@@ -0,0 +1,374 @@
+#include "culling.hpp"
+
+#include "buffer.hpp"
+#include "commandBuffer.hpp"
+#include "compute.hpp"
+#include "descriptors.hpp"
+#include "image.hpp"
+#include "shaders.hpp"
+#include "detail/buffer.hpp"
+#include "detail/commandBuffer.hpp"
+#include "detail/culling.hpp"
+#include "detail/detail.hpp"
+#include "detail/image.hpp"
+#include "detail/shaders.hpp"
+#include "detail/state.hpp"
+#include "detail/utility.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace ava
+{
+    struct HiZPushConstants
+    {
+        uint32_t sourceSize[2];
+        uint32_t destinationSize[2];
+    };
+
+    static uint32_t previousPowerOf2(const uint32_t value)
+    {
+        uint32_t result = 1;
+        while (result <= value / 2)
+        {
+            result *= 2;
+        }
+        return result;
+    }
+
+    static void destroyHiZResources(ava::Image& image, ava::ImageView& imageView, std::vector<ava::ImageView>& mipImageViews)
+    {
+        for (auto& mipImageView : mipImageViews)
+        {
+            destroyImageView(mipImageView);
+        }
+        mipImageViews.clear();
+        if (imageView != nullptr)
+        {
+            destroyImageView(imageView);
+        }
+        if (image != nullptr)
+        {
+            destroyImage(image);
+        }
+    }
+
+    static void createHiZResources(const CullingPass& cullingPass, const vk::Extent2D extent)
+    {
+        const uint32_t mipLevels = std::min(static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height)))) + 1, detail::HIZ_MAX_MIP_LEVELS);
+
+        cullingPass->hiZImage = createImage(vk::Extent3D{extent, 1}, vk::Format::eR32Sfloat, vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled, vk::ImageType::e2D, vk::ImageTiling::eOptimal, mipLevels);
+        cullingPass->hiZImageView = createImageView(cullingPass->hiZImage, vk::ImageAspectFlagBits::eColor);
+        cullingPass->hiZMipImageViews.clear();
+        for (uint32_t mip = 0; mip < mipLevels; mip++)
+        {
+            cullingPass->hiZMipImageViews.push_back(createImageView(cullingPass->hiZImage, vk::ImageAspectFlagBits::eColor, vk::ImageViewType::e2D, {}, vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, mip, 1, 0, 1}));
+        }
+        cullingPass->hiZExtent = extent;
+        cullingPass->hiZMipLevels = mipLevels;
+        cullingPass->hiZBuilt = false;
+    }
+
+    static void insertHiZBarrier(const CommandBuffer& commandBuffer, const CullingPass& cullingPass, const uint32_t baseMip, const uint32_t mipCount, const vk::AccessFlags srcAccessMask, const vk::AccessFlags dstAccessMask)
+    {
+        // The Hi-Z image always stays in eGeneral, so only a memory dependency is needed
+        vk::ImageMemoryBarrier barrier{};
+        barrier.image = cullingPass->hiZImage->image;
+        barrier.oldLayout = vk::ImageLayout::eGeneral;
+        barrier.newLayout = vk::ImageLayout::eGeneral;
+        barrier.srcAccessMask = srcAccessMask;
+        barrier.dstAccessMask = dstAccessMask;
+        barrier.srcQueueFamilyIndex = commandBuffer->familyQueueIndex;
+        barrier.dstQueueFamilyIndex = commandBuffer->familyQueueIndex;
+        barrier.subresourceRange = vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, baseMip, mipCount, 0, 1};
+
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader, {}, nullptr, nullptr, barrier);
+    }
+
+    CullingPass createCullingPass(const CullingPassCreationInfo& creationInfo)
+    {
+        AVA_CHECK(detail::State.device, "Cannot create a culling pass when State's device is invalid");
+        AVA_CHECK(creationInfo.cullShader == nullptr || creationInfo.cullShader->module, "Cannot create a culling pass with an invalid cull shader");
+        AVA_CHECK(creationInfo.hiZShader == nullptr || creationInfo.hiZShader->module, "Cannot create a culling pass with an invalid Hi-Z shader");
+        AVA_CHECK(creationInfo.maxInstances > 0, "Cannot create a culling pass with a max instance count of 0");
+        AVA_CHECK(creationInfo.maxDrawTemplates > 0, "Cannot create a culling pass with a max draw template count of 0");
+        AVA_CHECK(detail::State.drawIndirectCountEnabled || detail::State.multiDrawIndirectEnabled, "Cannot create a culling pass when neither the drawIndirectCount nor the multiDrawIndirect features are enabled");
+
+        const auto framesInFlight = detail::State.framesInFlight;
+
+        const auto outCullingPass = new detail::CullingPass();
+        outCullingPass->maxInstances = creationInfo.maxInstances;
+        outCullingPass->indexed = creationInfo.indexed;
+
+        // The built-in shaders stand in for any shader that was not given
+        auto cullShader = creationInfo.cullShader != nullptr ? creationInfo.cullShader : detail::createCullingShader();
+        outCullingPass->cullPipeline = createComputePipeline(ComputePipelineCreationInfo{cullShader});
+        if (creationInfo.cullShader == nullptr)
+        {
+            destroyShader(cullShader);
+        }
+        outCullingPass->cullDescriptorPool = createDescriptorPool(outCullingPass->cullPipeline, framesInFlight);
+        outCullingPass->cullDescriptorSets = allocateDescriptorSets(outCullingPass->cullDescriptorPool, 0, framesInFlight);
+
+        auto hiZShader = creationInfo.hiZShader != nullptr ? creationInfo.hiZShader : detail::createHiZDownsampleShader();
+        outCullingPass->hiZPipeline = createComputePipeline(ComputePipelineCreationInfo{hiZShader});
+        if (creationInfo.hiZShader == nullptr)
+        {
+            destroyShader(hiZShader);
+        }
+        outCullingPass->hiZDescriptorPool = createDescriptorPool(outCullingPass->hiZPipeline, framesInFlight * detail::HIZ_MAX_MIP_LEVELS);
+        for (uint32_t i = 0; i < framesInFlight; i++)
+        {
+            outCullingPass->hiZDescriptorSets.push_back(allocateDescriptorSets(outCullingPass->hiZDescriptorPool, 0, detail::HIZ_MAX_MIP_LEVELS));
+        }
+
+        outCullingPass->drawTemplateBuffer = createBuffer(sizeof(vk::DrawIndexedIndirectCommand) * creationInfo.maxDrawTemplates, DEFAULT_STORAGE_BUFFER_USAGE);
+        outCullingPass->drawTemplateCount = creationInfo.maxDrawTemplates;
+        outCullingPass->drawCommandBuffer = createBuffer(sizeof(vk::DrawIndexedIndirectCommand) * creationInfo.maxInstances, DEFAULT_INDIRECT_BUFFER_USAGE);
+        outCullingPass->statisticsBuffer = createBuffer(sizeof(CullingStatistics), DEFAULT_INDIRECT_BUFFER_USAGE);
+        for (uint32_t i = 0; i < framesInFlight; i++)
+        {
+            outCullingPass->uniformBuffers.push_back(createUniformBuffer(sizeof(detail::CullingUniforms)));
+            outCullingPass->statisticsReadbackBuffers.push_back(createBuffer(sizeof(CullingStatistics), DEFAULT_TRANSFER_BUFFER_USAGE, MemoryLocation::eCpuToGpu));
+        }
+
+        // Placeholder pyramid so the cull shader always has a valid Hi-Z binding
+        createHiZResources(outCullingPass, vk::Extent2D{1, 1});
+        outCullingPass->lastViewProjectionValid = false;
+
+        return outCullingPass;
+    }
+
+    void destroyCullingPass(CullingPass& cullingPass)
+    {
+        AVA_CHECK_NO_EXCEPT_RETURN(cullingPass != nullptr, "Cannot destroy an invalid culling pass");
+        AVA_CHECK_NO_EXCEPT_RETURN(detail::State.device, "Cannot destroy culling pass when State's device is invalid");
+
+        destroyHiZResources(cullingPass->hiZImage, cullingPass->hiZImageView, cullingPass->hiZMipImageViews);
+
+        for (auto& buffer : cullingPass->statisticsReadbackBuffers)
+        {
+            destroyBuffer(buffer);
+        }
+        for (auto& buffer : cullingPass->uniformBuffers)
+        {
+            destroyBuffer(buffer);
+        }
+        destroyBuffer(cullingPass->statisticsBuffer);
+        destroyBuffer(cullingPass->drawCommandBuffer);
+        destroyBuffer(cullingPass->drawTemplateBuffer);
+
+        destroyDescriptorPool(cullingPass->hiZDescriptorPool);
+        destroyComputePipeline(cullingPass->hiZPipeline);
+        destroyDescriptorPool(cullingPass->cullDescriptorPool);
+        destroyComputePipeline(cullingPass->cullPipeline);
+
+        delete cullingPass;
+        cullingPass = nullptr;
+    }
+
+    void updateCullingDrawTemplates(const CullingPass& cullingPass, const std::vector<CullingDrawTemplate>& drawTemplates)
+    {
+        AVA_CHECK(cullingPass != nullptr, "Cannot update draw templates of an invalid culling pass");
+        AVA_CHECK(!drawTemplates.empty(), "Cannot update a culling pass with no draw templates");
+        AVA_CHECK(drawTemplates.size() <= cullingPass->drawTemplateCount, "Cannot update a culling pass with " + std::to_string(drawTemplates.size()) + " draw templates when it was created with a maximum of " + std::to_string(cullingPass->drawTemplateCount));
+
+        // Both command layouts are written from a DrawIndexedIndirectCommand sized template
+        std::vector<vk::DrawIndexedIndirectCommand> commands;
+        commands.reserve(drawTemplates.size());
+        for (const auto& drawTemplate : drawTemplates)
+        {
+            vk::DrawIndexedIndirectCommand command{};
+            command.indexCount = drawTemplate.indexCount;
+            command.instanceCount = 0;
+            command.firstIndex = drawTemplate.firstIndex;
+            command.vertexOffset = cullingPass->indexed ? drawTemplate.vertexOffset : 0;
+            command.firstInstance = 0;
+            commands.push_back(command);
+        }
+
+        updateBuffer(cullingPass->drawTemplateBuffer, commands);
+    }
+
+    void recordCulling(const CommandBuffer& commandBuffer, const CullingPass& cullingPass, const CullingParameters& parameters)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot record culling on an invalid command buffer");
+        AVA_CHECK(cullingPass != nullptr && cullingPass->cullPipeline != nullptr, "Cannot record culling with an invalid culling pass");
+        AVA_CHECK(parameters.instanceBuffer != nullptr && parameters.instanceBuffer->buffer, "Cannot record culling with an invalid instance buffer");
+        AVA_CHECK(parameters.instanceCount <= cullingPass->maxInstances, "Cannot record culling of " + std::to_string(parameters.instanceCount) + " instances when the culling pass was created with a maximum of " + std::to_string(cullingPass->maxInstances));
+        AVA_CHECK(parameters.instanceBuffer->size >= sizeof(CullingInstance) * parameters.instanceCount, "Cannot record culling when the instance buffer is smaller than instanceCount instances");
+
+        const auto frame = detail::State.currentFrame;
+        const bool occlusionCulling = parameters.occlusionCulling && cullingPass->hiZBuilt && cullingPass->lastViewProjectionValid;
+
+        detail::CullingUniforms uniforms{};
+        std::memcpy(uniforms.viewProjection, parameters.viewProjection, sizeof(uniforms.viewProjection));
+        // The pyramid was built from last frame's depth, so occlusion tests project with last frame's matrix
+        std::memcpy(uniforms.hiZViewProjection, occlusionCulling ? cullingPass->lastViewProjection : parameters.viewProjection, sizeof(uniforms.hiZViewProjection));
+        detail::extractFrustumPlanes(parameters.viewProjection, uniforms.frustumPlanes);
+        uniforms.hiZSize[0] = static_cast<float>(cullingPass->hiZExtent.width);
+        uniforms.hiZSize[1] = static_cast<float>(cullingPass->hiZExtent.height);
+        uniforms.instanceCount = parameters.instanceCount;
+        uniforms.flags = (parameters.frustumCulling ? detail::CULLING_FLAG_FRUSTUM : 0u) | (occlusionCulling ? detail::CULLING_FLAG_OCCLUSION : 0u) | (cullingPass->indexed ? 0u : detail::CULLING_FLAG_NON_INDEXED);
+        uniforms.hiZMipLevels = cullingPass->hiZMipLevels;
+        updateBuffer(cullingPass->uniformBuffers.at(frame), &uniforms, sizeof(uniforms));
+
+        std::memcpy(cullingPass->lastViewProjection, parameters.viewProjection, sizeof(cullingPass->lastViewProjection));
+        cullingPass->lastViewProjectionValid = true;
+
+        const auto& descriptorSet = cullingPass->cullDescriptorSets.at(frame);
+        bindBuffer(descriptorSet, 0, cullingPass->uniformBuffers.at(frame));
+        bindBuffer(descriptorSet, 1, parameters.instanceBuffer);
+        bindBuffer(descriptorSet, 2, cullingPass->drawTemplateBuffer);
+        bindBuffer(descriptorSet, 3, cullingPass->drawCommandBuffer);
+        bindBuffer(descriptorSet, 4, cullingPass->statisticsBuffer);
+        bindImage(descriptorSet, 5, cullingPass->hiZImage, cullingPass->hiZImageView, nullptr, vk::ImageLayout::eGeneral);
+
+        // Reset the counters (and the commands when draws are not counted) once previous frames are done reading them
+        constexpr auto previousStages = vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eTransfer;
+        constexpr auto previousAccess = vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eTransferRead;
+        insertBufferMemoryBarrier(commandBuffer, cullingPass->statisticsBuffer, previousStages, vk::PipelineStageFlagBits::eTransfer, previousAccess, vk::AccessFlagBits::eTransferWrite);
+        commandBuffer->commandBuffer.fillBuffer(cullingPass->statisticsBuffer->buffer, 0, vk::WholeSize, 0);
+        insertBufferMemoryBarrier(commandBuffer, cullingPass->statisticsBuffer, vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eComputeShader, vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite);
+        if (detail::State.drawIndirectCountEnabled)
+        {
+            insertBufferMemoryBarrier(commandBuffer, cullingPass->drawCommandBuffer, vk::PipelineStageFlagBits::eDrawIndirect, vk::PipelineStageFlagBits::eComputeShader, vk::AccessFlagBits::eIndirectCommandRead, vk::AccessFlagBits::eShaderWrite);
+        }
+        else
+        {
+            insertBufferMemoryBarrier(commandBuffer, cullingPass->drawCommandBuffer, previousStages, vk::PipelineStageFlagBits::eTransfer, previousAccess, vk::AccessFlagBits::eTransferWrite);
+            commandBuffer->commandBuffer.fillBuffer(cullingPass->drawCommandBuffer->buffer, 0, vk::WholeSize, 0);
+            insertBufferMemoryBarrier(commandBuffer, cullingPass->drawCommandBuffer, vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eComputeShader, vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderWrite);
+        }
+
+        bindComputePipeline(commandBuffer, cullingPass->cullPipeline);
+        bindDescriptorSet(commandBuffer, descriptorSet);
+        dispatch(commandBuffer, (parameters.instanceCount + detail::CULLING_WORKGROUP_SIZE - 1) / detail::CULLING_WORKGROUP_SIZE);
+
+        insertBufferMemoryBarrier(commandBuffer, cullingPass->drawCommandBuffer, vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eDrawIndirect, vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eIndirectCommandRead);
+        insertBufferMemoryBarrier(commandBuffer, cullingPass->statisticsBuffer, vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eTransfer, vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eTransferRead);
+
+        // Copy statistics for readback once this frame's fence has been waited on
+        const auto& readbackBuffer = cullingPass->statisticsReadbackBuffers.at(frame);
+        commandBuffer->commandBuffer.copyBuffer(cullingPass->statisticsBuffer->buffer, readbackBuffer->buffer, vk::BufferCopy{0, 0, sizeof(CullingStatistics)});
+        insertBufferMemoryBarrier(commandBuffer, readbackBuffer, vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eHostRead);
+    }
+
+    void buildHiZPyramid(const CommandBuffer& commandBuffer, const CullingPass& cullingPass, const Image& depthImage, const ImageView& depthImageView, const vk::ImageLayout depthLayout)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot build a Hi-Z pyramid on an invalid command buffer");
+        AVA_CHECK(cullingPass != nullptr, "Cannot build a Hi-Z pyramid with an invalid culling pass");
+        AVA_CHECK(depthImage != nullptr && depthImage->image, "Cannot build a Hi-Z pyramid from an invalid depth image");
+        AVA_CHECK(depthImageView != nullptr && depthImageView->imageView, "Cannot build a Hi-Z pyramid from an invalid depth image view");
+        AVA_CHECK((depthImage->creationInfo.usage & vk::ImageUsageFlagBits::eSampled) != vk::ImageUsageFlags{}, "Cannot build a Hi-Z pyramid from a depth image without eSampled usage");
+        AVA_CHECK(depthImage->creationInfo.samples == vk::SampleCountFlagBits::e1, "Cannot build a Hi-Z pyramid from a multisampled depth image");
+
+        const auto depthExtent = vk::Extent2D{depthImage->creationInfo.extent.width, depthImage->creationInfo.extent.height};
+        const auto hiZExtent = vk::Extent2D{previousPowerOf2(depthExtent.width), previousPowerOf2(depthExtent.height)};
+        if (hiZExtent != cullingPass->hiZExtent)
+        {
+            // Previous frames may still be reading the old pyramid, so release it when this command buffer's objects are untracked
+            auto oldImage = cullingPass->hiZImage;
+            auto oldImageView = cullingPass->hiZImageView;
+            auto oldMipImageViews = cullingPass->hiZMipImageViews;
+            trackObject(commandBuffer, std::shared_ptr<void>(nullptr, [oldImage, oldImageView, oldMipImageViews](void*) mutable
+            {
+                destroyHiZResources(oldImage, oldImageView, oldMipImageViews);
+            }));
+            createHiZResources(cullingPass, hiZExtent);
+        }
+
+        overrideOldImageLayout(depthImage, depthLayout);
+        transitionImageLayout(commandBuffer, depthImage, vk::ImageLayout::eShaderReadOnlyOptimal, getImageAspectFlagsForFormat(depthImage->creationInfo.format), vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests,
+                              vk::PipelineStageFlagBits::eComputeShader);
+
+        // Last frame's culling may still be reading the pyramid
+        insertHiZBarrier(commandBuffer, cullingPass, 0, cullingPass->hiZMipLevels, vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eShaderWrite);
+
+        const auto& descriptorSets = cullingPass->hiZDescriptorSets.at(detail::State.currentFrame);
+        bindComputePipeline(commandBuffer, cullingPass->hiZPipeline);
+
+        auto sourceExtent = depthExtent;
+        for (uint32_t mip = 0; mip < cullingPass->hiZMipLevels; mip++)
+        {
+            const auto destinationExtent = vk::Extent2D{std::max(hiZExtent.width >> mip, 1u), std::max(hiZExtent.height >> mip, 1u)};
+
+            const auto& descriptorSet = descriptorSets.at(mip);
+            if (mip == 0)
+            {
+                bindImage(descriptorSet, 0, depthImage, depthImageView, nullptr, vk::ImageLayout::eShaderReadOnlyOptimal);
+            }
+            else
+            {
+                bindImage(descriptorSet, 0, cullingPass->hiZImage, cullingPass->hiZMipImageViews.at(mip - 1), nullptr, vk::ImageLayout::eGeneral);
+            }
+            bindImage(descriptorSet, 1, cullingPass->hiZImage, cullingPass->hiZMipImageViews.at(mip), nullptr, vk::ImageLayout::eGeneral);
+
+            bindDescriptorSet(commandBuffer, descriptorSet);
+            const HiZPushConstants pushConstantData{{sourceExtent.width, sourceExtent.height}, {destinationExtent.width, destinationExtent.height}};
+            pushConstants(commandBuffer, vk::ShaderStageFlagBits::eCompute, pushConstantData);
+            dispatch(commandBuffer, (destinationExtent.width + detail::HIZ_WORKGROUP_SIZE - 1) / detail::HIZ_WORKGROUP_SIZE, (destinationExtent.height + detail::HIZ_WORKGROUP_SIZE - 1) / detail::HIZ_WORKGROUP_SIZE);
+
+            insertHiZBarrier(commandBuffer, cullingPass, mip, 1, vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eShaderRead);
+            sourceExtent = destinationExtent;
+        }
+
+        cullingPass->hiZBuilt = true;
+    }
+
+    void drawCulled(const CommandBuffer& commandBuffer, const CullingPass& cullingPass)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot draw culled instances with an invalid command buffer");
+        AVA_CHECK(cullingPass != nullptr, "Cannot draw culled instances with an invalid culling pass");
+
+        // Commands are always DrawIndexedIndirectCommand sized, non-indexed commands leave the last element unused
+        constexpr uint32_t stride = sizeof(vk::DrawIndexedIndirectCommand);
+        if (detail::State.drawIndirectCountEnabled)
+        {
+            if (cullingPass->indexed)
+            {
+                drawIndexedIndirectCount(commandBuffer, cullingPass->drawCommandBuffer, 0, cullingPass->statisticsBuffer, 0, cullingPass->maxInstances, stride);
+            }
+            else
+            {
+                drawIndirectCount(commandBuffer, cullingPass->drawCommandBuffer, 0, cullingPass->statisticsBuffer, 0, cullingPass->maxInstances, stride);
+            }
+        }
+        else // Culled slots are zeroed so they draw nothing
+        {
+            if (cullingPass->indexed)
+            {
+                drawIndexedIndirect(commandBuffer, cullingPass->drawCommandBuffer, 0, cullingPass->maxInstances, stride);
+            }
+            else
+            {
+                drawIndirect(commandBuffer, cullingPass->drawCommandBuffer, 0, cullingPass->maxInstances, stride);
+            }
+        }
+    }
+
+    CullingStatistics getCullingStatistics(const CullingPass& cullingPass)
+    {
+        AVA_CHECK(cullingPass != nullptr, "Cannot get culling statistics of an invalid culling pass");
+        AVA_CHECK(detail::State.allocator, "Cannot get culling statistics when State's allocator is invalid");
+
+        const auto& readbackBuffer = cullingPass->statisticsReadbackBuffers.at(detail::State.currentFrame);
+        detail::State.allocator.invalidateAllocation(readbackBuffer->allocation, 0, vk::WholeSize);
+
+        CullingStatistics statistics{};
+        std::memcpy(&statistics, readbackBuffer->mapped, sizeof(CullingStatistics));
+        return statistics;
+    }
+
+    Buffer getCullingDrawCommandBuffer(const CullingPass& cullingPass)
+    {
+        AVA_CHECK(cullingPass != nullptr, "Cannot get the draw command buffer of an invalid culling pass");
+        return cullingPass->drawCommandBuffer;
+    }
+
+    Buffer getCullingCountBuffer(const CullingPass& cullingPass)
+    {
+        AVA_CHECK(cullingPass != nullptr, "Cannot get the count buffer of an invalid culling pass");
+        return cullingPass->statisticsBuffer;
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef AVA_CULLING_HPP
+#define AVA_CULLING_HPP
+
+#include "types.hpp"
+
+namespace ava
+{
+    // GPU layout of one cullable instance, the instance buffer must be an array of these
+    struct CullingInstance
+    {
+        float transform[16]; // Column-major model matrix
+        float boundingSphere[4]; // Object space center (xyz) and radius (w)
+        uint32_t drawIndex; // Index into the draw templates given to updateCullingDrawTemplates
+        uint32_t padding[3];
+    };
+
+    // Draw template per mesh. instanceCount and firstInstance are written by the cull shader
+    // For non-indexed culling passes indexCount is used as vertexCount and firstIndex as firstVertex
+    struct CullingDrawTemplate
+    {
+        uint32_t indexCount;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+    };
+
+    struct CullingStatistics
+    {
+        uint32_t visibleCount;
+        uint32_t frustumCulledCount;
+        uint32_t occlusionCulledCount;
+        uint32_t totalCount;
+    };
+
+    struct CullingPassCreationInfo
+    {
+        // The cull shader writes one draw command per surviving instance with firstInstance set to the instance's index
+        // Optional, the built-in frustum and Hi-Z occlusion cull shader is used when not provided
+        Shader cullShader = nullptr;
+        // Optional, the built-in farthest depth downsampler is used when not provided
+        Shader hiZShader = nullptr;
+        uint32_t maxInstances = 0;
+        uint32_t maxDrawTemplates = 1; // Number of distinct meshes the instances can reference
+        bool indexed = true; // Write vk::DrawIndexedIndirectCommand (true) or vk::DrawIndirectCommand (false)
+    };
+
+    struct CullingParameters
+    {
+        Buffer instanceBuffer = nullptr; // Storage buffer of CullingInstance
+        uint32_t instanceCount = 0;
+        float viewProjection[16]{}; // Column-major, depth range [0, 1]
+        bool frustumCulling = true;
+        bool occlusionCulling = true; // Uses the last pyramid from buildHiZPyramid and the previous viewProjection
+    };
+
+    [[nodiscard]] CullingPass createCullingPass(const CullingPassCreationInfo& creationInfo);
+    void destroyCullingPass(CullingPass& cullingPass);
+
+    void updateCullingDrawTemplates(const CullingPass& cullingPass, const std::vector<CullingDrawTemplate>& drawTemplates);
+
+    // Must be recorded outside of a render pass on a compute capable command buffer, once per frame
+    void recordCulling(const CommandBuffer& commandBuffer, const CullingPass& cullingPass, const CullingParameters& parameters);
+    // Builds the Hi-Z pyramid from this frame's depth for next frame's occlusion culling, once per frame. depthImage requires eSampled usage
+    // depthLayout is the layout the depth image is currently in (the render pass' final layout). Leaves depthImage in eShaderReadOnlyOptimal
+    void buildHiZPyramid(const CommandBuffer& commandBuffer, const CullingPass& cullingPass, const Image& depthImage, const ImageView& depthImageView, vk::ImageLayout depthLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal);
+    // Draws the compacted survivors with one indirect draw. Uses the draw count when drawIndirectCount is enabled, otherwise requires multiDrawIndirect
+    void drawCulled(const CommandBuffer& commandBuffer, const CullingPass& cullingPass);
+
+    // Statistics of the last completed culling in the current frame slot, call after startFrame
+    CullingStatistics getCullingStatistics(const CullingPass& cullingPass);
+
+    Buffer getCullingDrawCommandBuffer(const CullingPass& cullingPass);
+    Buffer getCullingCountBuffer(const CullingPass& cullingPass);
+}
+
+#endif
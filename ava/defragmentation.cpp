@@ -0,0 +1,293 @@
+#include "defragmentation.hpp"
+#include "detail/defragmentation.hpp"
+
+#include <algorithm>
+#include "image.hpp"
+#include "detail/buffer.hpp"
+#include "detail/commandBuffer.hpp"
+#include "detail/detail.hpp"
+#include "detail/image.hpp"
+#include "detail/memoryPool.hpp"
+#include "detail/state.hpp"
+
+namespace ava
+{
+    static bool canMoveBuffer(const detail::Buffer* buffer, const bool moveDeviceAddressBuffers)
+    {
+        // Acceleration structures and shader binding tables keep pointing at the memory they were built from, buffer views at their buffer
+        constexpr auto unmovableUsage = vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR | vk::BufferUsageFlagBits::eShaderBindingTableKHR |
+                                        vk::BufferUsageFlagBits::eUniformTexelBuffer | vk::BufferUsageFlagBits::eStorageTexelBuffer;
+        constexpr auto copyUsage = vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst;
+        if (buffer->mapped != nullptr || (buffer->bufferUsage & unmovableUsage) || (buffer->bufferUsage & copyUsage) != copyUsage)
+        {
+            return false;
+        }
+        return moveDeviceAddressBuffers || !(buffer->bufferUsage & vk::BufferUsageFlagBits::eShaderDeviceAddress);
+    }
+
+    static bool canMoveImage(const detail::Image* image)
+    {
+        // Framebuffers keep the image views of their attachments
+        constexpr auto attachmentUsage = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eInputAttachment | vk::ImageUsageFlagBits::eTransientAttachment;
+        constexpr auto copyUsage = vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst;
+        const auto usage = image->creationInfo.usage;
+        if (image->isSwapchainImage || image->initialTransitionPending || image->imageLayout == vk::ImageLayout::eUndefined)
+        {
+            return false;
+        }
+        return image->creationInfo.tiling == vk::ImageTiling::eOptimal && !(usage & attachmentUsage) && (usage & copyUsage) == copyUsage;
+    }
+
+    static vk::ImageMemoryBarrier getMoveImageBarrier(const vk::Image image, const detail::Image* movedImage, const vk::ImageLayout oldLayout, const vk::ImageLayout newLayout)
+    {
+        vk::ImageMemoryBarrier barrier{};
+        barrier.srcAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite;
+        barrier.dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = vk::QueueFamilyIgnored;
+        barrier.dstQueueFamilyIndex = vk::QueueFamilyIgnored;
+        barrier.image = image;
+        barrier.subresourceRange = vk::ImageSubresourceRange{getImageAspectFlagsForFormat(movedImage->creationInfo.format), 0, movedImage->creationInfo.mipLevels, 0, movedImage->creationInfo.arrayLayers};
+        return barrier;
+    }
+
+    // Once the frame the pass was recorded in has completed, lets VMA free the moved from memory and destroys the moved from handles
+    static void endDefragmentationPass(const Defragmentation& defragmentation)
+    {
+        // The moves are freed by VMA when the pass ends, so gather what was moved first
+        std::vector<detail::AllocationOwner*> movedOwners;
+        for (uint32_t i = 0; i < defragmentation->passInfo.moveCount; i++)
+        {
+            const auto& move = defragmentation->passInfo.pMoves[i];
+            if (move.operation == vma::DefragmentationMoveOperation::eCopy)
+            {
+                movedOwners.push_back(static_cast<detail::AllocationOwner*>(detail::State.allocator.getAllocationInfo(move.srcAllocation).pUserData));
+            }
+        }
+
+        const auto result = detail::State.allocator.endDefragmentationPass(defragmentation->context, &defragmentation->passInfo);
+        defragmentation->complete = result == vk::Result::eSuccess;
+        defragmentation->passPending = false;
+
+        for (const auto owner : movedOwners)
+        {
+            if (owner->type == detail::AllocationOwnerType::eBuffer)
+            {
+                const auto buffer = static_cast<detail::Buffer*>(owner->object);
+                buffer->allocationInfo = detail::State.allocator.getAllocationInfo(buffer->allocation);
+                buffer->defragmentationMove = nullptr;
+            }
+            else
+            {
+                const auto image = static_cast<detail::Image*>(owner->object);
+                image->allocationInfo = detail::State.allocator.getAllocationInfo(image->allocation);
+                image->defragmentationMove = nullptr;
+            }
+        }
+
+        for (const auto buffer : defragmentation->movedBuffers)
+        {
+            detail::State.device.destroyBuffer(buffer);
+        }
+        for (const auto imageView : defragmentation->movedImageViews)
+        {
+            detail::State.device.destroyImageView(imageView);
+        }
+        for (const auto image : defragmentation->movedImages)
+        {
+            detail::State.device.destroyImage(image);
+        }
+        defragmentation->movedBuffers.clear();
+        defragmentation->movedImageViews.clear();
+        defragmentation->movedImages.clear();
+    }
+
+    Defragmentation beginDefragmentation(const DefragmentationCreationInfo& creationInfo)
+    {
+        AVA_CHECK(detail::State.device, "Cannot begin defragmentation when State's device is invalid");
+        AVA_CHECK(detail::State.allocator, "Cannot begin defragmentation when State's allocator is invalid");
+
+        vma::DefragmentationInfo defragmentationInfo{};
+        switch (creationInfo.algorithm)
+        {
+        case DefragmentationAlgorithm::eFast:
+            defragmentationInfo.flags = vma::DefragmentationFlagBits::eAlgorithmFast;
+            break;
+        case DefragmentationAlgorithm::eFull:
+            defragmentationInfo.flags = vma::DefragmentationFlagBits::eAlgorithmFull;
+            break;
+        case DefragmentationAlgorithm::eBalanced:
+        default:
+            defragmentationInfo.flags = vma::DefragmentationFlagBits::eAlgorithmBalanced;
+            break;
+        }
+        defragmentationInfo.pool = creationInfo.memoryPool != nullptr ? creationInfo.memoryPool->pool : nullptr;
+        defragmentationInfo.maxBytesPerPass = creationInfo.maxBytesPerPass;
+        defragmentationInfo.maxAllocationsPerPass = creationInfo.maxAllocationsPerPass;
+
+        const auto outDefragmentation = new detail::Defragmentation();
+        outDefragmentation->context = detail::State.allocator.beginDefragmentation(defragmentationInfo);
+        outDefragmentation->moveDeviceAddressBuffers = creationInfo.moveDeviceAddressBuffers;
+        outDefragmentation->complete = false;
+        outDefragmentation->passPending = false;
+        outDefragmentation->passSerial = 0;
+        outDefragmentation->passInfo = vma::DefragmentationPassMoveInfo{};
+        outDefragmentation->statistics = DefragmentationStatistics{};
+        return outDefragmentation;
+    }
+
+    void endDefragmentation(Defragmentation& defragmentation)
+    {
+        AVA_CHECK_NO_EXCEPT_RETURN(defragmentation != nullptr, "Cannot end an invalid defragmentation");
+        AVA_CHECK_NO_EXCEPT_RETURN(detail::State.device, "Cannot end defragmentation when State's device is invalid");
+
+        if (defragmentation->passPending)
+        {
+            detail::State.device.waitIdle();
+            endDefragmentationPass(defragmentation);
+        }
+        detail::State.allocator.endDefragmentation(defragmentation->context, nullptr);
+
+        delete defragmentation;
+        defragmentation = nullptr;
+    }
+
+    bool defragmentMemory(const CommandBuffer& commandBuffer, const Defragmentation& defragmentation)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot defragment memory with an invalid command buffer");
+        AVA_CHECK(defragmentation != nullptr, "Cannot defragment memory with an invalid defragmentation");
+
+        if (defragmentation->passPending)
+        {
+            if (detail::State.completedFrameSerial < defragmentation->passSerial)
+            {
+                return false;
+            }
+            endDefragmentationPass(defragmentation);
+        }
+        if (defragmentation->complete)
+        {
+            return true;
+        }
+
+        // Success rather than incomplete means there is nothing left to move
+        if (detail::State.allocator.beginDefragmentationPass(defragmentation->context, &defragmentation->passInfo) == vk::Result::eSuccess)
+        {
+            defragmentation->complete = true;
+            return true;
+        }
+
+        std::vector<std::pair<vk::Buffer, detail::Buffer*>> bufferMoves;
+        std::vector<std::pair<vk::Image, detail::Image*>> imageMoves;
+        std::vector<vk::ImageMemoryBarrier> copyBarriers;
+        std::vector<vk::ImageMemoryBarrier> finalBarriers;
+        std::unordered_map<vk::Buffer, vk::Buffer> movedBuffers;
+        std::unordered_map<vk::ImageView, vk::ImageView> movedImageViews;
+        for (uint32_t i = 0; i < defragmentation->passInfo.moveCount; i++)
+        {
+            auto& move = defragmentation->passInfo.pMoves[i];
+            const auto owner = static_cast<detail::AllocationOwner*>(detail::State.allocator.getAllocationInfo(move.srcAllocation).pUserData);
+            if (owner == nullptr)
+            {
+                move.operation = vma::DefragmentationMoveOperation::eIgnore;
+                defragmentation->statistics.allocationsSkipped++;
+                continue;
+            }
+
+            if (owner->type == detail::AllocationOwnerType::eBuffer)
+            {
+                const auto buffer = static_cast<detail::Buffer*>(owner->object);
+                if (!canMoveBuffer(buffer, defragmentation->moveDeviceAddressBuffers))
+                {
+                    move.operation = vma::DefragmentationMoveOperation::eIgnore;
+                    defragmentation->statistics.allocationsSkipped++;
+                    continue;
+                }
+
+                const auto newBuffer = detail::State.device.createBuffer(buffer->creationInfo);
+                detail::State.allocator.bindBufferMemory(move.dstTmpAllocation, newBuffer);
+
+                bufferMoves.emplace_back(buffer->buffer, buffer);
+                movedBuffers[buffer->buffer] = newBuffer;
+                defragmentation->movedBuffers.push_back(buffer->buffer);
+                buffer->buffer = newBuffer;
+                buffer->defragmentationMove = &move;
+
+                defragmentation->statistics.buffersMoved++;
+                defragmentation->statistics.bytesMoved += buffer->size;
+            }
+            else
+            {
+                const auto image = static_cast<detail::Image*>(owner->object);
+                if (!canMoveImage(image))
+                {
+                    move.operation = vma::DefragmentationMoveOperation::eIgnore;
+                    defragmentation->statistics.allocationsSkipped++;
+                    continue;
+                }
+
+                const auto newImage = detail::State.device.createImage(image->creationInfo);
+                detail::State.allocator.bindImageMemory(move.dstTmpAllocation, newImage);
+
+                copyBarriers.push_back(getMoveImageBarrier(image->image, image, image->imageLayout, vk::ImageLayout::eTransferSrcOptimal));
+                copyBarriers.push_back(getMoveImageBarrier(newImage, image, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal));
+                finalBarriers.push_back(getMoveImageBarrier(newImage, image, vk::ImageLayout::eTransferDstOptimal, image->imageLayout));
+                imageMoves.emplace_back(image->image, image);
+                defragmentation->movedImages.push_back(image->image);
+                image->image = newImage;
+                image->defragmentationMove = &move;
+
+                // Views are patched in place, so every ava::ImageView of the image stays valid
+                for (const auto imageView : image->imageViews)
+                {
+                    imageView->creationInfo.image = newImage;
+                    const auto newImageView = detail::State.device.createImageView(imageView->creationInfo);
+                    movedImageViews[imageView->imageView] = newImageView;
+                    defragmentation->movedImageViews.push_back(imageView->imageView);
+                    imageView->imageView = newImageView;
+                }
+
+                defragmentation->statistics.imagesMoved++;
+                defragmentation->statistics.bytesMoved += image->allocationInfo.size;
+            }
+        }
+
+        // Previous frames may still be writing to the moved from memory, and later commands read the moved to memory
+        const auto vkCommandBuffer = commandBuffer->commandBuffer;
+        const vk::MemoryBarrier copyBarrier{vk::AccessFlagBits::eMemoryWrite, vk::AccessFlagBits::eTransferRead};
+        vkCommandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {}, copyBarrier, nullptr, copyBarriers);
+        for (const auto& [oldBuffer, buffer] : bufferMoves)
+        {
+            vkCommandBuffer.copyBuffer(oldBuffer, buffer->buffer, vk::BufferCopy{0, 0, buffer->size});
+        }
+        for (const auto& [oldImage, image] : imageMoves)
+        {
+            std::vector<vk::ImageCopy> regions;
+            regions.reserve(image->creationInfo.mipLevels);
+            for (uint32_t mip = 0; mip < image->creationInfo.mipLevels; mip++)
+            {
+                const vk::ImageSubresourceLayers subresource{getImageAspectFlagsForFormat(image->creationInfo.format), mip, 0, image->creationInfo.arrayLayers};
+                const vk::Extent3D extent{std::max(image->creationInfo.extent.width >> mip, 1u), std::max(image->creationInfo.extent.height >> mip, 1u), std::max(image->creationInfo.extent.depth >> mip, 1u)};
+                regions.emplace_back(subresource, vk::Offset3D{}, subresource, vk::Offset3D{}, extent);
+            }
+            vkCommandBuffer.copyImage(oldImage, vk::ImageLayout::eTransferSrcOptimal, image->image, vk::ImageLayout::eTransferDstOptimal, regions);
+        }
+        const vk::MemoryBarrier finalBarrier{vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite};
+        vkCommandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands, {}, finalBarrier, nullptr, finalBarriers);
+
+        detail::rebindMovedDescriptors(movedBuffers, movedImageViews);
+
+        // Same as retireObject, the pass can end once the frame being recorded has completed
+        defragmentation->passPending = true;
+        defragmentation->passSerial = detail::State.submittedFrameSerial + (detail::State.frameStarted ? 1 : 0);
+        defragmentation->statistics.passCount++;
+        return false;
+    }
+
+    DefragmentationStatistics getDefragmentationStatistics(const Defragmentation& defragmentation)
+    {
+        AVA_CHECK(defragmentation != nullptr, "Cannot get statistics of an invalid defragmentation");
+        return defragmentation->statistics;
+    }
+}
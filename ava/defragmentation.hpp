@@ -0,0 +1,47 @@
+#ifndef AVA_DEFRAGMENTATION_HPP
+#define AVA_DEFRAGMENTATION_HPP
+
+#include "types.hpp"
+
+namespace ava
+{
+    enum class DefragmentationAlgorithm
+    {
+        eFast, // Only moves allocations within the memory they are in, finding fewer moves
+        eBalanced,
+        eFull, // Moves allocations between blocks to free as many blocks as possible
+    };
+
+    struct DefragmentationCreationInfo
+    {
+        MemoryPool memoryPool = nullptr; // nullptr to defragment the default pools
+        DefragmentationAlgorithm algorithm = DefragmentationAlgorithm::eBalanced;
+        vk::DeviceSize maxBytesPerPass = 32ull * 1024 * 1024; // Caps the bytes copied by each call to defragmentMemory, 0 when unlimited
+        uint32_t maxAllocationsPerPass = 64; // 0 when unlimited
+        bool moveDeviceAddressBuffers = false; // Buffers with eShaderDeviceAddress usage are moved too. Their device addresses change, so they have to be fetched again
+    };
+
+    struct DefragmentationStatistics
+    {
+        uint32_t passCount;
+        uint32_t buffersMoved;
+        uint32_t imagesMoved;
+        vk::DeviceSize bytesMoved;
+        uint32_t allocationsSkipped; // Allocations which cannot be moved, such as mapped buffers, attachments and acceleration structures
+    };
+
+    // Moves buffers and images to pack their memory more tightly, over several frames. Their handles stay valid as they move
+    // Image views of moved images are recreated and descriptor sets referencing moved buffers or image views are rewritten
+    // Images used as attachments, mapped buffers and buffers used by acceleration structures are never moved
+    [[nodiscard]] Defragmentation beginDefragmentation(const DefragmentationCreationInfo& creationInfo = {});
+    // Waits for the device when a pass is still pending, so call once defragmentMemory returns true
+    void endDefragmentation(Defragmentation& defragmentation);
+
+    // Call once per frame at the start of the frame's command buffer, before any buffers or images are used
+    // Records the copies of the next pass once the previous pass's frame has completed. Returns true once there is nothing left to move
+    // When a pass moves resources that descriptor sets reference, the frames in flight are waited for before the sets are rewritten
+    bool defragmentMemory(const CommandBuffer& commandBuffer, const Defragmentation& defragmentation);
+    DefragmentationStatistics getDefragmentationStatistics(const Defragmentation& defragmentation);
+}
+
+#endif
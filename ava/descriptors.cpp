@@ -8,6 +8,8 @@
 
 #include "detail/buffer.hpp"
 #include "detail/commandBuffer.hpp"
+#include "detail/defragmentation.hpp"
+#include "detail/frame.hpp"
 #include "detail/image.hpp"
 #include "detail/rayTracing.hpp"
 #include "detail/rayTracingPipeline.hpp"
@@ -15,6 +17,81 @@
 
 namespace ava
 {
+    namespace detail
+    {
+        void rebindMovedDescriptors(const std::unordered_map<vk::Buffer, vk::Buffer>& movedBuffers, const std::unordered_map<vk::ImageView, vk::ImageView>& movedImageViews)
+        {
+            // Infos are reserved up front so the writes' pointers to them stay valid
+            size_t boundDescriptorCount = 0;
+            for (const auto descriptorPool : State.descriptorPools)
+            {
+                for (const auto& descriptorSet : descriptorPool->sets)
+                {
+                    boundDescriptorCount += descriptorSet->boundDescriptors.size();
+                }
+            }
+
+            std::vector<vk::WriteDescriptorSet> writes;
+            writes.reserve(boundDescriptorCount);
+            for (const auto descriptorPool : State.descriptorPools)
+            {
+                for (const auto& descriptorSet : descriptorPool->sets)
+                {
+                    for (auto& boundDescriptor : descriptorSet->boundDescriptors)
+                    {
+                        vk::WriteDescriptorSet wds{};
+                        wds.dstSet = descriptorSet->descriptorSet;
+                        wds.dstBinding = boundDescriptor.binding;
+                        wds.dstArrayElement = boundDescriptor.arrayElement;
+                        wds.descriptorCount = 1;
+                        wds.descriptorType = boundDescriptor.descriptorType;
+                        if (const auto movedBuffer = movedBuffers.find(boundDescriptor.bufferInfo.buffer); boundDescriptor.bufferInfo.buffer && movedBuffer != movedBuffers.end())
+                        {
+                            boundDescriptor.bufferInfo.buffer = movedBuffer->second;
+                            wds.setBufferInfo(boundDescriptor.bufferInfo);
+                            writes.push_back(wds);
+                        }
+                        else if (const auto movedImageView = movedImageViews.find(boundDescriptor.imageInfo.imageView); boundDescriptor.imageInfo.imageView && movedImageView != movedImageViews.end())
+                        {
+                            boundDescriptor.imageInfo.imageView = movedImageView->second;
+                            wds.setImageInfo(boundDescriptor.imageInfo);
+                            writes.push_back(wds);
+                        }
+                    }
+                }
+            }
+
+            // Sets cannot be updated while frames in flight may still be using them
+            if (!writes.empty())
+            {
+                waitForSubmittedFrames();
+                State.device.updateDescriptorSets(writes, nullptr);
+            }
+        }
+    }
+
+    // Replaces what was last written to the binding's array element, only buffers and images are kept
+    static void recordBoundDescriptor(const std::shared_ptr<detail::DescriptorSet>& descriptorSet, const vk::WriteDescriptorSet& wds)
+    {
+        std::erase_if(descriptorSet->boundDescriptors, [&wds](const detail::BoundDescriptor& boundDescriptor)
+        {
+            return boundDescriptor.binding == wds.dstBinding && boundDescriptor.arrayElement == wds.dstArrayElement;
+        });
+
+        const bool hasBuffer = wds.pBufferInfo != nullptr && wds.pBufferInfo->buffer;
+        const bool hasImageView = wds.pImageInfo != nullptr && wds.pImageInfo->imageView;
+        if (hasBuffer || hasImageView)
+        {
+            detail::BoundDescriptor boundDescriptor{};
+            boundDescriptor.binding = wds.dstBinding;
+            boundDescriptor.arrayElement = wds.dstArrayElement;
+            boundDescriptor.descriptorType = wds.descriptorType;
+            boundDescriptor.bufferInfo = hasBuffer ? *wds.pBufferInfo : vk::DescriptorBufferInfo{};
+            boundDescriptor.imageInfo = hasImageView ? *wds.pImageInfo : vk::DescriptorImageInfo{};
+            descriptorSet->boundDescriptors.push_back(boundDescriptor);
+        }
+    }
+
     // Use a template because every pipeline is going to have the common factors:
     // layout, layoutBindings, pushConstants and descriptorSetLayouts
     template <typename T>
@@ -49,6 +126,7 @@ namespace ava
         outDescriptorPool->descriptorSetLayouts = pipeline->descriptorSetLayouts;
         outDescriptorPool->defaultMaxSets = pipelineSets * maxSetsMultiplier;
         outDescriptorPool->pipelineSets = pipelineSets;
+        detail::State.descriptorPools.push_back(outDescriptorPool);
         return outDescriptorPool;
     }
 
@@ -100,9 +178,16 @@ namespace ava
         {
             detail::State.device.destroyDescriptorPool(pool.descriptorPool);
             pool.descriptorPool = nullptr;
+
+            detail::State.descriptorPoolCount--;
+            for (const auto& [type, size] : pool.poolSizes)
+            {
+                detail::State.descriptorCount -= size;
+            }
         }
         descriptorPool->sets.clear();
         descriptorPool->pools.clear();
+        std::erase(detail::State.descriptorPools, descriptorPool);
 
         delete descriptorPool;
         descriptorPool = nullptr;
@@ -146,6 +231,12 @@ namespace ava
         individualPool.descriptorPool = vkDescriptorPool;
         individualPool.maxSets = poolCreateInfo.maxSets;
 
+        detail::State.descriptorPoolCount++;
+        for (const auto& poolSize : poolSizes)
+        {
+            detail::State.descriptorCount += poolSize.descriptorCount;
+        }
+
         // Increase pool size multiplier
         descriptorPool->poolSizeMultiplier *= 1.5f;
         return individualPool;
@@ -360,6 +451,7 @@ namespace ava
         wds.setBufferInfo(bufferInfo);
 
         detail::State.device.updateDescriptorSets(wds, nullptr);
+        recordBoundDescriptor(ds, wds);
     }
 
     void bindNullBuffer(const DescriptorSet& descriptorSet, const uint32_t binding, const uint32_t dstArrayElement)
@@ -390,6 +482,7 @@ namespace ava
         wds.setBufferInfo(bufferInfo);
 
         detail::State.device.updateDescriptorSets(wds, nullptr);
+        recordBoundDescriptor(ds, wds);
     }
 
     void bindImage(const DescriptorSet& descriptorSet, uint32_t binding, const Image& image, const ImageView& imageView, const Sampler& sampler, std::optional<vk::ImageLayout> imageLayout, const uint32_t dstArrayElement)
@@ -426,6 +519,7 @@ namespace ava
         wds.setImageInfo(imageInfo);
 
         detail::State.device.updateDescriptorSets(wds, nullptr);
+        recordBoundDescriptor(ds, wds);
     }
 
     void bindNullImage(const DescriptorSet& descriptorSet, uint32_t binding, uint32_t dstArrayElement)
@@ -456,6 +550,7 @@ namespace ava
         wds.setImageInfo(imageInfo);
 
         detail::State.device.updateDescriptorSets(wds, nullptr);
+        recordBoundDescriptor(ds, wds);
     }
 
     void bindTLAS(const DescriptorSet& descriptorSet, uint32_t binding, const TLAS& tlas, uint32_t dstArrayElement)
@@ -488,6 +583,7 @@ namespace ava
         wds.pNext = &accelerationStructureInfo;
 
         detail::State.device.updateDescriptorSets(wds, nullptr);
+        recordBoundDescriptor(ds, wds);
     }
 
     void bindNullTLAS(const DescriptorSet& descriptorSet, uint32_t binding, uint32_t dstArrayElement)
@@ -517,5 +613,6 @@ namespace ava
         wds.pNext = &accelerationStructureInfo;
 
         detail::State.device.updateDescriptorSets(wds, nullptr);
+        recordBoundDescriptor(ds, wds);
     }
 }
@@ -0,0 +1,59 @@
+#ifndef AVA_DETAIL_ACCELERATIONSTRUCTURECACHE_HPP
+#define AVA_DETAIL_ACCELERATIONSTRUCTURECACHE_HPP
+
+#include "./vulkan.hpp"
+
+namespace ava::detail
+{
+    constexpr uint32_t ACCELERATION_STRUCTURE_CACHE_MAGIC = 0x43534156; // "VASC"
+    constexpr uint32_t ACCELERATION_STRUCTURE_CACHE_VERSION = 1;
+    // Serialised acceleration structures must be copied to and from 256 byte aligned addresses
+    constexpr vk::DeviceSize ACCELERATION_STRUCTURE_CACHE_ALIGNMENT = 256;
+
+    // Offsets into the header every serialised acceleration structure starts with
+    constexpr size_t SERIALIZED_VERSION_DATA_SIZE = 2 * VK_UUID_SIZE; // Driver UUID then compatibility UUID
+    constexpr size_t SERIALIZED_DESERIALIZED_SIZE_OFFSET = SERIALIZED_VERSION_DATA_SIZE + sizeof(uint64_t);
+    constexpr size_t SERIALIZED_HANDLE_COUNT_OFFSET = SERIALIZED_VERSION_DATA_SIZE + 2 * sizeof(uint64_t);
+    constexpr size_t SERIALIZED_HANDLES_OFFSET = SERIALIZED_VERSION_DATA_SIZE + 3 * sizeof(uint64_t);
+
+    // File layout is the header, the BLAS entries, the TLAS entries then the payload
+    // Payload offsets are relative to the start of the payload and aligned to ACCELERATION_STRUCTURE_CACHE_ALIGNMENT
+    struct AccelerationStructureCacheHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint8_t versionData[SERIALIZED_VERSION_DATA_SIZE]; // Of the device which serialised the acceleration structures
+        uint32_t blasCount;
+        uint32_t tlasCount;
+        uint64_t payloadSize;
+    };
+
+    struct AccelerationStructureCacheBLASEntry
+    {
+        uint64_t meshOffset;
+        uint64_t meshSize;
+        uint64_t vertexOffset; // Within the mesh
+        uint64_t indexOffset;
+        uint32_t maxVertex;
+        uint32_t vertexStride;
+        int32_t indexType;
+        uint32_t indexCount;
+        uint32_t instanceCount;
+        uint32_t buildFlags;
+        uint32_t geometryFlags;
+        uint32_t compacted;
+        uint64_t dataOffset;
+        uint64_t dataSize;
+    };
+
+    // The serialised BLAS handles of TLASes are replaced with indices into the cache's BLASes on save, and with the new addresses on load
+    struct AccelerationStructureCacheTLASEntry
+    {
+        uint32_t buildFlags;
+        uint32_t geometryFlags;
+        uint64_t dataOffset;
+        uint64_t dataSize;
+    };
+}
+
+#endif
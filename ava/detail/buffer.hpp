@@ -3,6 +3,7 @@
 
 #include "./vulkan.hpp"
 #include "../memoryLocation.hpp"
+#include "defragmentation.hpp"
 
 namespace ava::detail
 {
@@ -16,6 +17,10 @@ namespace ava::detail
         vk::DeviceSize alignment;
         void* mapped;
         vk::DeviceSize size;
+        vk::BufferCreateInfo creationInfo; // Buffers recreated by defragmentation are created from this
+
+        AllocationOwner allocationOwner;
+        vma::DefragmentationMove* defragmentationMove = nullptr; // Set while the buffer is moved by a pending defragmentation pass
     };
 
     vk::DeviceAddress getBufferDeviceAddress(const Buffer* buffer);
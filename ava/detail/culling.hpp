@@ -0,0 +1,61 @@
+#ifndef AVA_DETAIL_CULLING_HPP
+#define AVA_DETAIL_CULLING_HPP
+
+#include "./vulkan.hpp"
+#include "../types.hpp"
+
+namespace ava::detail
+{
+    // Matches CullingUniforms in the culling compute shader
+    struct CullingUniforms
+    {
+        float viewProjection[16];
+        float hiZViewProjection[16];
+        float frustumPlanes[6][4];
+        float hiZSize[2];
+        uint32_t instanceCount;
+        uint32_t flags;
+        uint32_t hiZMipLevels;
+        uint32_t padding[3];
+    };
+
+    constexpr uint32_t CULLING_FLAG_FRUSTUM = 1u << 0;
+    constexpr uint32_t CULLING_FLAG_OCCLUSION = 1u << 1;
+    constexpr uint32_t CULLING_FLAG_NON_INDEXED = 1u << 2;
+
+    constexpr uint32_t CULLING_WORKGROUP_SIZE = 64;
+    constexpr uint32_t HIZ_WORKGROUP_SIZE = 8;
+    constexpr uint32_t HIZ_MAX_MIP_LEVELS = 16;
+
+    struct CullingPass
+    {
+        ava::ComputePipeline cullPipeline;
+        ava::ComputePipeline hiZPipeline;
+        ava::DescriptorPool cullDescriptorPool;
+        ava::DescriptorPool hiZDescriptorPool;
+        std::vector<ava::DescriptorSet> cullDescriptorSets; // One per frame in flight
+        std::vector<std::vector<ava::DescriptorSet>> hiZDescriptorSets; // One per mip level per frame in flight
+
+        uint32_t maxInstances;
+        bool indexed;
+
+        ava::Buffer drawTemplateBuffer;
+        uint32_t drawTemplateCount;
+        ava::Buffer drawCommandBuffer;
+        ava::Buffer statisticsBuffer; // First element doubles as the draw count
+        std::vector<ava::Buffer> uniformBuffers; // One per frame in flight
+        std::vector<ava::Buffer> statisticsReadbackBuffers; // One per frame in flight
+
+        ava::Image hiZImage;
+        ava::ImageView hiZImageView;
+        std::vector<ava::ImageView> hiZMipImageViews;
+        vk::Extent2D hiZExtent;
+        uint32_t hiZMipLevels;
+        bool hiZBuilt;
+
+        float lastViewProjection[16];
+        bool lastViewProjectionValid;
+    };
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef AVA_DETAIL_DEFRAGMENTATION_HPP
+#define AVA_DETAIL_DEFRAGMENTATION_HPP
+
+#include <unordered_map>
+#include "./vulkan.hpp"
+#include "../defragmentation.hpp"
+
+namespace ava::detail
+{
+    enum class AllocationOwnerType
+    {
+        eBuffer,
+        eImage,
+    };
+
+    // Set as the user data of buffer and image allocations, so defragmentation can find what owns a moved allocation
+    struct AllocationOwner
+    {
+        AllocationOwnerType type;
+        void* object;
+    };
+
+    struct Defragmentation
+    {
+        vma::DefragmentationContext context;
+        bool moveDeviceAddressBuffers;
+        bool complete;
+
+        // The pass whose copies were last recorded, ended once the frame it was recorded in has completed
+        bool passPending;
+        uint64_t passSerial;
+        vma::DefragmentationPassMoveInfo passInfo;
+        std::vector<vk::Buffer> movedBuffers; // The moved from handles, destroyed when the pass ends
+        std::vector<vk::Image> movedImages;
+        std::vector<vk::ImageView> movedImageViews;
+
+        DefragmentationStatistics statistics;
+    };
+
+    // Rewrites descriptors of every descriptor set which still reference the moved from handles, first waiting for submitted frames when any set needs rewriting
+    void rebindMovedDescriptors(const std::unordered_map<vk::Buffer, vk::Buffer>& movedBuffers, const std::unordered_map<vk::ImageView, vk::ImageView>& movedImageViews);
+}
+
+#endif
@@ -19,6 +19,16 @@ namespace ava::detail
         bool outOfRotation = false;
     };
 
+    // A buffer or image written to a descriptor set, kept so it can be rewritten when defragmentation moves it
+    struct BoundDescriptor
+    {
+        uint32_t binding;
+        uint32_t arrayElement;
+        vk::DescriptorType descriptorType;
+        vk::DescriptorBufferInfo bufferInfo; // Buffer is nullptr for images
+        vk::DescriptorImageInfo imageInfo;
+    };
+
     struct DescriptorSet;
 
     struct DescriptorPool
@@ -43,6 +53,7 @@ namespace ava::detail
         uint32_t poolIndex;
         uint32_t setIndex;
         bool freeable;
+        std::vector<BoundDescriptor> boundDescriptors;
     };
 }
 
@@ -0,0 +1,17 @@
+#ifndef AVA_DETAIL_FRAME_HPP
+#define AVA_DETAIL_FRAME_HPP
+
+#include <memory>
+#include "./vulkan.hpp"
+
+namespace ava::detail
+{
+    // Keeps object alive until every frame submitted up to extraFrames frames from now has completed
+    void retireObject(const std::shared_ptr<void>& object, uint64_t extraFrames = 0);
+    // Releases retired objects whose frames have completed, or every retired object when all is set (the device must be idle)
+    void releaseRetiredObjects(bool all = false);
+    // Waits for every submitted frame, so objects they were using can be modified. The started frame is not waited for
+    void waitForSubmittedFrames();
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef AVA_DETAIL_GEOMETRYARENA_HPP
+#define AVA_DETAIL_GEOMETRYARENA_HPP
+
+#include <map>
+#include <optional>
+#include <vector>
+#include "./vulkan.hpp"
+#include "../types.hpp"
+
+namespace ava::detail
+{
+    // First-fit range allocator over element counts, free ranges are coalesced on release
+    struct ArenaRangeAllocator
+    {
+        uint32_t capacity;
+        uint32_t used;
+        std::map<uint32_t, uint32_t> freeRanges; // offset -> count
+    };
+
+    struct ArenaMesh
+    {
+        GeometryArena* arena;
+        uint32_t vertexOffset;
+        uint32_t vertexCount;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+    };
+
+    struct GeometryArena
+    {
+        uint32_t stride;
+        uint32_t binding;
+        vk::PrimitiveTopology topology;
+        vk::IndexType indexType;
+        uint32_t indexSize;
+        vk::BufferUsageFlags extraBufferUsage;
+
+        ava::Buffer vertexBuffer;
+        ava::Buffer indexBuffer;
+        ArenaRangeAllocator vertexRanges;
+        ArenaRangeAllocator indexRanges;
+
+        std::vector<ArenaMesh*> meshes;
+    };
+
+    void initArenaRanges(ArenaRangeAllocator& allocator, uint32_t capacity);
+    std::optional<uint32_t> allocateArenaRange(ArenaRangeAllocator& allocator, uint32_t count);
+    void freeArenaRange(ArenaRangeAllocator& allocator, uint32_t offset, uint32_t count);
+    void growArenaRanges(ArenaRangeAllocator& allocator, uint32_t newCapacity);
+}
+
+#endif
@@ -0,0 +1,97 @@
+#include "image.hpp"
+
+#include "commandBuffer.hpp"
+#include "detail.hpp"
+#include "state.hpp"
+#include "../image.hpp"
+
+namespace ava::detail
+{
+    void removePendingImageTransition(Image* image)
+    {
+        if (!image->initialTransitionPending)
+        {
+            return;
+        }
+
+        std::erase(State.pendingImageTransitions, image);
+        image->initialTransitionPending = false;
+    }
+
+    vk::ImageLayout takeOverInitialImageTransition(const CommandBufferPtr& commandBuffer, Image* image, const vk::ImageSubresourceRange& subresourceRange)
+    {
+        if (!image->initialTransitionPending)
+        {
+            return image->imageLayout;
+        }
+
+        const bool allMipLevels = subresourceRange.baseMipLevel == 0 && (subresourceRange.levelCount == vk::RemainingMipLevels || subresourceRange.levelCount >= image->creationInfo.mipLevels);
+        const bool allArrayLayers = subresourceRange.baseArrayLayer == 0 && (subresourceRange.layerCount == vk::RemainingArrayLayers || subresourceRange.layerCount >= image->creationInfo.arrayLayers);
+        if (allMipLevels && allArrayLayers)
+        {
+            removePendingImageTransition(image);
+            return vk::ImageLayout::eUndefined;
+        }
+
+        recordInitialImageTransition(commandBuffer, image);
+        return image->imageLayout;
+    }
+
+    void recordInitialImageTransition(const CommandBufferPtr& commandBuffer, Image* image)
+    {
+        if (!image->initialTransitionPending)
+        {
+            return;
+        }
+        removePendingImageTransition(image);
+
+        const auto barrier = getInitialImageTransitionBarrier(image);
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eAllCommands, {}, nullptr, nullptr, barrier);
+    }
+
+    vk::ImageMemoryBarrier getInitialImageTransitionBarrier(const Image* image)
+    {
+        // Nothing has touched the image yet, so there is nothing to wait on or preserve
+        vk::ImageMemoryBarrier barrier{};
+        barrier.image = image->image;
+        barrier.oldLayout = vk::ImageLayout::eUndefined;
+        barrier.newLayout = image->imageLayout;
+        barrier.srcQueueFamilyIndex = vk::QueueFamilyIgnored;
+        barrier.dstQueueFamilyIndex = vk::QueueFamilyIgnored;
+        barrier.subresourceRange = vk::ImageSubresourceRange{ava::getImageAspectFlagsForFormat(image->creationInfo.format), 0, image->creationInfo.mipLevels, 0, image->creationInfo.arrayLayers};
+        barrier.srcAccessMask = vk::AccessFlagBits::eNone;
+        barrier.dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite;
+        return barrier;
+    }
+
+    CommandBufferPtr recordPendingImageTransitions()
+    {
+        if (State.pendingImageTransitions.empty())
+        {
+            return nullptr;
+        }
+
+        std::vector<vk::ImageMemoryBarrier> barriers;
+        barriers.reserve(State.pendingImageTransitions.size());
+        for (const auto image : State.pendingImageTransitions)
+        {
+            barriers.push_back(getInitialImageTransitionBarrier(image));
+            image->initialTransitionPending = false;
+        }
+        State.pendingImageTransitions.clear();
+
+        auto commandBuffer = createGraphicsCommandBuffers(1).at(0);
+        commandBuffer->commandBuffer.begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eAllCommands, {}, nullptr, nullptr, barriers);
+        commandBuffer->commandBuffer.end();
+        return commandBuffer;
+    }
+
+    void freePendingImageTransitions(const CommandBufferPtr& commandBuffer)
+    {
+        if (commandBuffer != nullptr)
+        {
+            State.device.freeCommandBuffers(commandBuffer->allocateInfo.commandPool, commandBuffer->commandBuffer);
+        }
+    }
+}
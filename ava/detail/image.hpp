@@ -2,9 +2,13 @@
 #define AVA_DETAIL_IMAGE_HPP
 
 #include "./vulkan.hpp"
+#include <memory>
+#include "defragmentation.hpp"
 
 namespace ava::detail
 {
+    struct ImageView;
+
     struct Image
     {
         vk::Image image;
@@ -14,15 +18,39 @@ namespace ava::detail
         vk::ImageCreateInfo creationInfo;
 
         bool isSwapchainImage = false;
+        bool initialTransitionPending = false; // imageLayout is only reached once State's pending image transitions are submitted
+
+        AllocationOwner allocationOwner;
+        vma::DefragmentationMove* defragmentationMove = nullptr; // Set while the image is moved by a pending defragmentation pass
+        std::vector<ImageView*> imageViews; // Recreated when the image is moved
     };
 
     struct ImageView
     {
         vk::ImageView imageView;
         vk::Format format;
+        Image* image = nullptr; // nullptr once the image is destroyed
+        vk::ImageViewCreateInfo creationInfo;
+        uint32_t referenceCount = 1; // createImageView returns the same view for identical create infos of the image
 
         bool isSwapchainImageView = false;
     };
+
+    struct CommandBuffer;
+
+    void removePendingImageTransition(Image* image);
+    // Layout of the image when commandBuffer's next command executes. An image still waiting for its initial transition has it taken over here
+    // A whole image transition can start from eUndefined as the image holds nothing yet, partial ones need the initial transition recorded first
+    vk::ImageLayout takeOverInitialImageTransition(const std::shared_ptr<CommandBuffer>& commandBuffer, Image* image, const vk::ImageSubresourceRange& subresourceRange);
+    // Records the image's initial transition into commandBuffer when it is still pending, for uses that keep the image's layout
+    void recordInitialImageTransition(const std::shared_ptr<CommandBuffer>& commandBuffer, Image* image);
+    // Barrier from eUndefined to the image's layout for the whole image
+    vk::ImageMemoryBarrier getInitialImageTransitionBarrier(const Image* image);
+    // Records every pending initial image transition into one new command buffer, nullptr when none are pending
+    // It has to be submitted to the graphics queue ahead of the command buffers in the same submission, then freed with freePendingImageTransitions once complete
+    // Other queue families would need a queue family ownership transfer before the images are used on the graphics queue, so they leave the transitions pending
+    std::shared_ptr<CommandBuffer> recordPendingImageTransitions();
+    void freePendingImageTransitions(const std::shared_ptr<CommandBuffer>& commandBuffer);
 }
 
 #endif
@@ -0,0 +1,22 @@
+#ifndef AVA_DETAIL_INSTANCEBUFFER_HPP
+#define AVA_DETAIL_INSTANCEBUFFER_HPP
+
+#include <vector>
+#include "./vulkan.hpp"
+#include "../types.hpp"
+
+namespace ava::detail
+{
+    struct InstanceBuffer
+    {
+        uint32_t stride;
+        uint32_t binding;
+
+        // One per frame in flight so a frame's instances can be rewritten while previous frames are still in use
+        std::vector<ava::Buffer> buffers;
+        std::vector<uint32_t> capacities; // In instances
+        std::vector<uint32_t> instanceCounts;
+    };
+}
+
+#endif
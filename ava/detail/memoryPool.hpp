@@ -0,0 +1,23 @@
+#ifndef AVA_DETAIL_MEMORYPOOL_HPP
+#define AVA_DETAIL_MEMORYPOOL_HPP
+
+#include "./vulkan.hpp"
+#include "../memoryLocation.hpp"
+
+namespace ava::detail
+{
+    struct MemoryPool
+    {
+        vma::Pool pool;
+        uint32_t memoryTypeIndex;
+        MemoryLocation memoryLocation;
+        bool holdsImages;
+        vk::DeviceSize budget; // 0 when unlimited
+        std::string name;
+    };
+
+    // Checked after allocating from the pool, as the size of an allocation is only known once made
+    bool isMemoryPoolWithinBudget(const MemoryPool* memoryPool);
+}
+
+#endif
@@ -4,12 +4,17 @@
 #include "buffer.hpp"
 #include "commandBuffer.hpp"
 #include "detail.hpp"
+#include "frame.hpp"
 #include "state.hpp"
 #include "vbo.hpp"
 #include "ibo.hpp"
 #include "vibo.hpp"
 #include "ava/buffer.hpp"
 #include "ava/commandBuffer.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 
 namespace ava::detail
 {
@@ -83,6 +88,8 @@ namespace ava::detail
         outBLAS->type = BLASType::Triangles;
         outBLAS->accelerationStructure = nullptr;
         outBLAS->meshBuffer = newMeshBuffer;
+        outBLAS->transformBuffer = nullptr;
+        outBLAS->aabbBuffer = nullptr;
         outBLAS->maxVertex = meshBuffer->vertexCount - 1;
         outBLAS->vertexStride = meshBuffer->stride;
         outBLAS->indexType = meshBuffer->indexType;
@@ -91,6 +98,8 @@ namespace ava::detail
         outBLAS->indexDeviceAddress = indexMeshBufferDeviceAddress;
         outBLAS->instanceCount = outBLAS->indexCount / 3;
         outBLAS->built = false;
+        outBLAS->buildFlags = {};
+        outBLAS->compacted = false;
         return outBLAS;
     }
 
@@ -151,6 +160,8 @@ namespace ava::detail
         outBLAS->type = BLASType::Triangles;
         outBLAS->accelerationStructure = nullptr;
         outBLAS->meshBuffer = newMeshBuffer;
+        outBLAS->transformBuffer = nullptr;
+        outBLAS->aabbBuffer = nullptr;
         outBLAS->maxVertex = vbo->vertexCount - 1;
         outBLAS->vertexStride = vbo->stride;
         outBLAS->indexType = vk::IndexType::eUint32;
@@ -159,6 +170,104 @@ namespace ava::detail
         outBLAS->indexDeviceAddress = indexMeshBufferDeviceAddress;
         outBLAS->instanceCount = outBLAS->indexCount / 3;
         outBLAS->built = false;
+        outBLAS->buildFlags = {};
+        outBLAS->compacted = false;
+        return outBLAS;
+    }
+
+    BLAS* createBottomLevelAccelerationStructure(const std::vector<ava::BLASGeometry>& geometries)
+    {
+        AVA_CHECK(!geometries.empty(), "Cannot create a BLAS from no geometries");
+        AVA_CHECK(State.rayTracingEnabled, "Cannot create a BLAS when ray tracing is not enabled");
+
+        uint32_t primitiveCount = 0;
+        std::vector<vk::TransformMatrixKHR> transforms;
+        for (const auto& geometry : geometries)
+        {
+            AVA_CHECK(geometry.vertexBuffer != nullptr && geometry.vertexBuffer->buffer, "Cannot create a BLAS from a geometry with an invalid vertex buffer");
+            AVA_CHECK((geometry.vertexBuffer->bufferUsage & vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR) != vk::BufferUsageFlags{}, "Cannot create a BLAS from a geometry whose vertex buffer does not have eAccelerationStructureBuildInputReadOnlyKHR buffer usage");
+            AVA_CHECK(geometry.vertexCount > 0 && geometry.vertexStride > 0, "Cannot create a BLAS from a geometry with a vertex count or stride of 0");
+            AVA_CHECK(geometry.vertexOffset + static_cast<vk::DeviceSize>(geometry.vertexCount - 1) * geometry.vertexStride < geometry.vertexBuffer->size, "Cannot create a BLAS from a geometry whose vertices exceed its vertex buffer");
+
+            const auto formatProperties = State.physicalDevice.getFormatProperties(geometry.vertexFormat);
+            AVA_CHECK((formatProperties.bufferFeatures & vk::FormatFeatureFlagBits::eAccelerationStructureVertexBufferKHR) != vk::FormatFeatureFlags{}, "Cannot create a BLAS from a geometry whose vertex format " + vk::to_string(geometry.vertexFormat) + " is not supported for acceleration structures");
+
+            uint32_t geometryPrimitiveCount = geometry.vertexCount / 3;
+            if (geometry.indexBuffer != nullptr)
+            {
+                AVA_CHECK(geometry.indexBuffer->buffer, "Cannot create a BLAS from a geometry with an invalid index buffer");
+                AVA_CHECK((geometry.indexBuffer->bufferUsage & vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR) != vk::BufferUsageFlags{}, "Cannot create a BLAS from a geometry whose index buffer does not have eAccelerationStructureBuildInputReadOnlyKHR buffer usage");
+                AVA_CHECK(geometry.indexType == vk::IndexType::eUint16 || geometry.indexType == vk::IndexType::eUint32, "Cannot create a BLAS from a geometry with an index type other than eUint16 or eUint32");
+
+                const vk::DeviceSize indexSize = (geometry.indexType == vk::IndexType::eUint16) ? sizeof(uint16_t) : sizeof(uint32_t);
+                AVA_CHECK(geometry.indexOffset % indexSize == 0, "Cannot create a BLAS from a geometry whose index offset is not a multiple of its index size");
+                AVA_CHECK(geometry.indexOffset + geometry.indexCount * indexSize <= geometry.indexBuffer->size, "Cannot create a BLAS from a geometry whose indices exceed its index buffer");
+                geometryPrimitiveCount = geometry.indexCount / 3;
+            }
+            AVA_CHECK(geometryPrimitiveCount > 0, "Cannot create a BLAS from a geometry without a whole triangle");
+            primitiveCount += geometryPrimitiveCount;
+
+            if (geometry.transform.has_value())
+            {
+                transforms.push_back(geometry.transform.value());
+            }
+        }
+
+        const auto outBLAS = new BLAS();
+        outBLAS->type = BLASType::Geometries;
+        outBLAS->accelerationStructure = nullptr;
+        outBLAS->meshBuffer = nullptr;
+        outBLAS->geometries = geometries;
+        outBLAS->transformBuffer = nullptr;
+        outBLAS->aabbBuffer = nullptr;
+        if (!transforms.empty())
+        {
+            outBLAS->transformBuffer = ava::createBuffer(transforms.size() * sizeof(vk::TransformMatrixKHR), vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR, MemoryLocation::eCpuToGpu, 16);
+            ava::updateBuffer(outBLAS->transformBuffer, transforms.data(), transforms.size() * sizeof(vk::TransformMatrixKHR), 0);
+        }
+        outBLAS->maxVertex = 0;
+        outBLAS->vertexStride = 0;
+        outBLAS->indexType = vk::IndexType::eNoneKHR;
+        outBLAS->indexCount = 0;
+        outBLAS->vertexDeviceAddress = 0;
+        outBLAS->indexDeviceAddress = 0;
+        outBLAS->instanceCount = primitiveCount;
+        outBLAS->built = false;
+        outBLAS->buildFlags = {};
+        outBLAS->compacted = false;
+        return outBLAS;
+    }
+
+    BLAS* createBottomLevelAccelerationStructure(const ava::Buffer aabbBuffer, const uint32_t aabbCount, const vk::DeviceSize aabbOffset, const uint32_t aabbStride, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        AVA_CHECK(State.rayTracingEnabled, "Cannot create a BLAS when ray tracing is not enabled");
+        AVA_CHECK(aabbBuffer != nullptr && aabbBuffer->buffer, "Cannot create an AABB BLAS from an invalid AABB buffer");
+        AVA_CHECK((aabbBuffer->bufferUsage & vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR) != vk::BufferUsageFlags{}, "Cannot create an AABB BLAS when the AABB buffer does not have eAccelerationStructureBuildInputReadOnlyKHR buffer usage");
+        AVA_CHECK(aabbCount > 0, "Cannot create an AABB BLAS with an AABB count of 0");
+        // Required by VkAccelerationStructureGeometryAabbsDataKHR and VkAccelerationStructureBuildRangeInfoKHR
+        AVA_CHECK(aabbStride >= sizeof(vk::AabbPositionsKHR) && aabbStride % 8 == 0, "Cannot create an AABB BLAS when the AABB stride is smaller than vk::AabbPositionsKHR or not a multiple of 8");
+        AVA_CHECK(aabbOffset % 8 == 0, "Cannot create an AABB BLAS when the AABB offset is not a multiple of 8");
+        AVA_CHECK(aabbOffset + static_cast<vk::DeviceSize>(aabbCount - 1) * aabbStride + sizeof(vk::AabbPositionsKHR) <= aabbBuffer->size, "Cannot create an AABB BLAS when the AABBs exceed the AABB buffer");
+
+        const auto outBLAS = new BLAS();
+        outBLAS->type = BLASType::AABBs;
+        outBLAS->accelerationStructure = nullptr;
+        outBLAS->meshBuffer = nullptr;
+        outBLAS->transformBuffer = nullptr;
+        outBLAS->aabbBuffer = aabbBuffer;
+        outBLAS->aabbOffset = aabbOffset;
+        outBLAS->aabbStride = aabbStride;
+        outBLAS->aabbGeometryFlags = geometryFlags;
+        outBLAS->maxVertex = 0;
+        outBLAS->vertexStride = 0;
+        outBLAS->indexType = vk::IndexType::eNoneKHR;
+        outBLAS->indexCount = 0;
+        outBLAS->vertexDeviceAddress = 0;
+        outBLAS->indexDeviceAddress = 0;
+        outBLAS->instanceCount = aabbCount;
+        outBLAS->built = false;
+        outBLAS->buildFlags = {};
+        outBLAS->compacted = false;
         return outBLAS;
     }
 
@@ -175,21 +284,31 @@ namespace ava::detail
         {
             destroyBuffer(blas->meshBuffer);
         }
+        if (blas->transformBuffer != nullptr)
+        {
+            destroyBuffer(blas->transformBuffer);
+        }
 
         delete blas;
         blas = nullptr;
     }
 
-    vk::AccelerationStructureGeometryKHR getBLASGeometry(const BLAS* blas, vk::GeometryFlagsKHR geometryFlags)
+    static bool isBLASValid(const BLAS* blas)
     {
-        AVA_CHECK(blas != nullptr && blas->meshBuffer, "Cannot get BLAS geometry from an invalid BLAS");
+        return blas != nullptr && (blas->meshBuffer != nullptr || !blas->geometries.empty() || blas->aabbBuffer != nullptr);
+    }
 
-        vk::AccelerationStructureGeometryKHR geometry{};
-        geometry.flags = geometryFlags;
+    std::vector<vk::AccelerationStructureGeometryKHR> getBLASGeometries(const BLAS* blas, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        AVA_CHECK(isBLASValid(blas), "Cannot get BLAS geometries from an invalid BLAS");
+
+        std::vector<vk::AccelerationStructureGeometryKHR> outGeometries;
         switch (blas->type)
         {
         case BLASType::Triangles:
             {
+                vk::AccelerationStructureGeometryKHR geometry{};
+                geometry.flags = geometryFlags;
                 geometry.geometryType = vk::GeometryTypeKHR::eTriangles;
                 geometry.geometry.triangles.sType = vk::StructureType::eAccelerationStructureGeometryTrianglesDataKHR;
                 geometry.geometry.triangles.vertexFormat = vk::Format::eR32G32B32Sfloat;
@@ -199,61 +318,460 @@ namespace ava::detail
                 geometry.geometry.triangles.indexType = blas->indexType;
                 geometry.geometry.triangles.indexData = blas->indexDeviceAddress;
                 geometry.geometry.triangles.transformData.deviceAddress = 0;
+                outGeometries.push_back(geometry);
+                break;
+            }
+        case BLASType::Geometries:
+            {
+                const vk::DeviceAddress transformDeviceAddress = (blas->transformBuffer != nullptr) ? getBufferDeviceAddress(blas->transformBuffer) : 0;
+                outGeometries.reserve(blas->geometries.size());
+                for (const auto& blasGeometry : blas->geometries)
+                {
+                    vk::AccelerationStructureGeometryKHR geometry{};
+                    geometry.flags = blasGeometry.geometryFlags;
+                    geometry.geometryType = vk::GeometryTypeKHR::eTriangles;
+                    geometry.geometry.triangles.sType = vk::StructureType::eAccelerationStructureGeometryTrianglesDataKHR;
+                    geometry.geometry.triangles.vertexFormat = blasGeometry.vertexFormat;
+                    geometry.geometry.triangles.vertexData = getBufferDeviceAddress(blasGeometry.vertexBuffer) + blasGeometry.vertexOffset;
+                    geometry.geometry.triangles.vertexStride = blasGeometry.vertexStride;
+                    geometry.geometry.triangles.maxVertex = blasGeometry.vertexCount - 1;
+                    geometry.geometry.triangles.indexType = (blasGeometry.indexBuffer != nullptr) ? blasGeometry.indexType : vk::IndexType::eNoneKHR;
+                    geometry.geometry.triangles.indexData = (blasGeometry.indexBuffer != nullptr) ? getBufferDeviceAddress(blasGeometry.indexBuffer) + blasGeometry.indexOffset : 0;
+                    // The transforms are packed in geometry order, the build range's transformOffset picks this geometry's
+                    geometry.geometry.triangles.transformData.deviceAddress = blasGeometry.transform.has_value() ? transformDeviceAddress : 0;
+                    outGeometries.push_back(geometry);
+                }
+                break;
+            }
+        case BLASType::AABBs:
+            {
+                vk::AccelerationStructureGeometryKHR geometry{};
+                geometry.flags = blas->aabbGeometryFlags;
+                geometry.geometryType = vk::GeometryTypeKHR::eAabbs;
+                geometry.geometry.aabbs.sType = vk::StructureType::eAccelerationStructureGeometryAabbsDataKHR;
+                geometry.geometry.aabbs.data.deviceAddress = getBufferDeviceAddress(blas->aabbBuffer) + blas->aabbOffset;
+                geometry.geometry.aabbs.stride = blas->aabbStride;
+                outGeometries.push_back(geometry);
                 break;
             }
         default:
             throw std::runtime_error("Unhandled BLAS Type");
         }
-        return geometry;
+        return outGeometries;
+    }
+
+    std::vector<vk::AccelerationStructureBuildRangeInfoKHR> getBLASBuildRangeInfos(const BLAS* blas)
+    {
+        AVA_CHECK(isBLASValid(blas), "Cannot get BLAS build ranges from an invalid BLAS");
+
+        std::vector<vk::AccelerationStructureBuildRangeInfoKHR> outBuildRangeInfos;
+        switch (blas->type)
+        {
+        case BLASType::Triangles:
+        case BLASType::AABBs:
+            {
+                vk::AccelerationStructureBuildRangeInfoKHR buildRangeInfo{};
+                buildRangeInfo.primitiveCount = blas->instanceCount;
+                outBuildRangeInfos.push_back(buildRangeInfo);
+                break;
+            }
+        case BLASType::Geometries:
+            {
+                uint32_t transformIndex = 0;
+                outBuildRangeInfos.reserve(blas->geometries.size());
+                for (const auto& blasGeometry : blas->geometries)
+                {
+                    vk::AccelerationStructureBuildRangeInfoKHR buildRangeInfo{};
+                    buildRangeInfo.primitiveCount = ((blasGeometry.indexBuffer != nullptr) ? blasGeometry.indexCount : blasGeometry.vertexCount) / 3;
+                    if (blasGeometry.transform.has_value())
+                    {
+                        buildRangeInfo.transformOffset = transformIndex++ * sizeof(vk::TransformMatrixKHR);
+                    }
+                    outBuildRangeInfos.push_back(buildRangeInfo);
+                }
+                break;
+            }
+        default:
+            throw std::runtime_error("Unhandled BLAS Type");
+        }
+        return outBuildRangeInfos;
     }
 
     void rebuildBLAS(BLAS* blas, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags)
     {
-        AVA_CHECK(blas != nullptr && blas->meshBuffer, "Cannot rebuild BLAS when acceleration structure is invalid");
-        AVA_CHECK(blas->instanceCount > 0, "Cannot rebuild BLAS when BLAS's instance count is 0");
+        AVA_CHECK(isBLASValid(blas), "Cannot rebuild BLAS when acceleration structure is invalid");
+        buildBLASes({blas}, buildFlags, geometryFlags);
+    }
 
-        vk::AccelerationStructureGeometryKHR geometry = getBLASGeometry(blas, geometryFlags);
+    void rebuildBLAS(const ava::CommandBuffer& commandBuffer, BLAS* blas, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        AVA_CHECK(isBLASValid(blas), "Cannot rebuild BLAS when acceleration structure is invalid");
+        buildBLASes(commandBuffer, {blas}, buildFlags, geometryFlags);
+    }
 
-        if (blas->accelerationStructure != nullptr)
+    struct BLASBuild
+    {
+        BLAS* blas;
+        std::vector<vk::AccelerationStructureGeometryKHR> geometries;
+        std::vector<vk::AccelerationStructureBuildRangeInfoKHR> buildRangeInfos; // One per geometry
+        vk::BuildAccelerationStructureFlagsKHR buildFlags;
+        vk::BuildAccelerationStructureModeKHR mode; // eUpdate refits the BLAS's acceleration structure in place
+        vk::DeviceSize scratchOffset; // Offset into the shared scratch buffer for this build's batch
+        uint32_t batch;
+    };
+
+    // Creates each BLAS's new acceleration structure and lays out the scratch regions, returns the scratch size needed by the largest batch
+    // Refits keep the existing acceleration structures and the flags of their last build
+    static vk::DeviceSize prepareBLASBuilds(std::vector<BLASBuild>& builds, const std::vector<BLAS*>& blases, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags, const vk::DeviceSize maxScratchSize, std::vector<AccelerationStructure*>& oldAccelerationStructures, const bool refit)
+    {
+        const vk::DeviceSize scratchAlignment = std::max<vk::DeviceSize>(State.accelerationStructureProperties.minAccelerationStructureScratchOffsetAlignment, 1);
+
+        // Validate everything up front so a failed check does not leave some BLASes half rebuilt
+        for (const auto blas : blases)
         {
-            destroyAccelerationStructure(blas->accelerationStructure);
+            AVA_CHECK(isBLASValid(blas), "Cannot build BLASes when one of the BLASes is invalid");
+            AVA_CHECK(blas->instanceCount > 0, "Cannot build BLASes when a BLAS's instance count is 0");
+            if (refit)
+            {
+                AVA_CHECK(blas->built && blas->accelerationStructure != nullptr, "Cannot refit BLASes when one of the BLASes has not been built");
+                AVA_CHECK((blas->buildFlags & vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate) != vk::BuildAccelerationStructureFlagsKHR{}, "Cannot refit BLASes when one of the BLASes was not built with eAllowUpdate");
+            }
         }
-        blas->built = false;
+        std::vector<BLAS*> sortedBLASes = blases;
+        std::ranges::sort(sortedBLASes);
+        AVA_CHECK(std::ranges::adjacent_find(sortedBLASes) == sortedBLASes.end(), "Cannot build BLASes when the same BLAS is passed more than once");
+
+        builds.reserve(blases.size());
+        vk::DeviceSize batchScratchSize = 0;
+        vk::DeviceSize requiredScratchSize = 0;
+        uint32_t batch = 0;
+        for (const auto blas : blases)
+        {
+            BLASBuild build{};
+            build.blas = blas;
+            build.buildFlags = refit ? blas->buildFlags : buildFlags;
+            build.mode = refit ? vk::BuildAccelerationStructureModeKHR::eUpdate : vk::BuildAccelerationStructureModeKHR::eBuild;
+            build.geometries = getBLASGeometries(blas, refit ? blas->geometryFlags : geometryFlags);
+            build.buildRangeInfos = getBLASBuildRangeInfos(blas);
+
+            std::vector<uint32_t> maxPrimitiveCounts;
+            maxPrimitiveCounts.reserve(build.buildRangeInfos.size());
+            for (const auto& buildRangeInfo : build.buildRangeInfos)
+            {
+                maxPrimitiveCounts.push_back(buildRangeInfo.primitiveCount);
+            }
 
-        vk::AccelerationStructureBuildGeometryInfoKHR buildGeometryInfo{};
-        buildGeometryInfo.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
-        buildGeometryInfo.flags = buildFlags;
-        buildGeometryInfo.setGeometries(geometry);
-        buildGeometryInfo.mode = vk::BuildAccelerationStructureModeKHR::eBuild;
+            vk::AccelerationStructureBuildGeometryInfoKHR buildGeometryInfo{};
+            buildGeometryInfo.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
+            buildGeometryInfo.flags = build.buildFlags;
+            buildGeometryInfo.setGeometries(build.geometries);
+            buildGeometryInfo.mode = vk::BuildAccelerationStructureModeKHR::eBuild;
 
-        const auto buildSizesInfo = State.device.getAccelerationStructureBuildSizesKHR(vk::AccelerationStructureBuildTypeKHR::eHost, buildGeometryInfo, blas->instanceCount, State.dispatchLoader);
+            const auto buildSizesInfo = State.device.getAccelerationStructureBuildSizesKHR(vk::AccelerationStructureBuildTypeKHR::eDevice, buildGeometryInfo, maxPrimitiveCounts, State.dispatchLoader);
+            const auto scratchSize = alignUp<vk::DeviceSize>(refit ? buildSizesInfo.updateScratchSize : buildSizesInfo.buildScratchSize, scratchAlignment);
 
-        blas->accelerationStructure = createAccelerationStructure(vk::AccelerationStructureTypeKHR::eBottomLevel, buildSizesInfo);
+            // Start a new batch reusing the scratch from the start when this build would not fit
+            if (batchScratchSize > 0 && batchScratchSize + scratchSize > maxScratchSize)
+            {
+                batch++;
+                batchScratchSize = 0;
+            }
+            build.scratchOffset = batchScratchSize;
+            build.batch = batch;
+            batchScratchSize += scratchSize;
+            requiredScratchSize = std::max(requiredScratchSize, batchScratchSize);
 
-        auto scratchBuffer = ava::createBuffer(buildSizesInfo.buildScratchSize, vk::BufferUsageFlagBits::eStorageBuffer, MemoryLocation::eGpuOnly, State.accelerationStructureProperties.minAccelerationStructureScratchOffsetAlignment);
+            if (!refit)
+            {
+                if (blas->accelerationStructure != nullptr)
+                {
+                    oldAccelerationStructures.push_back(blas->accelerationStructure);
+                    blas->accelerationStructure = nullptr;
+                }
+                blas->built = false;
+                blas->accelerationStructure = createAccelerationStructure(vk::AccelerationStructureTypeKHR::eBottomLevel, buildSizesInfo);
+                blas->geometryFlags = geometryFlags;
+            }
 
-        buildGeometryInfo.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
-        buildGeometryInfo.flags = buildFlags;
-        buildGeometryInfo.setGeometries(geometry);
-        buildGeometryInfo.mode = vk::BuildAccelerationStructureModeKHR::eBuild;
-        buildGeometryInfo.dstAccelerationStructure = blas->accelerationStructure->accelerationStructure;
-        buildGeometryInfo.scratchData.deviceAddress = ava::detail::getBufferDeviceAddress(scratchBuffer);
+            builds.push_back(build);
+        }
+        return requiredScratchSize;
+    }
 
-        vk::AccelerationStructureBuildRangeInfoKHR buildRangeInfo{};
-        buildRangeInfo.primitiveCount = blas->instanceCount;
-        buildRangeInfo.primitiveOffset = 0;
-        buildRangeInfo.firstVertex = 0;
-        buildRangeInfo.transformOffset = 0;
+    static void recordBLASBuilds(const vk::CommandBuffer commandBuffer, std::vector<BLASBuild>& builds, const vk::DeviceAddress scratchAddress)
+    {
+        // Builds in the same batch use disjoint scratch regions so they can overlap, the next batch reuses the scratch and has to wait
+        vk::MemoryBarrier scratchBarrier{};
+        scratchBarrier.srcAccessMask = vk::AccessFlagBits::eAccelerationStructureWriteKHR;
+        scratchBarrier.dstAccessMask = vk::AccessFlagBits::eAccelerationStructureReadKHR | vk::AccessFlagBits::eAccelerationStructureWriteKHR;
+
+        size_t batchStart = 0;
+        while (batchStart < builds.size())
+        {
+            size_t batchEnd = batchStart;
+            while (batchEnd < builds.size() && builds[batchEnd].batch == builds[batchStart].batch)
+            {
+                batchEnd++;
+            }
+
+            std::vector<vk::AccelerationStructureBuildGeometryInfoKHR> buildGeometryInfos;
+            std::vector<const vk::AccelerationStructureBuildRangeInfoKHR*> buildRangeInfos;
+            buildGeometryInfos.reserve(batchEnd - batchStart);
+            buildRangeInfos.reserve(batchEnd - batchStart);
+            for (size_t i = batchStart; i < batchEnd; i++)
+            {
+                auto& build = builds[i];
+
+                vk::AccelerationStructureBuildGeometryInfoKHR buildGeometryInfo{};
+                buildGeometryInfo.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
+                buildGeometryInfo.flags = build.buildFlags;
+                buildGeometryInfo.setGeometries(build.geometries);
+                buildGeometryInfo.mode = build.mode;
+                if (build.mode == vk::BuildAccelerationStructureModeKHR::eUpdate)
+                {
+                    buildGeometryInfo.srcAccelerationStructure = build.blas->accelerationStructure->accelerationStructure;
+                }
+                buildGeometryInfo.dstAccelerationStructure = build.blas->accelerationStructure->accelerationStructure;
+                buildGeometryInfo.scratchData.deviceAddress = scratchAddress + build.scratchOffset;
+
+                buildGeometryInfos.push_back(buildGeometryInfo);
+                buildRangeInfos.push_back(build.buildRangeInfos.data());
+            }
+
+            if (batchStart > 0)
+            {
+                commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR, vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR, {}, scratchBarrier, nullptr, nullptr);
+            }
+            commandBuffer.buildAccelerationStructuresKHR(buildGeometryInfos, buildRangeInfos, State.dispatchLoader);
+
+            batchStart = batchEnd;
+        }
+
+        bool replacedAccelerationStructures = false;
+        for (const auto& build : builds)
+        {
+            if (build.mode == vk::BuildAccelerationStructureModeKHR::eUpdate)
+                continue;
+
+            build.blas->buildFlags = build.buildFlags;
+            build.blas->compacted = false;
+            build.blas->built = true;
+            replacedAccelerationStructures = true;
+        }
+        // Refits keep their acceleration structures, so their addresses in TLAS instances stay valid
+        if (replacedAccelerationStructures)
+        {
+            State.blasGeneration++;
+        }
+    }
+
+    // The command buffer may be submitted at any time, so it gets its own scratch which lives until the command buffer is reused
+    static void recordTrackedBLASBuilds(const ava::CommandBuffer& commandBuffer, const std::vector<BLAS*>& blases, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags, const vk::DeviceSize maxScratchSize, const bool refit)
+    {
+        std::vector<BLASBuild> builds;
+        std::vector<AccelerationStructure*> oldAccelerationStructures;
+        const auto scratchSize = prepareBLASBuilds(builds, blases, buildFlags, geometryFlags, maxScratchSize, oldAccelerationStructures, refit);
+
+        if (refit)
+        {
+            // Refits read inputs which may have just been written and overwrite acceleration structures which may still be in use
+            vk::MemoryBarrier inputBarrier{};
+            inputBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eAccelerationStructureWriteKHR;
+            inputBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eAccelerationStructureReadKHR | vk::AccessFlagBits::eAccelerationStructureWriteKHR;
+            commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR, {}, inputBarrier, nullptr, nullptr);
+        }
+
+        auto scratchBuffer = ava::createBuffer(scratchSize, vk::BufferUsageFlagBits::eStorageBuffer, MemoryLocation::eGpuOnly, State.accelerationStructureProperties.minAccelerationStructureScratchOffsetAlignment);
+        recordBLASBuilds(commandBuffer->commandBuffer, builds, getBufferDeviceAddress(scratchBuffer));
+
+        // Make the results visible to TLAS builds and ray tracing later in the command buffer
+        vk::MemoryBarrier resultBarrier{};
+        resultBarrier.srcAccessMask = vk::AccessFlagBits::eAccelerationStructureWriteKHR;
+        resultBarrier.dstAccessMask = vk::AccessFlagBits::eAccelerationStructureReadKHR;
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR, vk::PipelineStageFlagBits::eAllCommands, {}, resultBarrier, nullptr, nullptr);
+
+        trackObject(commandBuffer, std::shared_ptr<void>(nullptr, [scratchBuffer, oldAccelerationStructures](void*) mutable
+        {
+            ava::destroyBuffer(scratchBuffer);
+            for (auto& oldAccelerationStructure : oldAccelerationStructures)
+            {
+                destroyAccelerationStructure(oldAccelerationStructure);
+            }
+        }));
+    }
+
+    // TLASes of frames already submitted may still read the acceleration structure, so it is destroyed once they have completed
+    static void retireAccelerationStructure(AccelerationStructure* accelerationStructure)
+    {
+        retireObject(std::shared_ptr<void>(nullptr, [accelerationStructure](void*) mutable
+        {
+            destroyAccelerationStructure(accelerationStructure);
+        }));
+    }
 
-        const std::vector buildRangeInfos{&buildRangeInfo};
+    // Single time builds are waited on, so the scratch is pooled between them and only grows
+    static void submitBLASBuilds(const std::vector<BLAS*>& blases, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags, const vk::DeviceSize maxScratchSize, const bool refit)
+    {
+        std::vector<BLASBuild> builds;
+        std::vector<AccelerationStructure*> oldAccelerationStructures;
+        const auto scratchSize = prepareBLASBuilds(builds, blases, buildFlags, geometryFlags, maxScratchSize, oldAccelerationStructures, refit);
+
+        if (State.accelerationStructureScratchBuffer == nullptr || State.accelerationStructureScratchBuffer->size < scratchSize)
+        {
+            if (State.accelerationStructureScratchBuffer != nullptr)
+            {
+                ava::destroyBuffer(State.accelerationStructureScratchBuffer);
+            }
+            State.accelerationStructureScratchBuffer = ava::createBuffer(scratchSize, vk::BufferUsageFlagBits::eStorageBuffer, MemoryLocation::eGpuOnly, State.accelerationStructureProperties.minAccelerationStructureScratchOffsetAlignment);
+        }
 
         const auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eGraphics);
-        commandBuffer->commandBuffer.buildAccelerationStructuresKHR(buildGeometryInfo, buildRangeInfos, State.dispatchLoader);
+        recordBLASBuilds(commandBuffer->commandBuffer, builds, getBufferDeviceAddress(State.accelerationStructureScratchBuffer));
         endSingleTimeCommands(commandBuffer);
 
-        destroyBuffer(scratchBuffer);
+        for (const auto oldAccelerationStructure : oldAccelerationStructures)
+        {
+            retireAccelerationStructure(oldAccelerationStructure);
+        }
+    }
+
+    void buildBLASes(const ava::CommandBuffer& commandBuffer, const std::vector<BLAS*>& blases, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags, const vk::DeviceSize maxScratchSize)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot build BLASes with an invalid command buffer");
+        AVA_CHECK(State.rayTracingEnabled, "Cannot build BLASes when ray tracing is not enabled");
+        if (blases.empty())
+            return;
+
+        recordTrackedBLASBuilds(commandBuffer, blases, buildFlags, geometryFlags, maxScratchSize, false);
+    }
+
+    void buildBLASes(const std::vector<BLAS*>& blases, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags, const vk::DeviceSize maxScratchSize)
+    {
+        AVA_CHECK(State.rayTracingEnabled, "Cannot build BLASes when ray tracing is not enabled");
+        if (blases.empty())
+            return;
+
+        submitBLASBuilds(blases, buildFlags, geometryFlags, maxScratchSize, false);
+    }
+
+    void refitBLASes(const ava::CommandBuffer& commandBuffer, const std::vector<BLAS*>& blases, const vk::DeviceSize maxScratchSize)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot refit BLASes with an invalid command buffer");
+        AVA_CHECK(State.rayTracingEnabled, "Cannot refit BLASes when ray tracing is not enabled");
+        if (blases.empty())
+            return;
+
+        recordTrackedBLASBuilds(commandBuffer, blases, {}, {}, maxScratchSize, true);
+    }
+
+    void refitBLASes(const std::vector<BLAS*>& blases, const vk::DeviceSize maxScratchSize)
+    {
+        AVA_CHECK(State.rayTracingEnabled, "Cannot refit BLASes when ray tracing is not enabled");
+        if (blases.empty())
+            return;
+
+        submitBLASBuilds(blases, {}, {}, maxScratchSize, true);
+    }
+
+    static void compactBLASBatch(const std::vector<BLAS*>& batch, ava::BLASCompactionStatistics& statistics)
+    {
+        vk::QueryPoolCreateInfo queryPoolCreateInfo{};
+        queryPoolCreateInfo.queryType = vk::QueryType::eAccelerationStructureCompactedSizeKHR;
+        queryPoolCreateInfo.queryCount = static_cast<uint32_t>(batch.size());
+        const auto queryPool = State.device.createQueryPool(queryPoolCreateInfo);
+
+        std::vector<vk::AccelerationStructureKHR> accelerationStructures;
+        accelerationStructures.reserve(batch.size());
+        for (const auto blas : batch)
+        {
+            accelerationStructures.push_back(blas->accelerationStructure->accelerationStructure);
+        }
+
+        const auto queryCommandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eGraphics);
+        queryCommandBuffer->commandBuffer.resetQueryPool(queryPool, 0, queryPoolCreateInfo.queryCount);
+        queryCommandBuffer->commandBuffer.writeAccelerationStructuresPropertiesKHR(accelerationStructures, vk::QueryType::eAccelerationStructureCompactedSizeKHR, queryPool, 0, State.dispatchLoader);
+        endSingleTimeCommands(queryCommandBuffer);
+
+        std::vector<vk::DeviceSize> compactedSizes(batch.size());
+        const auto result = State.device.getQueryPoolResults(queryPool, 0, queryPoolCreateInfo.queryCount, compactedSizes.size() * sizeof(vk::DeviceSize), compactedSizes.data(), sizeof(vk::DeviceSize), vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+        State.device.destroyQueryPool(queryPool);
+        AVA_CHECK(result == vk::Result::eSuccess, "Cannot compact BLASes when the compacted sizes could not be queried");
+
+        std::vector<AccelerationStructure*> compactedAccelerationStructures(batch.size(), nullptr);
+        const auto copyCommandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eGraphics);
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            const auto originalSize = batch[i]->accelerationStructure->buffer->size;
+            if (compactedSizes[i] == 0 || compactedSizes[i] >= originalSize)
+            {
+                continue; // Nothing to gain, keep the original
+            }
+
+            vk::AccelerationStructureBuildSizesInfoKHR compactedSizesInfo{};
+            compactedSizesInfo.accelerationStructureSize = compactedSizes[i];
+            compactedAccelerationStructures[i] = createAccelerationStructure(vk::AccelerationStructureTypeKHR::eBottomLevel, compactedSizesInfo);
+
+            vk::CopyAccelerationStructureInfoKHR copyInfo{};
+            copyInfo.src = batch[i]->accelerationStructure->accelerationStructure;
+            copyInfo.dst = compactedAccelerationStructures[i]->accelerationStructure;
+            copyInfo.mode = vk::CopyAccelerationStructureModeKHR::eCompact;
+            copyCommandBuffer->commandBuffer.copyAccelerationStructureKHR(copyInfo, State.dispatchLoader);
+        }
+        endSingleTimeCommands(copyCommandBuffer);
+
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            const auto blas = batch[i];
+            ava::BLASCompactionResult compactionResult{};
+            compactionResult.blas = blas;
+            compactionResult.originalSize = blas->accelerationStructure->buffer->size;
+            compactionResult.compactedSize = compactionResult.originalSize;
+
+            if (compactedAccelerationStructures[i] != nullptr)
+            {
+                retireAccelerationStructure(blas->accelerationStructure);
+                blas->accelerationStructure = compactedAccelerationStructures[i];
+                compactionResult.compactedSize = blas->accelerationStructure->buffer->size;
+                State.blasGeneration++;
+            }
+            blas->compacted = true;
+
+            statistics.totalOriginalSize += compactionResult.originalSize;
+            statistics.totalCompactedSize += compactionResult.compactedSize;
+            statistics.results.push_back(compactionResult);
+        }
+    }
+
+    ava::BLASCompactionStatistics compactBLASes(const std::vector<BLAS*>& blases, const uint32_t batchSize)
+    {
+        AVA_CHECK(State.rayTracingEnabled, "Cannot compact BLASes when ray tracing is not enabled");
+        AVA_CHECK(batchSize > 0, "Cannot compact BLASes with a batch size of 0");
+
+        ava::BLASCompactionStatistics statistics{};
+        std::vector<BLAS*> batch;
+        batch.reserve(std::min<size_t>(batchSize, blases.size()));
+        for (const auto blas : blases)
+        {
+            if (blas == nullptr || !blas->built || blas->accelerationStructure == nullptr || blas->compacted)
+                continue;
+            if ((blas->buildFlags & vk::BuildAccelerationStructureFlagBitsKHR::eAllowCompaction) == vk::BuildAccelerationStructureFlagsKHR{})
+            {
+                AVA_WARN("Attempted to compact a BLAS that was not built with eAllowCompaction");
+                continue;
+            }
 
-        blas->built = true;
+            batch.push_back(blas);
+            if (batch.size() == batchSize)
+            {
+                compactBLASBatch(batch, statistics);
+                batch.clear();
+            }
+        }
+        if (!batch.empty())
+        {
+            compactBLASBatch(batch, statistics);
+        }
+        return statistics;
     }
 
     BLASInstance* createBLASInstance(BLAS* blas)
@@ -268,6 +786,8 @@ namespace ava::detail
 
         const auto outBLASInstance = new BLASInstance();
         outBLASInstance->blas = blas;
+        outBLASInstance->baseBLAS = blas;
+        outBLASInstance->boundingSphere = {0.0f, 0.0f, 0.0f, -1.0f};
         outBLASInstance->transformMatrix = getTransformMatrix34(defaultTransformMatrix);
         outBLASInstance->geometryInstanceFlags = {};
         outBLASInstance->instanceCustomIndex = -1;
@@ -276,45 +796,217 @@ namespace ava::detail
         return outBLASInstance;
     }
 
+    static void markTLASInstanceDirty(TLAS* tlas, const uint32_t index)
+    {
+        if (tlas->instanceDirtyMasks[index] == 0)
+        {
+            tlas->dirtyInstances.push_back(index);
+        }
+        tlas->instanceDirtyMasks[index] = static_cast<uint32_t>((1ull << tlas->instanceBuffers.size()) - 1);
+    }
+
     void destroyBLASInstance(BLASInstance*& blasInstance)
     {
         AVA_CHECK_NO_EXCEPT_RETURN(blasInstance != nullptr, "Cannot destroy an invalid BLAS instance");
 
+        // TLASes still holding this instance have to be rebuilt without it, see hasInactiveTLASInstances
+        for (const auto& [tlas, index] : blasInstance->tlasReferences)
+        {
+            tlas->instances[index] = nullptr;
+            markTLASInstanceDirty(tlas, index);
+        }
+
         delete blasInstance;
         blasInstance = nullptr;
     }
 
+    void markBLASInstanceDirty(const BLASInstance* blasInstance)
+    {
+        AVA_CHECK(blasInstance != nullptr, "Cannot mark an invalid BLAS instance as dirty");
+        for (const auto& [tlas, index] : blasInstance->tlasReferences)
+        {
+            markTLASInstanceDirty(tlas, index);
+        }
+    }
+
+    ava::TLASCullingStatistics cullBLASInstances(const std::vector<BLASInstance*>& blasInstances, const ava::TLASCullingParameters& parameters, std::vector<BLASInstance*>& outInstances, std::vector<uint32_t>& outSourceIndices)
+    {
+        AVA_CHECK(parameters.lodDistanceScale > 0.0f, "Cannot cull BLAS instances with a lodDistanceScale that is not positive");
+
+        float frustumPlanes[6][4];
+        extractFrustumPlanes(parameters.viewProjection, frustumPlanes);
+
+        ava::TLASCullingStatistics statistics{};
+        outInstances.clear();
+        outSourceIndices.clear();
+        outInstances.reserve(blasInstances.size());
+        outSourceIndices.reserve(blasInstances.size());
+        for (uint32_t i = 0; i < static_cast<uint32_t>(blasInstances.size()); i++)
+        {
+            const auto blasInstance = blasInstances[i];
+            if (blasInstance == nullptr) continue;
+            statistics.totalCount++;
+
+            // Move the bounding sphere into world space, scaling the radius by the transform's largest axis scale
+            const auto& matrix = blasInstance->transformMatrix.matrix;
+            const auto& sphere = blasInstance->boundingSphere;
+            const bool hasBounds = sphere[3] >= 0.0f;
+            float center[3];
+            float maxScaleSquared = 0.0f;
+            for (uint32_t row = 0; row < 3; row++)
+            {
+                center[row] = matrix[row][0] * sphere[0] + matrix[row][1] * sphere[1] + matrix[row][2] * sphere[2] + matrix[row][3];
+            }
+            for (uint32_t column = 0; column < 3; column++)
+            {
+                maxScaleSquared = std::max(maxScaleSquared, matrix[0][column] * matrix[0][column] + matrix[1][column] * matrix[1][column] + matrix[2][column] * matrix[2][column]);
+            }
+            const float radius = hasBounds ? sphere[3] * std::sqrt(maxScaleSquared) : 0.0f;
+
+            const float offset[3] = {center[0] - parameters.cameraPosition[0], center[1] - parameters.cameraPosition[1], center[2] - parameters.cameraPosition[2]};
+            const float distance = std::max(std::sqrt(offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2]) - radius, 0.0f);
+            if (distance > parameters.maxDistance)
+            {
+                statistics.distanceCulledCount++;
+                continue;
+            }
+
+            if (parameters.frustumCulling && hasBounds)
+            {
+                bool outside = false;
+                for (const auto& plane : frustumPlanes)
+                {
+                    if (plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3] < -radius)
+                    {
+                        outside = true;
+                        break;
+                    }
+                }
+                if (outside)
+                {
+                    statistics.frustumCulledCount++;
+                    continue;
+                }
+            }
+
+            // The furthest LOD in range wins, LODs which are not built fall back to the next more detailed one
+            BLAS* lodBLAS = blasInstance->baseBLAS;
+            const float lodDistance = distance / parameters.lodDistanceScale;
+            for (const auto& [blas, minDistance] : blasInstance->lods)
+            {
+                if (lodDistance < minDistance) break;
+                if (blas != nullptr && blas->built)
+                {
+                    lodBLAS = blas;
+                }
+            }
+            if (lodBLAS != blasInstance->blas)
+            {
+                blasInstance->blas = lodBLAS;
+                markBLASInstanceDirty(blasInstance);
+            }
+
+            outInstances.push_back(blasInstance);
+            outSourceIndices.push_back(i);
+        }
+
+        statistics.visibleCount = static_cast<uint32_t>(outInstances.size());
+        return statistics;
+    }
+
     TLAS* createTopLevelAccelerationStructure()
     {
         AVA_CHECK(State.rayTracingEnabled, "Cannot create a TLAS when ray tracing is not enabled");
+        AVA_CHECK(State.framesInFlight <= 32, "Cannot create a TLAS when there are more than 32 frames in flight");
 
         const auto outTLAS = new TLAS();
         outTLAS->accelerationStructure = nullptr;
         outTLAS->built = false;
+        outTLAS->lastGeometryFlags = {};
+        outTLAS->instanceCapacity = 0;
+        outTLAS->scratchBuffer = nullptr;
+        outTLAS->blasGeneration = 0;
+        outTLAS->cullingStatistics = {};
         return outTLAS;
     }
 
+    static void unregisterTLASInstances(TLAS* tlas)
+    {
+        for (const auto blasInstance : tlas->instances)
+        {
+            if (blasInstance == nullptr) continue;
+            std::erase_if(blasInstance->tlasReferences, [tlas](const std::pair<TLAS*, uint32_t>& reference) { return reference.first == tlas; });
+        }
+    }
+
     void destroyTopLevelAccelerationStructure(TLAS*& tlas)
     {
         AVA_CHECK_NO_EXCEPT_RETURN(tlas != nullptr, "Cannot destroy an invalid TLAS");
 
+        unregisterTLASInstances(tlas);
+
         if (tlas->accelerationStructure != nullptr)
         {
             destroyAccelerationStructure(tlas->accelerationStructure);
         }
+        for (auto& instanceBuffer : tlas->instanceBuffers)
+        {
+            destroyBuffer(instanceBuffer);
+        }
+        if (tlas->scratchBuffer != nullptr)
+        {
+            destroyBuffer(tlas->scratchBuffer);
+        }
 
         delete tlas;
         tlas = nullptr;
     }
 
-    void rebuildTLAS(TLAS* tlas, const std::vector<BLASInstance*>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags, vk::GeometryFlagsKHR geometryFlags)
+    // Replaced resources are kept alive by the command buffer until it is reused, which is after its submission has completed
+    static void trackBuffer(const ava::CommandBuffer& commandBuffer, ava::Buffer& buffer)
     {
-        AVA_CHECK(tlas != nullptr, "Cannot rebuild TLAS when TLAS is invalid");
+        trackObject(commandBuffer, std::shared_ptr<void>(nullptr, [buffer](void*) mutable
+        {
+            ava::destroyBuffer(buffer);
+        }));
+        buffer = nullptr;
+    }
+
+    static void trackAccelerationStructure(const ava::CommandBuffer& commandBuffer, AccelerationStructure*& accelerationStructure)
+    {
+        trackObject(commandBuffer, std::shared_ptr<void>(nullptr, [accelerationStructure](void*) mutable
+        {
+            destroyAccelerationStructure(accelerationStructure);
+        }));
+        accelerationStructure = nullptr;
+    }
+
+    static VkAccelerationStructureInstanceKHR getTLASInstance(const TLAS* tlas, const uint32_t index)
+    {
+        // Destroyed instances are written with a null reference, which makes them inactive. Only builds write them, updates would change their activity
+        VkAccelerationStructureInstanceKHR instance{};
+        const auto blasInstance = tlas->instances[index];
+        if (blasInstance == nullptr || blasInstance->blas == nullptr || !blasInstance->blas->built)
+        {
+            return instance;
+        }
+
+        instance.accelerationStructureReference = blasInstance->blas->accelerationStructure->accelerationStructureAddress;
+        instance.flags = static_cast<VkGeometryInstanceFlagsKHR>(blasInstance->geometryInstanceFlags);
+        instance.instanceCustomIndex = tlas->instanceCustomIndices[index];
+        instance.mask = blasInstance->mask;
+        instance.transform = blasInstance->transformMatrix;
+        instance.instanceShaderBindingTableRecordOffset = blasInstance->instanceShaderBindingTableRecordOffset;
+        return instance;
+    }
 
+    // Filters out invalid instances and returns the build hash of those that remain
+    static uint64_t gatherTLASInstances(const std::vector<BLASInstance*>& blasInstances, const vk::GeometryFlagsKHR geometryFlags, const std::vector<uint32_t>& sourceIndices, std::vector<BLASInstance*>& outInstances, std::vector<uint32_t>& outCustomIndices)
+    {
         uint64_t buildHash = 0;
 
-        std::vector<VkAccelerationStructureInstanceKHR> instances;
-        instances.reserve(blasInstances.size());
+        outInstances.reserve(blasInstances.size());
+        outCustomIndices.reserve(blasInstances.size());
         for (size_t i = 0; i < blasInstances.size(); i++)
         {
             const auto blasInstance = blasInstances[i];
@@ -325,27 +1017,135 @@ namespace ava::detail
                 continue;
             }
 
-            VkAccelerationStructureInstanceKHR instance{};
-            instance.accelerationStructureReference = blasInstance->blas->accelerationStructure->accelerationStructureAddress;
-            instance.flags = static_cast<VkGeometryInstanceFlagsKHR>(blasInstance->geometryInstanceFlags);
-            instance.instanceCustomIndex = (blasInstance->instanceCustomIndex < 0) ? i : blasInstance->instanceCustomIndex; // if negative use i rather than explicit value
-            instance.mask = blasInstance->mask;
-            instance.transform = blasInstance->transformMatrix;
-            instance.instanceShaderBindingTableRecordOffset = blasInstance->instanceShaderBindingTableRecordOffset;
+            const uint64_t accelerationStructureReference = blasInstance->blas->accelerationStructure->accelerationStructureAddress;
+            const uint64_t flags = static_cast<VkGeometryInstanceFlagsKHR>(blasInstance->geometryInstanceFlags);
+            const uint32_t sourceIndex = sourceIndices.empty() ? static_cast<uint32_t>(i) : sourceIndices[i];
+            const uint32_t instanceCustomIndex = (blasInstance->instanceCustomIndex < 0) ? sourceIndex : static_cast<uint32_t>(blasInstance->instanceCustomIndex); // if negative use i rather than explicit value
+
+            outInstances.push_back(blasInstance);
+            outCustomIndices.push_back(instanceCustomIndex);
+
+            buildHash = (buildHash << 2) ^ std::hash<uint64_t>{}(accelerationStructureReference) ^ (std::hash<uint64_t>{}(flags) << 4) ^ (std::hash<uint64_t>{}(instanceCustomIndex) << 7);
+        }
+
+        buildHash ^= std::hash<uint64_t>{}(static_cast<vk::GeometryFlagsKHR::MaskType>(geometryFlags)) ^ std::hash<uint64_t>{}(outInstances.size());
+        return buildHash;
+    }
+
+    // Cheap check that blasInstances is what the TLAS was last built from, without rehashing
+    static bool hasSameTLASInstances(const TLAS* tlas, const std::vector<BLASInstance*>& blasInstances, const std::vector<uint32_t>& sourceIndices)
+    {
+        if (tlas->blasGeneration != State.blasGeneration)
+        {
+            return false; // A BLAS has been rebuilt since, references may have changed
+        }
+
+        size_t instanceIndex = 0;
+        for (size_t i = 0; i < blasInstances.size(); i++)
+        {
+            const auto blasInstance = blasInstances[i];
+            if (blasInstance == nullptr || blasInstance->blas == nullptr || !blasInstance->blas->built) continue;
+
+            const uint32_t sourceIndex = sourceIndices.empty() ? static_cast<uint32_t>(i) : sourceIndices[i];
+            const uint32_t instanceCustomIndex = (blasInstance->instanceCustomIndex < 0) ? sourceIndex : static_cast<uint32_t>(blasInstance->instanceCustomIndex);
+            if (instanceIndex >= tlas->instances.size() || tlas->instances[instanceIndex] != blasInstance || tlas->instanceCustomIndices[instanceIndex] != instanceCustomIndex)
+            {
+                return false;
+            }
+            instanceIndex++;
+        }
+        return instanceIndex == tlas->instances.size();
+    }
+
+    static uint32_t getTLASInstanceBufferIndex(const TLAS* tlas)
+    {
+        return State.currentFrame % static_cast<uint32_t>(tlas->instanceBuffers.size());
+    }
+
+    // Replaces the TLAS's instances, writing them all into the current instance buffer and marking them dirty in the others
+    // The other instance buffers may still be read by frames in flight, so they are only written when next used
+    static void setTLASInstances(const ava::CommandBuffer& commandBuffer, TLAS* tlas, std::vector<BLASInstance*>&& instances, std::vector<uint32_t>&& instanceCustomIndices)
+    {
+        unregisterTLASInstances(tlas);
+        tlas->instances = std::move(instances);
+        tlas->instanceCustomIndices = std::move(instanceCustomIndices);
+        tlas->blasGeneration = State.blasGeneration;
+
+        const auto instanceCount = static_cast<uint32_t>(tlas->instances.size());
+        for (uint32_t i = 0; i < instanceCount; i++)
+        {
+            tlas->instances[i]->tlasReferences.emplace_back(tlas, i);
+        }
+
+        if (tlas->instanceBuffers.empty() || instanceCount > tlas->instanceCapacity)
+        {
+            for (auto& instanceBuffer : tlas->instanceBuffers)
+            {
+                trackBuffer(commandBuffer, instanceBuffer);
+            }
+
+            tlas->instanceCapacity = std::max(std::max(instanceCount, tlas->instanceCapacity * 2), 1u);
+            tlas->instanceBuffers.resize(State.framesInFlight);
+            for (auto& instanceBuffer : tlas->instanceBuffers)
+            {
+                instanceBuffer = ava::createBuffer(sizeof(VkAccelerationStructureInstanceKHR) * tlas->instanceCapacity, vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR, MemoryLocation::eCpuToGpu, 16);
+            }
+        }
 
-            instances.emplace_back(instance);
+        const auto instanceBufferIndex = getTLASInstanceBufferIndex(tlas);
+        std::vector<VkAccelerationStructureInstanceKHR> instanceData(instanceCount);
+        for (uint32_t i = 0; i < instanceCount; i++)
+        {
+            instanceData[i] = getTLASInstance(tlas, i);
+        }
+        if (instanceCount > 0)
+        {
+            updateBuffer(tlas->instanceBuffers[instanceBufferIndex], instanceData.data(), instanceData.size() * sizeof(VkAccelerationStructureInstanceKHR), 0);
+        }
 
-            buildHash = (buildHash << 2) ^ std::hash<uint64_t>{}(instance.accelerationStructureReference) ^ (std::hash<uint64_t>{}(instance.flags) << 4) ^ (std::hash<uint64_t>{}(instance.instanceCustomIndex) << 7);
+        const auto otherInstanceBuffersMask = static_cast<uint32_t>((1ull << tlas->instanceBuffers.size()) - 1) & ~(1u << instanceBufferIndex);
+        tlas->instanceDirtyMasks.assign(instanceCount, otherInstanceBuffersMask);
+        tlas->dirtyInstances.clear();
+        if (otherInstanceBuffersMask != 0)
+        {
+            tlas->dirtyInstances.resize(instanceCount);
+            std::iota(tlas->dirtyInstances.begin(), tlas->dirtyInstances.end(), 0u);
         }
+    }
 
-        buildHash ^= std::hash<uint64_t>{}(static_cast<vk::GeometryFlagsKHR::MaskType>(geometryFlags)) ^ std::hash<uint64_t>{}(instances.size());
+    // Writes only the instances that changed since this instance buffer was last written
+    static void writeDirtyTLASInstances(TLAS* tlas, const uint32_t instanceBufferIndex)
+    {
+        const auto& instanceBuffer = tlas->instanceBuffers[instanceBufferIndex];
+        const uint32_t instanceBufferBit = 1u << instanceBufferIndex;
+        std::erase_if(tlas->dirtyInstances, [&](const uint32_t index)
+        {
+            auto& dirtyMask = tlas->instanceDirtyMasks[index];
+            if ((dirtyMask & instanceBufferBit) != 0)
+            {
+                const auto instance = getTLASInstance(tlas, index);
+                updateBuffer(instanceBuffer, &instance, sizeof(VkAccelerationStructureInstanceKHR), index * sizeof(VkAccelerationStructureInstanceKHR));
+                dirtyMask &= ~instanceBufferBit;
+            }
+            return dirtyMask == 0;
+        });
+    }
 
-        const auto instancesBufferSize = sizeof(VkAccelerationStructureInstanceKHR) * instances.size();
-        auto instancesBuffer = ava::createBuffer(instancesBufferSize, vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR, MemoryLocation::eCpuToGpu, 0);
-        updateBuffer(instancesBuffer, instances);
+    // An update cannot change whether an instance is active, so destroyed instances and those whose BLAS is not built need a rebuild
+    // Only dirty instances can have changed since the TLAS was last built
+    static bool hasInactiveTLASInstances(const TLAS* tlas)
+    {
+        return std::ranges::any_of(tlas->dirtyInstances, [tlas](const uint32_t index)
+        {
+            const auto blasInstance = tlas->instances[index];
+            return blasInstance == nullptr || blasInstance->blas == nullptr || !blasInstance->blas->built;
+        });
+    }
 
+    static vk::AccelerationStructureGeometryKHR getTLASGeometry(const ava::Buffer& instanceBuffer, const vk::GeometryFlagsKHR geometryFlags)
+    {
         vk::DeviceOrHostAddressConstKHR instanceDataDeviceAddress;
-        instanceDataDeviceAddress.deviceAddress = getBufferDeviceAddress(instancesBuffer);
+        instanceDataDeviceAddress.deviceAddress = getBufferDeviceAddress(instanceBuffer);
 
         vk::AccelerationStructureGeometryKHR geometry{};
         geometry.flags = geometryFlags;
@@ -353,6 +1153,47 @@ namespace ava::detail
         geometry.geometry.instances.sType = vk::StructureType::eAccelerationStructureGeometryInstancesDataKHR;
         geometry.geometry.instances.arrayOfPointers = false;
         geometry.geometry.instances.data = instanceDataDeviceAddress;
+        return geometry;
+    }
+
+    // Records one TLAS build with barriers on both sides, as the retained scratch and the TLAS may still be in use by earlier builds and traces
+    static void recordTLASBuild(const ava::CommandBuffer& commandBuffer, const vk::AccelerationStructureBuildGeometryInfoKHR& buildGeometryInfo, const uint32_t instanceCount)
+    {
+        vk::AccelerationStructureBuildRangeInfoKHR buildRangeInfo{};
+        buildRangeInfo.primitiveCount = instanceCount;
+        buildRangeInfo.primitiveOffset = 0;
+        buildRangeInfo.firstVertex = 0;
+        buildRangeInfo.transformOffset = 0;
+
+        const std::vector buildRangeInfos = {&buildRangeInfo};
+
+        vk::MemoryBarrier beforeBarrier{};
+        beforeBarrier.srcAccessMask = vk::AccessFlagBits::eAccelerationStructureReadKHR | vk::AccessFlagBits::eAccelerationStructureWriteKHR;
+        beforeBarrier.dstAccessMask = vk::AccessFlagBits::eAccelerationStructureReadKHR | vk::AccessFlagBits::eAccelerationStructureWriteKHR;
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR, {}, beforeBarrier, nullptr, nullptr);
+
+        commandBuffer->commandBuffer.buildAccelerationStructuresKHR(buildGeometryInfo, buildRangeInfos, State.dispatchLoader);
+
+        // Make the build visible to ray tracing and ray queries later in the command buffer
+        vk::MemoryBarrier afterBarrier{};
+        afterBarrier.srcAccessMask = vk::AccessFlagBits::eAccelerationStructureWriteKHR;
+        afterBarrier.dstAccessMask = vk::AccessFlagBits::eAccelerationStructureReadKHR;
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR, vk::PipelineStageFlagBits::eAllCommands, {}, afterBarrier, nullptr, nullptr);
+    }
+
+    void rebuildTLAS(const ava::CommandBuffer& commandBuffer, TLAS* tlas, const std::vector<BLASInstance*>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags, vk::GeometryFlagsKHR geometryFlags, const std::vector<uint32_t>& sourceIndices)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot rebuild TLAS with an invalid command buffer");
+        AVA_CHECK(tlas != nullptr, "Cannot rebuild TLAS when TLAS is invalid");
+        AVA_CHECK(sourceIndices.empty() || sourceIndices.size() == blasInstances.size(), "Cannot rebuild TLAS when the source indices do not match the BLAS instances");
+
+        std::vector<BLASInstance*> instances;
+        std::vector<uint32_t> instanceCustomIndices;
+        const auto buildHash = gatherTLASInstances(blasInstances, geometryFlags, sourceIndices, instances, instanceCustomIndices);
+        setTLASInstances(commandBuffer, tlas, std::move(instances), std::move(instanceCustomIndices));
+
+        const auto instanceCount = static_cast<uint32_t>(tlas->instances.size());
+        vk::AccelerationStructureGeometryKHR geometry = getTLASGeometry(tlas->instanceBuffers[getTLASInstanceBufferIndex(tlas)], geometryFlags);
 
         vk::AccelerationStructureBuildGeometryInfoKHR buildGeometryInfo{};
         buildGeometryInfo.type = vk::AccelerationStructureTypeKHR::eTopLevel;
@@ -360,105 +1201,78 @@ namespace ava::detail
         buildGeometryInfo.setGeometries(geometry);
         buildGeometryInfo.mode = vk::BuildAccelerationStructureModeKHR::eBuild;
 
-        const auto buildSizesInfo = State.device.getAccelerationStructureBuildSizesKHR(vk::AccelerationStructureBuildTypeKHR::eDevice, buildGeometryInfo, instances.size(), State.dispatchLoader);
+        const auto buildSizesInfo = State.device.getAccelerationStructureBuildSizesKHR(vk::AccelerationStructureBuildTypeKHR::eDevice, buildGeometryInfo, instanceCount, State.dispatchLoader);
 
         tlas->built = false;
         if (tlas->accelerationStructure != nullptr)
         {
-            destroyAccelerationStructure(tlas->accelerationStructure);
+            trackAccelerationStructure(commandBuffer, tlas->accelerationStructure);
         }
 
         // ReSharper disable once CppDFAMemoryLeak
         tlas->accelerationStructure = createAccelerationStructure(vk::AccelerationStructureTypeKHR::eTopLevel, buildSizesInfo);
 
-        auto scratchBuffer = ava::createBuffer(buildSizesInfo.buildScratchSize, vk::BufferUsageFlagBits::eStorageBuffer, MemoryLocation::eGpuOnly, State.accelerationStructureProperties.minAccelerationStructureScratchOffsetAlignment);
+        // The scratch is kept for later updates and refits, so it has to fit both
+        const auto scratchSize = std::max(buildSizesInfo.buildScratchSize, buildSizesInfo.updateScratchSize);
+        if (tlas->scratchBuffer == nullptr || tlas->scratchBuffer->size < scratchSize)
+        {
+            if (tlas->scratchBuffer != nullptr)
+            {
+                trackBuffer(commandBuffer, tlas->scratchBuffer);
+            }
+            tlas->scratchBuffer = ava::createBuffer(scratchSize, vk::BufferUsageFlagBits::eStorageBuffer, MemoryLocation::eGpuOnly, State.accelerationStructureProperties.minAccelerationStructureScratchOffsetAlignment);
+        }
 
-        buildGeometryInfo.type = vk::AccelerationStructureTypeKHR::eTopLevel;
-        buildGeometryInfo.flags = buildFlags;
-        buildGeometryInfo.setGeometries(geometry);
-        buildGeometryInfo.mode = vk::BuildAccelerationStructureModeKHR::eBuild;
         buildGeometryInfo.dstAccelerationStructure = tlas->accelerationStructure->accelerationStructure;
-        buildGeometryInfo.scratchData.deviceAddress = getBufferDeviceAddress(scratchBuffer);
+        buildGeometryInfo.scratchData.deviceAddress = getBufferDeviceAddress(tlas->scratchBuffer);
 
-        vk::AccelerationStructureBuildRangeInfoKHR buildRangeInfo{};
-        buildRangeInfo.primitiveCount = instances.size();
-        buildRangeInfo.primitiveOffset = 0;
-        buildRangeInfo.firstVertex = 0;
-        buildRangeInfo.transformOffset = 0;
-
-        const std::vector buildRangeInfos = {&buildRangeInfo};
-
-        auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eGraphics);
-        commandBuffer->commandBuffer.buildAccelerationStructuresKHR(buildGeometryInfo, buildRangeInfos, State.dispatchLoader);
-        endSingleTimeCommands(commandBuffer);
-
-        ava::destroyBuffer(scratchBuffer);
-        ava::destroyBuffer(instancesBuffer);
+        recordTLASBuild(commandBuffer, buildGeometryInfo, instanceCount);
 
         tlas->lastBuildSizesInfo = buildSizesInfo;
         tlas->lastBuildHash = buildHash;
         tlas->lastBuildFlags = buildFlags;
+        tlas->lastGeometryFlags = geometryFlags;
         tlas->built = true;
     }
 
-    bool updateTLAS(TLAS* tlas, const std::vector<BLASInstance*>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags, vk::GeometryFlagsKHR geometryFlags)
+    void rebuildTLAS(TLAS* tlas, const std::vector<BLASInstance*>& blasInstances, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        const auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eGraphics);
+        rebuildTLAS(commandBuffer, tlas, blasInstances, buildFlags, geometryFlags);
+        endSingleTimeCommands(commandBuffer);
+    }
+
+    bool updateTLAS(const ava::CommandBuffer& commandBuffer, TLAS* tlas, const std::vector<BLASInstance*>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags, vk::GeometryFlagsKHR geometryFlags, const std::vector<uint32_t>& sourceIndices)
     {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot update TLAS with an invalid command buffer");
         AVA_CHECK(tlas != nullptr, "Cannot update TLAS when TLAS is invalid");
         AVA_CHECK(tlas->built, "Cannot update an un-built TLAS");
         AVA_CHECK((tlas->lastBuildFlags & vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate) != vk::BuildAccelerationStructureFlagsKHR{}, "Cannot update a TLAS that was not previously built with build flags containing eAllowUpdate");
+        AVA_CHECK(sourceIndices.empty() || sourceIndices.size() == blasInstances.size(), "Cannot update TLAS when the source indices do not match the BLAS instances");
 
-        uint64_t buildHash = 0;
-
-        std::vector<VkAccelerationStructureInstanceKHR> instances;
-        instances.reserve(blasInstances.size());
-        for (size_t i = 0; i < blasInstances.size(); i++)
+        // Only hash and rewrite every instance when the instances differ from the last build
+        if (geometryFlags != tlas->lastGeometryFlags || !hasSameTLASInstances(tlas, blasInstances, sourceIndices))
         {
-            const auto blasInstance = blasInstances[i];
-            if (blasInstance == nullptr || blasInstance->blas == nullptr) continue;
-            if (!blasInstance->blas->built)
+            std::vector<BLASInstance*> instances;
+            std::vector<uint32_t> instanceCustomIndices;
+            const auto buildHash = gatherTLASInstances(blasInstances, geometryFlags, sourceIndices, instances, instanceCustomIndices);
+            if (buildHash != tlas->lastBuildHash)
             {
-                AVA_WARN("Attempted to build TLAS when BLAS instance's BLAS is not built");
-                continue;
+                return false;
             }
-
-            VkAccelerationStructureInstanceKHR instance{};
-            instance.accelerationStructureReference = blasInstance->blas->accelerationStructure->accelerationStructureAddress;
-            instance.flags = static_cast<VkGeometryInstanceFlagsKHR>(blasInstance->geometryInstanceFlags);
-            instance.instanceCustomIndex = (blasInstance->instanceCustomIndex < 0) ? i : blasInstance->instanceCustomIndex; // if negative use i rather than explicit value
-            instance.mask = blasInstance->mask;
-            instance.transform = blasInstance->transformMatrix;
-            instance.instanceShaderBindingTableRecordOffset = blasInstance->instanceShaderBindingTableRecordOffset;
-
-            instances.emplace_back(instance);
-            buildHash = (buildHash << 2) ^ std::hash<uint64_t>{}(instance.accelerationStructureReference) ^ (std::hash<uint64_t>{}(instance.flags) << 4) ^ (std::hash<uint64_t>{}(instance.instanceCustomIndex) << 7);
+            setTLASInstances(commandBuffer, tlas, std::move(instances), std::move(instanceCustomIndices));
         }
-
-        buildHash ^= std::hash<uint64_t>{}(static_cast<vk::GeometryFlagsKHR::MaskType>(geometryFlags)) ^ std::hash<uint64_t>{}(instances.size());
-
-        if (buildHash != tlas->lastBuildHash)
+        if (hasInactiveTLASInstances(tlas))
         {
             return false;
         }
 
-        const auto instancesBufferSize = sizeof(VkAccelerationStructureInstanceKHR) * instances.size();
-        auto instancesBuffer = ava::createBuffer(instancesBufferSize, vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR, MemoryLocation::eCpuToGpu, 0);
-        updateBuffer(instancesBuffer, instances);
+        const auto instanceBufferIndex = getTLASInstanceBufferIndex(tlas);
+        writeDirtyTLASInstances(tlas, instanceBufferIndex);
 
-        vk::DeviceOrHostAddressConstKHR instanceDataDeviceAddress;
-        instanceDataDeviceAddress.deviceAddress = getBufferDeviceAddress(instancesBuffer);
+        vk::AccelerationStructureGeometryKHR geometry = getTLASGeometry(tlas->instanceBuffers[instanceBufferIndex], geometryFlags);
 
-        vk::AccelerationStructureGeometryKHR geometry{};
-        geometry.flags = geometryFlags;
-        geometry.geometryType = vk::GeometryTypeKHR::eInstances;
-        geometry.geometry.instances.sType = vk::StructureType::eAccelerationStructureGeometryInstancesDataKHR;
-        geometry.geometry.instances.arrayOfPointers = false;
-        geometry.geometry.instances.data = instanceDataDeviceAddress;
-
-        const auto buildSizesInfo = tlas->lastBuildSizesInfo;
-
-        auto scratchBuffer = ava::createBuffer(buildSizesInfo.updateScratchSize, vk::BufferUsageFlagBits::eStorageBuffer, MemoryLocation::eGpuOnly, State.accelerationStructureProperties.minAccelerationStructureScratchOffsetAlignment);
-
-        auto newAccelerationStructure = createAccelerationStructure(vk::AccelerationStructureTypeKHR::eTopLevel, buildSizesInfo);
+        auto newAccelerationStructure = createAccelerationStructure(vk::AccelerationStructureTypeKHR::eTopLevel, tlas->lastBuildSizesInfo);
 
         vk::AccelerationStructureBuildGeometryInfoKHR buildGeometryInfo{};
         buildGeometryInfo.type = vk::AccelerationStructureTypeKHR::eTopLevel;
@@ -467,25 +1281,72 @@ namespace ava::detail
         buildGeometryInfo.mode = vk::BuildAccelerationStructureModeKHR::eUpdate;
         buildGeometryInfo.srcAccelerationStructure = tlas->accelerationStructure->accelerationStructure;
         buildGeometryInfo.dstAccelerationStructure = newAccelerationStructure->accelerationStructure;
-        buildGeometryInfo.scratchData.deviceAddress = getBufferDeviceAddress(scratchBuffer);
+        buildGeometryInfo.scratchData.deviceAddress = getBufferDeviceAddress(tlas->scratchBuffer);
 
-        vk::AccelerationStructureBuildRangeInfoKHR buildRangeInfo{};
-        buildRangeInfo.primitiveCount = instances.size();
-        buildRangeInfo.primitiveOffset = 0;
-        buildRangeInfo.firstVertex = 0;
-        buildRangeInfo.transformOffset = 0;
+        recordTLASBuild(commandBuffer, buildGeometryInfo, static_cast<uint32_t>(tlas->instances.size()));
 
-        const std::vector buildRangeInfos = {&buildRangeInfo};
+        trackAccelerationStructure(commandBuffer, tlas->accelerationStructure);
+        tlas->accelerationStructure = newAccelerationStructure;
+        return true;
+    }
 
-        auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eGraphics);
-        commandBuffer->commandBuffer.buildAccelerationStructuresKHR(buildGeometryInfo, buildRangeInfos, State.dispatchLoader);
+    bool updateTLAS(TLAS* tlas, const std::vector<BLASInstance*>& blasInstances, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        const auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eGraphics);
+        const bool updated = updateTLAS(commandBuffer, tlas, blasInstances, buildFlags, geometryFlags);
         endSingleTimeCommands(commandBuffer);
+        return updated;
+    }
 
-        destroyAccelerationStructure(tlas->accelerationStructure);
-        tlas->accelerationStructure = newAccelerationStructure;
+    void refitTLAS(const ava::CommandBuffer& commandBuffer, TLAS* tlas)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot refit TLAS with an invalid command buffer");
+        AVA_CHECK(tlas != nullptr, "Cannot refit TLAS when TLAS is invalid");
+        AVA_CHECK(tlas->built, "Cannot refit an un-built TLAS");
+        AVA_CHECK((tlas->lastBuildFlags & vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate) != vk::BuildAccelerationStructureFlagsKHR{}, "Cannot refit a TLAS that was not previously built with build flags containing eAllowUpdate");
 
-        ava::destroyBuffer(scratchBuffer);
-        ava::destroyBuffer(instancesBuffer);
-        return true;
+        // A rebuilt BLAS moves its acceleration structure, so every reference has to be rewritten
+        if (tlas->blasGeneration != State.blasGeneration)
+        {
+            for (uint32_t i = 0; i < static_cast<uint32_t>(tlas->instances.size()); i++)
+            {
+                markTLASInstanceDirty(tlas, i);
+            }
+            tlas->blasGeneration = State.blasGeneration;
+        }
+
+        // Falls back to a build from the remaining instances, which keep their custom indices but not their index
+        if (hasInactiveTLASInstances(tlas))
+        {
+            std::vector<BLASInstance*> instances;
+            std::vector<uint32_t> instanceCustomIndices;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(tlas->instances.size()); i++)
+            {
+                if (tlas->instances[i] != nullptr)
+                {
+                    instances.push_back(tlas->instances[i]);
+                    instanceCustomIndices.push_back(tlas->instanceCustomIndices[i]);
+                }
+            }
+            rebuildTLAS(commandBuffer, tlas, instances, tlas->lastBuildFlags, tlas->lastGeometryFlags, instanceCustomIndices);
+            return;
+        }
+
+        const auto instanceBufferIndex = getTLASInstanceBufferIndex(tlas);
+        writeDirtyTLASInstances(tlas, instanceBufferIndex);
+
+        vk::AccelerationStructureGeometryKHR geometry = getTLASGeometry(tlas->instanceBuffers[instanceBufferIndex], tlas->lastGeometryFlags);
+
+        // Refit in place, src and dst may be the same acceleration structure for updates
+        vk::AccelerationStructureBuildGeometryInfoKHR buildGeometryInfo{};
+        buildGeometryInfo.type = vk::AccelerationStructureTypeKHR::eTopLevel;
+        buildGeometryInfo.flags = tlas->lastBuildFlags;
+        buildGeometryInfo.setGeometries(geometry);
+        buildGeometryInfo.mode = vk::BuildAccelerationStructureModeKHR::eUpdate;
+        buildGeometryInfo.srcAccelerationStructure = tlas->accelerationStructure->accelerationStructure;
+        buildGeometryInfo.dstAccelerationStructure = tlas->accelerationStructure->accelerationStructure;
+        buildGeometryInfo.scratchData.deviceAddress = getBufferDeviceAddress(tlas->scratchBuffer);
+
+        recordTLASBuild(commandBuffer, buildGeometryInfo, static_cast<uint32_t>(tlas->instances.size()));
     }
 }
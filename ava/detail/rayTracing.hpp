@@ -3,6 +3,7 @@
 
 #include "./vulkan.hpp"
 #include "../types.hpp"
+#include "../rayTracing.hpp"
 
 namespace ava::detail
 {
@@ -17,6 +18,8 @@ namespace ava::detail
     enum class BLASType
     {
         Triangles,
+        Geometries, // Built from ava::BLASGeometry, referencing the user's buffers
+        AABBs, // Built from a buffer of vk::AabbPositionsKHR for intersection shaders, referencing the user's buffer
     };
 
     struct BLAS
@@ -32,18 +35,34 @@ namespace ava::detail
         uint32_t vertexStride;
         vk::IndexType indexType;
         uint32_t indexCount;
-        uint32_t instanceCount; // indexCount / 3
+        std::vector<ava::BLASGeometry> geometries; // BLASType::Geometries only, buffers are referenced rather than owned
+        ava::Buffer transformBuffer; // Transforms of the geometries that have one, in geometry order
+        ava::Buffer aabbBuffer; // BLASType::AABBs only, referenced rather than owned
+        vk::DeviceSize aabbOffset;
+        uint32_t aabbStride;
+        vk::GeometryFlagsKHR aabbGeometryFlags;
+
+        uint32_t instanceCount; // indexCount / 3, the total primitive count of all geometries or the AABB count
         bool built;
+        vk::BuildAccelerationStructureFlagsKHR buildFlags; // Flags of the last build
+        vk::GeometryFlagsKHR geometryFlags; // Geometry flags of the last build, refits have to match them
+        bool compacted;
     };
 
+    struct TLAS;
+
     struct BLASInstance
     {
-        BLAS* blas;
+        BLAS* blas; // Currently selected LOD
+        BLAS* baseBLAS; // The BLAS it was created with, used closer than the first LOD
+        std::vector<std::pair<BLAS*, float>> lods; // LOD BLASes and the distance they are used from, in increasing distance
+        std::array<float, 4> boundingSphere; // Object space center and radius, radius is negative when there is none
         vk::TransformMatrixKHR transformMatrix;
         vk::GeometryInstanceFlagsKHR geometryInstanceFlags;
         int32_t instanceCustomIndex; // If negative, uses location in passed blasInstances to rebuildTLAS
         uint8_t mask; // Visibility mask
         uint32_t instanceShaderBindingTableRecordOffset; // Offset in calculating the hit shader binding table index
+        std::vector<std::pair<TLAS*, uint32_t>> tlasReferences; // TLASes built with this instance and its index in each
     };
 
     struct TLAS
@@ -53,6 +72,17 @@ namespace ava::detail
         vk::AccelerationStructureBuildSizesInfoKHR lastBuildSizesInfo;
         uint64_t lastBuildHash;
         vk::BuildAccelerationStructureFlagsKHR lastBuildFlags;
+        vk::GeometryFlagsKHR lastGeometryFlags;
+
+        std::vector<BLASInstance*> instances; // Instances by index in the instance buffers, nullptr once destroyed
+        std::vector<uint32_t> instanceCustomIndices;
+        std::vector<uint32_t> instanceDirtyMasks; // Bit per instance buffer that still has to be rewritten
+        std::vector<uint32_t> dirtyInstances; // Indices of instances with a non-zero dirty mask
+        std::vector<ava::Buffer> instanceBuffers; // Persistently mapped, one per frame in flight
+        uint32_t instanceCapacity;
+        ava::Buffer scratchBuffer; // Retained between builds, updates and refits
+        uint64_t blasGeneration; // State.blasGeneration when the instances were last all written
+        ava::TLASCullingStatistics cullingStatistics; // Of the last culled build or update
     };
 
     AccelerationStructure* createAccelerationStructure(vk::AccelerationStructureTypeKHR type, const vk::AccelerationStructureBuildSizesInfoKHR& buildSizeInfo);
@@ -61,23 +91,62 @@ namespace ava::detail
     // Has to assume position is first element and a float3/vec3 (R32G32B32Sfloat)
     BLAS* createBottomLevelAccelerationStructure(ava::VIBO meshBuffer);
     BLAS* createBottomLevelAccelerationStructure(ava::VBO vbo, std::optional<ava::IBO> ibo);
+    // References the geometries' buffers without a copy
+    BLAS* createBottomLevelAccelerationStructure(const std::vector<ava::BLASGeometry>& geometries);
+    // References the AABB buffer without a copy, so the AABBs can be moved and refit
+    BLAS* createBottomLevelAccelerationStructure(ava::Buffer aabbBuffer, uint32_t aabbCount, vk::DeviceSize aabbOffset, uint32_t aabbStride, vk::GeometryFlagsKHR geometryFlags);
     void destroyBottomLevelAccelerationStructure(BLAS*& blas);
 
-    vk::AccelerationStructureGeometryKHR getBLASGeometry(const BLAS* blas, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque);
+    // geometryFlags only applies to BLASes created from a mesh, BLAS geometries and AABBs carry their own flags
+    std::vector<vk::AccelerationStructureGeometryKHR> getBLASGeometries(const BLAS* blas, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque);
+    std::vector<vk::AccelerationStructureBuildRangeInfoKHR> getBLASBuildRangeInfos(const BLAS* blas);
 
-    // Builds one acceleration structure with a single time command and a scratch buffer
+    // Builds one acceleration structure with a single time command and the pooled scratch buffer
     void rebuildBLAS(BLAS* blas, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque);
+    // Only records the build, the scratch and the replaced acceleration structure are tracked by the command buffer
+    void rebuildBLAS(const ava::CommandBuffer& commandBuffer, BLAS* blas, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque);
+
+    constexpr vk::DeviceSize BLAS_BATCH_MAX_SCRATCH_SIZE = ava::BLAS_BATCH_MAX_SCRATCH_SIZE;
+
+    // Builds all BLASes with one shared scratch buffer, builds are split into batches that reuse the scratch when it would exceed maxScratchSize
+    // Recorded into commandBuffer, the scratch and any replaced acceleration structures are tracked by the command buffer
+    void buildBLASes(const ava::CommandBuffer& commandBuffer, const std::vector<BLAS*>& blases, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque, vk::DeviceSize maxScratchSize = BLAS_BATCH_MAX_SCRATCH_SIZE);
+    // Single time command variant, uses the pooled scratch buffer in State
+    void buildBLASes(const std::vector<BLAS*>& blases, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque, vk::DeviceSize maxScratchSize = BLAS_BATCH_MAX_SCRATCH_SIZE);
+
+    // Updates built BLASes in place from their current vertices or AABBs, they must have been built with eAllowUpdate
+    // Uses the build and geometry flags of the last build, the scratch is tracked by the command buffer
+    void refitBLASes(const ava::CommandBuffer& commandBuffer, const std::vector<BLAS*>& blases, vk::DeviceSize maxScratchSize = BLAS_BATCH_MAX_SCRATCH_SIZE);
+    // Single time command variant, uses the pooled scratch buffer in State
+    void refitBLASes(const std::vector<BLAS*>& blases, vk::DeviceSize maxScratchSize = BLAS_BATCH_MAX_SCRATCH_SIZE);
+
+    // Compacts BLASes built with eAllowCompaction into right-sized acceleration structures, batchSize BLASes at a time
+    // BLASes which are not built, were built without eAllowCompaction or are already compacted are skipped
+    ava::BLASCompactionStatistics compactBLASes(const std::vector<BLAS*>& blases, uint32_t batchSize = 64);
 
     BLASInstance* createBLASInstance(BLAS* blas);
     void destroyBLASInstance(BLASInstance*& blasInstance);
+    // Queues the instance to be rewritten into the instance buffers of every TLAS it is in
+    void markBLASInstanceDirty(const BLASInstance* blasInstance);
 
     TLAS* createTopLevelAccelerationStructure();
     void destroyTopLevelAccelerationStructure(TLAS*& tlas);
 
-    // Builds one acceleration structure with a single time command and a scratch buffer
+    // Frustum and distance culls blasInstances and selects their LODs, marking instances whose LOD changed as dirty
+    // Returns the survivors along with their positions in blasInstances, which stand in for negative instanceCustomIndices
+    ava::TLASCullingStatistics cullBLASInstances(const std::vector<BLASInstance*>& blasInstances, const ava::TLASCullingParameters& parameters, std::vector<BLASInstance*>& outInstances, std::vector<uint32_t>& outSourceIndices);
+
+    // Only record the build, replaced acceleration structures and buffers are tracked by the command buffer
+    // sourceIndices replace the instances' positions in blasInstances for negative instanceCustomIndices, such as when culled
+    void rebuildTLAS(const ava::CommandBuffer& commandBuffer, TLAS* tlas, const std::vector<BLASInstance*>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {}, const std::vector<uint32_t>& sourceIndices = {});
+    [[nodiscard]] bool updateTLAS(const ava::CommandBuffer& commandBuffer, TLAS* tlas, const std::vector<BLASInstance*>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {}, const std::vector<uint32_t>& sourceIndices = {});
+
+    // Builds one acceleration structure with a single time command and the TLAS's retained scratch buffer
     void rebuildTLAS(TLAS* tlas, const std::vector<BLASInstance*>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {});
     // Returns false if function could not update the TLAS
     [[nodiscard]] bool updateTLAS(TLAS* tlas, const std::vector<BLASInstance*>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {});
+    // Updates the TLAS in place from its dirty instances, recorded into commandBuffer with the TLAS's retained scratch
+    void refitTLAS(const ava::CommandBuffer& commandBuffer, TLAS* tlas);
 }
 
 #endif
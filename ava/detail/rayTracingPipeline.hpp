@@ -8,14 +8,15 @@ namespace ava::detail
 {
     struct ShaderBindingTable
     {
+        vk::Pipeline pipeline; // Pipeline the group handles came from
         vk::StridedDeviceAddressRegionKHR rayGenRegion;
         vk::StridedDeviceAddressRegionKHR missRegion;
         vk::StridedDeviceAddressRegionKHR hitRegion;
         vk::StridedDeviceAddressRegionKHR callableRegion;
-        uint32_t handleCount;
-        uint32_t missShaderCount;
-        uint32_t hitShaderCount;
-        uint32_t callbackShaderCount;
+        std::array<vk::DeviceSize, 4> regionOffsets; // Byte offset of each region in the buffer, indexed by ShaderBindingTableRegion
+        std::array<uint32_t, 4> recordCounts;
+        std::array<uint32_t, 4> dataSizes; // Inline data bytes available per record
+        uint32_t handleSize;
         ava::Buffer buffer;
     };
 
@@ -29,7 +30,34 @@ namespace ava::detail
 
         std::vector<vk::DescriptorSetLayout> descriptorSetLayouts;
 
-        ShaderBindingTable* shaderBindingTable;
+        std::vector<uint8_t> groupHandles; // Raygen, miss, hit then callable groups
+        uint32_t rayGenGroupCount;
+        uint32_t missGroupCount;
+        uint32_t hitGroupCount;
+        uint32_t callableGroupCount;
+
+        ShaderBindingTable* shaderBindingTable; // Default table of one record per group
+
+        double creationTime; // Milliseconds, the link time when linked from libraries
+        double libraryCreationTime; // Milliseconds the linked libraries took to create, 0 when not linked
+    };
+
+    struct RayTracingPipelineLibrary
+    {
+        vk::Pipeline pipeline;
+        vk::PipelineLayout layout;
+
+        std::vector<std::vector<vk::DescriptorSetLayoutBinding>> layoutBindings;
+        std::vector<vk::PushConstantRange> pushConstants;
+
+        std::vector<vk::DescriptorSetLayout> descriptorSetLayouts;
+
+        std::array<uint32_t, 4> groupCounts; // Raygen, miss, hit then callable groups, in that order within the library
+        uint32_t maxRayRecursionDepth;
+        uint32_t maxRayPayloadSize;
+        uint32_t maxRayHitAttributeSize;
+
+        double creationTime; // Milliseconds
     };
 }
 
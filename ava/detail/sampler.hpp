@@ -9,6 +9,7 @@ namespace ava::detail
     {
         vk::Sampler sampler;
         vk::SamplerCreateInfo createInfo;
+        uint32_t referenceCount = 1; // createSampler returns the same sampler for identical create infos
     };
 }
 
@@ -5,9 +5,24 @@
 #include "detail.hpp"
 #include "state.hpp"
 #include "utility.hpp"
+#include "../compute.hpp"
+#include "../shaders.hpp"
 
 namespace ava::detail
 {
+    // Compiled from ava/shaders/mipmapDownsample.comp by embed_shaders_glslc
+    static const std::vector<uint8_t> MIPMAP_DOWNSAMPLE_SPIRV = {
+#include "mipmapDownsample.comp.spv.inl"
+    };
+    // Compiled from ava/shaders/culling.comp by embed_shaders_glslc
+    static const std::vector<uint8_t> CULLING_SPIRV = {
+#include "culling.comp.spv.inl"
+    };
+    // Compiled from ava/shaders/hiZDownsample.comp by embed_shaders_glslc
+    static const std::vector<uint8_t> HIZ_DOWNSAMPLE_SPIRV = {
+#include "hiZDownsample.comp.spv.inl"
+    };
+
     vk::ShaderModule createShaderModule(const std::vector<char>& spirv)
     {
         AVA_CHECK(State.device, "Cannot create shader module when State's device is invalid")
@@ -29,4 +44,27 @@ namespace ava::detail
 
         return createShaderModule(spirv);
     }
+
+    ComputePipeline* getMipmapDownsamplePipeline()
+    {
+        AVA_CHECK(State.storageImageWithoutFormatEnabled, "Cannot use the built-in mipmap downsample pipeline when the device does not support reading and writing storage images without a format");
+
+        if (State.mipmapDownsamplePipeline == nullptr)
+        {
+            auto shader = createShader(MIPMAP_DOWNSAMPLE_SPIRV, vk::ShaderStageFlagBits::eCompute);
+            State.mipmapDownsamplePipeline = createComputePipeline({shader});
+            destroyShader(shader);
+        }
+        return State.mipmapDownsamplePipeline;
+    }
+
+    Shader* createCullingShader()
+    {
+        return createShader(CULLING_SPIRV, vk::ShaderStageFlagBits::eCompute);
+    }
+
+    Shader* createHiZDownsampleShader()
+    {
+        return createShader(HIZ_DOWNSAMPLE_SPIRV, vk::ShaderStageFlagBits::eCompute);
+    }
 }
@@ -44,6 +44,12 @@ namespace ava::detail
 
     vk::ShaderModule createShaderModule(const std::vector<char>& spirv);
     vk::ShaderModule loadShaderModule(const std::string& filePath, std::vector<char>& spirv);
+
+    // Built-in compute downsampler of generateMipmaps, created on first use and destroyed with State
+    ComputePipeline* getMipmapDownsamplePipeline();
+    // Built-in shaders of createCullingPass, destroyed by the caller once its pipelines are created
+    Shader* createCullingShader();
+    Shader* createHiZDownsampleShader();
 }
 
 #endif
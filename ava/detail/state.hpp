@@ -4,7 +4,10 @@
 #include "./vulkan.hpp"
 #include "../version.hpp"
 #include "../types.hpp"
+#include "../creation.hpp"
+#include "../memoryStatistics.hpp"
 #include <atomic>
+#include <chrono>
 #include <memory>
 
 namespace ava::detail
@@ -37,6 +40,7 @@ namespace ava::detail
 
         std::vector<ava::Image> swapchainAvaImages;
         std::vector<ava::ImageView> swapchainAvaImageViews;
+        std::vector<ava::Image> pendingImageTransitions; // Images created since the last submission, transitioned to their initial layout ahead of it
 
         vk::SurfaceKHR surface; // User's surface - we still destroy it when State is destroyed
 
@@ -68,16 +72,64 @@ namespace ava::detail
         std::vector<vk::Semaphore> renderFinishedSemaphores;
         std::vector<vk::Fence> inFlightGraphicsFences;
 
+        // Frame pacing & timing
+        FramePacing framePacing = FramePacing::eThroughput;
+        bool presentWaitEnabled = false;
+        uint64_t lastPresentId = 0; // Present ids restart with each swapchain
+        uint64_t frameNumber = 0;
+        std::chrono::steady_clock::time_point lastFrameStartTime;
+        double cpuFrameTime = 0.0;
+        double cpuWaitTime = 0.0;
+        double gpuFrameTime = 0.0;
+        vk::QueryPool frameTimestampQueryPool; // Two timestamps per frame in flight
+        double timestampPeriod = 0.0; // Nanoseconds per tick
+        uint64_t timestampMask = 0;
+        std::vector<std::shared_ptr<CommandBuffer>> frameTimestampBeginCommandBuffers;
+        std::vector<std::shared_ptr<CommandBuffer>> frameTimestampEndCommandBuffers;
+        std::vector<bool> frameSubmitted; // Whether the frame slot has been submitted since its timestamps were last read
+
+        // Deferred destruction, retired objects are released once the frame serial they wait for has completed
+        uint64_t submittedFrameSerial = 0;
+        uint64_t completedFrameSerial = 0;
+        std::vector<uint64_t> frameSerials; // Serial of each frame slot's last submission
+        std::vector<std::pair<uint64_t, std::shared_ptr<void>>> retiredObjects;
+
+        // Swapchain maintenance, present fences tell exactly when a retired swapchain's presents are done
+        bool surfaceMaintenanceEnabled = false;
+        bool swapchainMaintenanceEnabled = false;
+        std::vector<vk::Fence> presentFences;
+        std::vector<bool> presentFencePending;
+
         std::atomic<uint32_t> descriptorPoolIndexCounter = 0;
 
         bool lazyGpuMemoryAvailable = false;
         bool shaderDeviceAddressEnabled = false;
+        bool multiDrawIndirectEnabled = false;
+        bool drawIndirectCountEnabled = false;
+        bool hostImageCopyEnabled = false;
+        std::vector<vk::ImageLayout> hostImageCopyDstLayouts; // Layouts images can be in when copied to from the host
+        bool memoryBudgetEnabled = false;
+        bool storageImageWithoutFormatEnabled = false; // Required by the built-in mipmap downsample pipeline
+        ava::ComputePipeline mipmapDownsamplePipeline = nullptr;
+
+        // Memory of live objects, reported by getMemoryStatistics
+        MemoryObjectStatistics bufferMemory{};
+        MemoryObjectStatistics imageMemory{};
+        MemoryObjectStatistics accelerationStructureMemory{};
+        std::vector<ava::DescriptorPool> descriptorPools; // Every live descriptor pool, so descriptors of moved resources can be rewritten
+        uint32_t descriptorPoolCount = 0;
+        uint32_t descriptorCount = 0;
+
+        std::vector<ava::Sampler> samplerCache; // Every live sampler, shared by identical create infos as implementations cap the sampler count
 
         // Ray tracing
         bool rayTracingQueried = false;
-        bool rayTracingEnabled = true;
+        bool rayTracingEnabled = false;
+        bool rayTracingPipelineLibraryEnabled = false;
         vk::PhysicalDeviceAccelerationStructurePropertiesKHR accelerationStructureProperties;
         vk::PhysicalDeviceRayTracingPipelinePropertiesKHR rayTracingPipelineProperties;
+        ava::Buffer accelerationStructureScratchBuffer = nullptr; // Pooled scratch for single time batched BLAS builds
+        uint64_t blasGeneration = 0; // Incremented whenever a BLAS's acceleration structure is replaced
     };
 
     inline State State;
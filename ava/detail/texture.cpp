@@ -0,0 +1,330 @@
+#include "texture.hpp"
+
+#include <vulkan/vulkan_format_traits.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <numeric>
+
+namespace ava::detail
+{
+    vk::Extent3D getMipExtent(const vk::Extent3D extent, const uint32_t mipLevel)
+    {
+        return vk::Extent3D{std::max(extent.width >> mipLevel, 1u), std::max(extent.height >> mipLevel, 1u), std::max(extent.depth >> mipLevel, 1u)};
+    }
+
+    size_t getTextureSubresourceSize(const vk::Format format, const vk::Extent3D extent, const uint32_t mipLevel)
+    {
+        // Block compressed formats are stored as whole blocks, even for mips smaller than a block
+        const auto blockSize = vk::blockSize(format);
+        const auto blockExtent = vk::blockExtent(format);
+        if (blockSize == 0)
+        {
+            return 0;
+        }
+
+        const auto mipExtent = getMipExtent(extent, mipLevel);
+        const size_t blocksX = (mipExtent.width + blockExtent[0] - 1) / blockExtent[0];
+        const size_t blocksY = (mipExtent.height + blockExtent[1] - 1) / blockExtent[1];
+        const size_t blocksZ = (mipExtent.depth + blockExtent[2] - 1) / blockExtent[2];
+        return blocksX * blocksY * blocksZ * blockSize;
+    }
+
+    vk::ImageViewType getTextureImageViewType(const ava::TextureInfo& info)
+    {
+        if (info.cubeMap)
+        {
+            return (info.arrayLayers > 6) ? vk::ImageViewType::eCubeArray : vk::ImageViewType::eCube;
+        }
+        switch (info.imageType)
+        {
+        case vk::ImageType::e1D:
+            return (info.arrayLayers > 1) ? vk::ImageViewType::e1DArray : vk::ImageViewType::e1D;
+        case vk::ImageType::e3D:
+            return vk::ImageViewType::e3D;
+        case vk::ImageType::e2D:
+        default:
+            return (info.arrayLayers > 1) ? vk::ImageViewType::e2DArray : vk::ImageViewType::e2D;
+        }
+    }
+
+    vk::DeviceSize getTextureUploadRegions(const TextureContainer& container, const uint32_t firstMip, const uint32_t mipCount, const uint32_t imageBaseMip, std::vector<vk::BufferImageCopy>& outRegions, std::vector<TextureSubresource>& outSubresources)
+    {
+        const auto& info = container.info;
+        const vk::DeviceSize alignment = std::lcm(static_cast<vk::DeviceSize>(vk::blockSize(info.format)), vk::DeviceSize{4});
+
+        outRegions.clear();
+        outSubresources.clear();
+        vk::DeviceSize stagingSize = 0;
+        for (const auto& subresource : container.subresources)
+        {
+            if (subresource.mipLevel < firstMip || subresource.mipLevel >= firstMip + mipCount)
+            {
+                continue;
+            }
+            stagingSize = (stagingSize + alignment - 1) / alignment * alignment;
+
+            vk::BufferImageCopy region{};
+            region.bufferOffset = stagingSize;
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
+            region.imageSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, subresource.mipLevel - imageBaseMip, subresource.arrayLayer, 1};
+            region.imageOffset = vk::Offset3D{0, 0, 0};
+            region.imageExtent = getMipExtent(info.extent, subresource.mipLevel);
+            outRegions.push_back(region);
+            outSubresources.push_back(subresource);
+
+            stagingSize += subresource.size;
+        }
+        return stagingSize;
+    }
+
+    void copyTextureSubresources(const uint8_t* fileData, const std::vector<TextureSubresource>& subresources, const std::vector<vk::BufferImageCopy>& regions, uint8_t* stagingData)
+    {
+        for (size_t i = 0; i < subresources.size(); i++)
+        {
+            std::memcpy(stagingData + regions[i].bufferOffset, fileData + subresources[i].offset, subresources[i].size);
+        }
+    }
+
+    // Files with more mips than this are malformed, their mip extents would shift by 32 or more
+    static uint32_t getFullMipChainLevels(const vk::Extent3D extent)
+    {
+        return static_cast<uint32_t>(std::bit_width(std::max({extent.width, extent.height, extent.depth})));
+    }
+
+    bool parseKTX2(const uint8_t* data, const size_t size, TextureContainer& outContainer)
+    {
+        KTX2Header header{};
+        if (size < sizeof(KTX2Header) || std::memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0)
+        {
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(KTX2Header));
+
+        // Basis Universal and supercompressed data would have to be transcoded first
+        if (header.vkFormat == 0 || header.supercompressionScheme != 0 || header.pixelWidth == 0 || (header.faceCount != 1 && header.faceCount != 6))
+        {
+            return false;
+        }
+
+        auto& info = outContainer.info;
+        info.format = static_cast<vk::Format>(header.vkFormat);
+        info.extent = vk::Extent3D{header.pixelWidth, std::max(header.pixelHeight, 1u), std::max(header.pixelDepth, 1u)};
+        info.imageType = (header.pixelDepth > 0) ? vk::ImageType::e3D : ((header.pixelHeight > 0) ? vk::ImageType::e2D : vk::ImageType::e1D);
+        info.mipLevels = std::max(header.levelCount, 1u);
+        info.arrayLayers = std::max(header.layerCount, 1u) * header.faceCount;
+        info.cubeMap = header.faceCount == 6;
+
+        if (info.mipLevels > getFullMipChainLevels(info.extent) || sizeof(KTX2Header) + sizeof(KTX2LevelIndex) * info.mipLevels > size)
+        {
+            return false;
+        }
+
+        outContainer.subresources.clear();
+        outContainer.subresources.reserve(static_cast<size_t>(info.mipLevels) * info.arrayLayers);
+        for (uint32_t mip = 0; mip < info.mipLevels; mip++)
+        {
+            KTX2LevelIndex levelIndex{};
+            std::memcpy(&levelIndex, data + sizeof(KTX2Header) + sizeof(KTX2LevelIndex) * mip, sizeof(KTX2LevelIndex));
+
+            const auto layerSize = getTextureSubresourceSize(info.format, info.extent, mip);
+            if (layerSize == 0 || levelIndex.byteLength < layerSize * info.arrayLayers || levelIndex.byteOffset > size || levelIndex.byteLength > size - levelIndex.byteOffset)
+            {
+                return false;
+            }
+
+            for (uint32_t layer = 0; layer < info.arrayLayers; layer++)
+            {
+                outContainer.subresources.push_back(TextureSubresource{mip, layer, static_cast<size_t>(levelIndex.byteOffset) + layerSize * layer, layerSize});
+            }
+        }
+        return true;
+    }
+
+    static vk::Format getDXGIFormat(const uint32_t dxgiFormat)
+    {
+        switch (dxgiFormat)
+        {
+        case 2:
+            return vk::Format::eR32G32B32A32Sfloat;
+        case 10:
+            return vk::Format::eR16G16B16A16Sfloat;
+        case 24:
+            return vk::Format::eA2B10G10R10UnormPack32;
+        case 26:
+            return vk::Format::eB10G11R11UfloatPack32;
+        case 28:
+            return vk::Format::eR8G8B8A8Unorm;
+        case 29:
+            return vk::Format::eR8G8B8A8Srgb;
+        case 34:
+            return vk::Format::eR16G16Sfloat;
+        case 41:
+            return vk::Format::eR32Sfloat;
+        case 49:
+            return vk::Format::eR8G8Unorm;
+        case 54:
+            return vk::Format::eR16Sfloat;
+        case 61:
+            return vk::Format::eR8Unorm;
+        case 71:
+            return vk::Format::eBc1RgbaUnormBlock;
+        case 72:
+            return vk::Format::eBc1RgbaSrgbBlock;
+        case 74:
+            return vk::Format::eBc2UnormBlock;
+        case 75:
+            return vk::Format::eBc2SrgbBlock;
+        case 77:
+            return vk::Format::eBc3UnormBlock;
+        case 78:
+            return vk::Format::eBc3SrgbBlock;
+        case 80:
+            return vk::Format::eBc4UnormBlock;
+        case 81:
+            return vk::Format::eBc4SnormBlock;
+        case 83:
+            return vk::Format::eBc5UnormBlock;
+        case 84:
+            return vk::Format::eBc5SnormBlock;
+        case 87:
+            return vk::Format::eB8G8R8A8Unorm;
+        case 91:
+            return vk::Format::eB8G8R8A8Srgb;
+        case 95:
+            return vk::Format::eBc6HUfloatBlock;
+        case 96:
+            return vk::Format::eBc6HSfloatBlock;
+        case 98:
+            return vk::Format::eBc7UnormBlock;
+        case 99:
+            return vk::Format::eBc7SrgbBlock;
+        default:
+            return vk::Format::eUndefined;
+        }
+    }
+
+    static vk::Format getDDSPixelFormat(const DDSPixelFormat& pixelFormat)
+    {
+        if (pixelFormat.flags & DDS_PIXEL_FORMAT_FOURCC)
+        {
+            switch (pixelFormat.fourCC)
+            {
+            case makeFourCC('D', 'X', 'T', '1'):
+                return vk::Format::eBc1RgbaUnormBlock;
+            case makeFourCC('D', 'X', 'T', '3'):
+                return vk::Format::eBc2UnormBlock;
+            case makeFourCC('D', 'X', 'T', '5'):
+                return vk::Format::eBc3UnormBlock;
+            case makeFourCC('A', 'T', 'I', '1'):
+            case makeFourCC('B', 'C', '4', 'U'):
+                return vk::Format::eBc4UnormBlock;
+            case makeFourCC('B', 'C', '4', 'S'):
+                return vk::Format::eBc4SnormBlock;
+            case makeFourCC('A', 'T', 'I', '2'):
+            case makeFourCC('B', 'C', '5', 'U'):
+                return vk::Format::eBc5UnormBlock;
+            case makeFourCC('B', 'C', '5', 'S'):
+                return vk::Format::eBc5SnormBlock;
+            default:
+                return vk::Format::eUndefined;
+            }
+        }
+
+        // Only uncompressed 32 bit RGBA and BGRA legacy formats are supported
+        if ((pixelFormat.flags & DDS_PIXEL_FORMAT_RGB) && pixelFormat.rgbBitCount == 32 && pixelFormat.gBitMask == 0x0000FF00 && pixelFormat.aBitMask == 0xFF000000)
+        {
+            if (pixelFormat.rBitMask == 0x000000FF && pixelFormat.bBitMask == 0x00FF0000)
+            {
+                return vk::Format::eR8G8B8A8Unorm;
+            }
+            if (pixelFormat.rBitMask == 0x00FF0000 && pixelFormat.bBitMask == 0x000000FF)
+            {
+                return vk::Format::eB8G8R8A8Unorm;
+            }
+        }
+        return vk::Format::eUndefined;
+    }
+
+    bool parseDDS(const uint8_t* data, const size_t size, TextureContainer& outContainer)
+    {
+        uint32_t magic = 0;
+        DDSHeader header{};
+        if (size < sizeof(uint32_t) + sizeof(DDSHeader))
+        {
+            return false;
+        }
+        std::memcpy(&magic, data, sizeof(uint32_t));
+        std::memcpy(&header, data + sizeof(uint32_t), sizeof(DDSHeader));
+        if (magic != DDS_MAGIC || header.size != sizeof(DDSHeader) || header.width == 0)
+        {
+            return false;
+        }
+
+        auto& info = outContainer.info;
+        info.extent = vk::Extent3D{header.width, std::max(header.height, 1u), 1};
+        info.imageType = vk::ImageType::e2D;
+        info.mipLevels = std::max(header.mipMapCount, 1u);
+        info.cubeMap = false;
+        size_t offset = sizeof(uint32_t) + sizeof(DDSHeader);
+        uint32_t layerCount = 1;
+
+        if ((header.pixelFormat.flags & DDS_PIXEL_FORMAT_FOURCC) && header.pixelFormat.fourCC == makeFourCC('D', 'X', '1', '0'))
+        {
+            DDSHeaderDX10 headerDX10{};
+            if (offset + sizeof(DDSHeaderDX10) > size)
+            {
+                return false;
+            }
+            std::memcpy(&headerDX10, data + offset, sizeof(DDSHeaderDX10));
+            offset += sizeof(DDSHeaderDX10);
+
+            info.format = getDXGIFormat(headerDX10.dxgiFormat);
+            layerCount = std::max(headerDX10.arraySize, 1u);
+            info.cubeMap = (headerDX10.miscFlag & DDS_DX10_MISC_TEXTURECUBE) != 0;
+            if (headerDX10.resourceDimension == DDS_DX10_DIMENSION_TEXTURE3D)
+            {
+                info.imageType = vk::ImageType::e3D;
+                info.extent.depth = std::max(header.depth, 1u);
+            }
+        }
+        else
+        {
+            info.format = getDDSPixelFormat(header.pixelFormat);
+            info.cubeMap = (header.caps2 & DDS_CAPS2_CUBEMAP) != 0;
+            if (header.caps2 & DDS_CAPS2_VOLUME)
+            {
+                info.imageType = vk::ImageType::e3D;
+                info.extent.depth = std::max(header.depth, 1u);
+            }
+        }
+
+        if (info.format == vk::Format::eUndefined)
+        {
+            return false;
+        }
+        info.arrayLayers = layerCount * (info.cubeMap ? 6 : 1);
+        if (info.mipLevels > getFullMipChainLevels(info.extent))
+        {
+            return false;
+        }
+
+        outContainer.subresources.clear();
+        outContainer.subresources.reserve(static_cast<size_t>(info.mipLevels) * info.arrayLayers);
+        for (uint32_t layer = 0; layer < info.arrayLayers; layer++)
+        {
+            for (uint32_t mip = 0; mip < info.mipLevels; mip++)
+            {
+                const auto subresourceSize = getTextureSubresourceSize(info.format, info.extent, mip);
+                if (subresourceSize == 0 || subresourceSize > size - offset)
+                {
+                    return false;
+                }
+                outContainer.subresources.push_back(TextureSubresource{mip, layer, offset, subresourceSize});
+                offset += subresourceSize;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef AVA_DETAIL_TEXTURE_HPP
+#define AVA_DETAIL_TEXTURE_HPP
+
+#include "./vulkan.hpp"
+#include "../texture.hpp"
+
+namespace ava::detail
+{
+    constexpr uint32_t makeFourCC(const char a, const char b, const char c, const char d)
+    {
+        return static_cast<uint32_t>(a) | (static_cast<uint32_t>(b) << 8) | (static_cast<uint32_t>(c) << 16) | (static_cast<uint32_t>(d) << 24);
+    }
+
+    constexpr uint8_t KTX2_IDENTIFIER[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A}; // "«KTX 20»\r\n\x1A\n"
+
+    struct KTX2Header
+    {
+        uint8_t identifier[12];
+        uint32_t vkFormat; // 0 when the data is Basis Universal
+        uint32_t typeSize;
+        uint32_t pixelWidth;
+        uint32_t pixelHeight; // 0 for 1D textures
+        uint32_t pixelDepth; // 0 for 1D and 2D textures
+        uint32_t layerCount; // 0 when not an array
+        uint32_t faceCount; // 6 for cube maps
+        uint32_t levelCount; // 0 when the mips are meant to be generated
+        uint32_t supercompressionScheme;
+        uint32_t dfdByteOffset;
+        uint32_t dfdByteLength;
+        uint32_t kvdByteOffset;
+        uint32_t kvdByteLength;
+        uint64_t sgdByteOffset;
+        uint64_t sgdByteLength;
+    };
+    static_assert(sizeof(KTX2Header) == 80);
+
+    // Follows the header, one per level starting with mip 0. Each level holds every layer, then face, then depth slice
+    struct KTX2LevelIndex
+    {
+        uint64_t byteOffset;
+        uint64_t byteLength;
+        uint64_t uncompressedByteLength;
+    };
+
+    constexpr uint32_t DDS_MAGIC = makeFourCC('D', 'D', 'S', ' ');
+    constexpr uint32_t DDS_PIXEL_FORMAT_FOURCC = 0x4;
+    constexpr uint32_t DDS_PIXEL_FORMAT_RGB = 0x40;
+    constexpr uint32_t DDS_CAPS2_CUBEMAP = 0x200;
+    constexpr uint32_t DDS_CAPS2_VOLUME = 0x200000;
+    constexpr uint32_t DDS_DX10_MISC_TEXTURECUBE = 0x4;
+    constexpr uint32_t DDS_DX10_DIMENSION_TEXTURE3D = 4;
+
+    struct DDSPixelFormat
+    {
+        uint32_t size;
+        uint32_t flags;
+        uint32_t fourCC;
+        uint32_t rgbBitCount;
+        uint32_t rBitMask;
+        uint32_t gBitMask;
+        uint32_t bBitMask;
+        uint32_t aBitMask;
+    };
+
+    // Follows the magic. Data is every mip of the first layer, then every mip of the next
+    struct DDSHeader
+    {
+        uint32_t size;
+        uint32_t flags;
+        uint32_t height;
+        uint32_t width;
+        uint32_t pitchOrLinearSize;
+        uint32_t depth;
+        uint32_t mipMapCount;
+        uint32_t reserved1[11];
+        DDSPixelFormat pixelFormat;
+        uint32_t caps;
+        uint32_t caps2;
+        uint32_t caps3;
+        uint32_t caps4;
+        uint32_t reserved2;
+    };
+    static_assert(sizeof(DDSHeader) == 124);
+
+    // Follows DDSHeader when the pixel format's fourCC is "DX10"
+    struct DDSHeaderDX10
+    {
+        uint32_t dxgiFormat;
+        uint32_t resourceDimension;
+        uint32_t miscFlag;
+        uint32_t arraySize; // Number of cubes for cube maps
+        uint32_t miscFlags2;
+    };
+
+    // Where one mip level of one array layer lives in the file
+    struct TextureSubresource
+    {
+        uint32_t mipLevel;
+        uint32_t arrayLayer;
+        size_t offset;
+        size_t size;
+    };
+
+    struct TextureContainer
+    {
+        ava::TextureInfo info;
+        std::vector<TextureSubresource> subresources;
+    };
+
+    // Return false when data is not a container of that type or holds data which cannot be uploaded as is
+    bool parseKTX2(const uint8_t* data, size_t size, TextureContainer& outContainer);
+    bool parseDDS(const uint8_t* data, size_t size, TextureContainer& outContainer);
+
+    // Bytes of one array layer of mipLevel, 0 when the format is unknown
+    size_t getTextureSubresourceSize(vk::Format format, vk::Extent3D extent, uint32_t mipLevel);
+    vk::Extent3D getMipExtent(vk::Extent3D extent, uint32_t mipLevel);
+    vk::ImageViewType getTextureImageViewType(const ava::TextureInfo& info);
+
+    // Staging layout of every layer of mips [firstMip, firstMip + mipCount), with regions copying them into an image whose mip 0 is imageBaseMip
+    // Offsets are aligned to both the texel block size and 4 bytes, as copies require. Returns the staging size
+    vk::DeviceSize getTextureUploadRegions(const TextureContainer& container, uint32_t firstMip, uint32_t mipCount, uint32_t imageBaseMip, std::vector<vk::BufferImageCopy>& outRegions, std::vector<TextureSubresource>& outSubresources);
+    // Copies each subresource from the file's data to its region's offset in the staging data
+    void copyTextureSubresources(const uint8_t* fileData, const std::vector<TextureSubresource>& subresources, const std::vector<vk::BufferImageCopy>& regions, uint8_t* stagingData);
+}
+
+#endif
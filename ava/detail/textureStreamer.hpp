@@ -0,0 +1,76 @@
+#ifndef AVA_DETAIL_TEXTURESTREAMER_HPP
+#define AVA_DETAIL_TEXTURESTREAMER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "./vulkan.hpp"
+#include "../types.hpp"
+#include "texture.hpp"
+
+namespace ava::detail
+{
+    constexpr uint32_t STREAMED_TEXTURE_NO_REQUEST = ~0u;
+
+    // Holds copies of everything the I/O thread reads, so a texture can be removed while its load is in flight
+    struct StreamingLoad
+    {
+        StreamedTexture* texture; // Only used on the main thread, nullptr once cancelled
+        std::string fileName;
+        uint32_t firstMip; // Loads mips [firstMip, the texture's resident mip)
+        vk::DeviceSize extraSize; // Growth of the texture's resident size once applied
+        std::vector<TextureSubresource> subresources;
+        std::vector<vk::BufferImageCopy> regions;
+        ava::Buffer stagingBuffer;
+        bool failed = false;
+        bool cancelled = false; // Guarded by the streamer's mutex
+    };
+
+    struct StreamedTexture
+    {
+        TextureStreamer* streamer;
+        std::string fileName;
+        TextureContainer container;
+        vk::ImageUsageFlags usageFlags;
+
+        ava::Image image;
+        ava::ImageView imageView;
+        uint32_t residentMip; // Finest resident mip, mip 0 of image
+        uint32_t tailMip; // Coarsest residency, never lowered past
+        vk::DeviceSize residentSize; // Of image's allocation
+        std::vector<vk::DeviceSize> mipMemorySizes; // Image memory needed to hold mips [firstMip, mipLevels), by firstMip
+
+        uint32_t requestedMip; // Finest mip requested since the last update
+        uint64_t lastRequestedUpdate;
+        std::shared_ptr<StreamingLoad> pendingLoad;
+    };
+
+    struct TextureStreamer
+    {
+        vk::DeviceSize memoryBudget;
+        uint32_t tailMaxExtent;
+        uint32_t maxPendingLoads;
+        uint32_t evictionDelay;
+
+        std::vector<StreamedTexture*> textures;
+        std::vector<std::pair<ava::Image, ava::ImageView>> retiredImages; // Of removed textures, destroyed once the next update's command buffer completes
+        vk::DeviceSize residentSize;
+        vk::DeviceSize pendingSize;
+        uint32_t pendingLoadCount;
+        uint64_t updateIndex;
+        uint32_t loadsCompleted; // During the last update
+        uint32_t texturesLowered;
+
+        // Loads move from queuedLoads to completedLoads on the I/O thread
+        std::thread ioThread;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<std::shared_ptr<StreamingLoad>> queuedLoads;
+        std::vector<std::shared_ptr<StreamingLoad>> completedLoads;
+        bool stopping;
+    };
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef AVA_DETAIL_TRANSIENTIMAGESET_HPP
+#define AVA_DETAIL_TRANSIENTIMAGESET_HPP
+
+#include "./vulkan.hpp"
+#include "../transientImageSet.hpp"
+
+namespace ava::detail
+{
+    struct Image;
+
+    struct TransientImage
+    {
+        Image* image;
+        uint32_t firstPass;
+        uint32_t lastPass;
+        uint32_t block;
+        vk::DeviceSize offset; // Within its block
+        vk::DeviceSize size;
+    };
+
+    struct TransientImageSet
+    {
+        std::vector<vma::Allocation> blocks;
+        std::vector<TransientImage> images;
+        vk::DeviceSize blockBytes;
+        vk::DeviceSize imageBytes;
+    };
+}
+
+#endif
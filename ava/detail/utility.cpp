@@ -2,6 +2,19 @@
 
 #include <stdexcept>
 #include <fstream>
+#include <cmath>
+#include <cstdint>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace ava::detail
 {
@@ -23,4 +36,114 @@ namespace ava::detail
 
         return buffer;
     }
+
+    bool mapFile(const std::string& fileName, MappedFile& outMappedFile)
+    {
+        outMappedFile = MappedFile{};
+#ifdef _WIN32
+        const HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        const auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        outMappedFile.data = static_cast<const uint8_t*>(data);
+        outMappedFile.size = static_cast<size_t>(fileSize.QuadPart);
+        outMappedFile.fileHandle = file;
+        outMappedFile.mappingHandle = mapping;
+#else
+        const int file = open(fileName.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            return false;
+        }
+
+        struct stat fileStat{};
+        if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            close(file);
+            return false;
+        }
+
+        // The mapping stays valid once the descriptor is closed
+        const auto data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+
+        outMappedFile.data = static_cast<const uint8_t*>(data);
+        outMappedFile.size = static_cast<size_t>(fileStat.st_size);
+#endif
+        return true;
+    }
+
+    void unmapFile(MappedFile& mappedFile)
+    {
+        if (mappedFile.data == nullptr)
+        {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(mappedFile.data);
+        CloseHandle(mappedFile.mappingHandle);
+        CloseHandle(mappedFile.fileHandle);
+#else
+        munmap(const_cast<uint8_t*>(mappedFile.data), mappedFile.size);
+#endif
+        mappedFile = MappedFile{};
+    }
+
+    void extractFrustumPlanes(const float matrix[16], float planes[6][4])
+    {
+        // Matrix is column-major, so row r column c is matrix[c * 4 + r]
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            const float row0 = matrix[c * 4 + 0];
+            const float row1 = matrix[c * 4 + 1];
+            const float row2 = matrix[c * 4 + 2];
+            const float row3 = matrix[c * 4 + 3];
+            planes[0][c] = row3 + row0; // Left
+            planes[1][c] = row3 - row0; // Right
+            planes[2][c] = row3 + row1; // Bottom
+            planes[3][c] = row3 - row1; // Top
+            planes[4][c] = row2; // Near
+            planes[5][c] = row3 - row2; // Far
+        }
+
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            const float length = std::sqrt(planes[i][0] * planes[i][0] + planes[i][1] * planes[i][1] + planes[i][2] * planes[i][2]);
+            if (length > 0.0f)
+            {
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    planes[i][c] /= length;
+                }
+            }
+        }
+    }
 }
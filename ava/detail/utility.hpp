@@ -4,11 +4,30 @@
 #include <string>
 #include <vector>
 #include <cassert>
+#include <cstdint>
 
 namespace ava::detail
 {
     std::vector<char> readFile(const std::string& fileName);
 
+    // Read only view of a whole file mapped into memory
+    struct MappedFile
+    {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+
+    // Returns false when the file cannot be opened, is empty or cannot be mapped
+    bool mapFile(const std::string& fileName, MappedFile& outMappedFile);
+    void unmapFile(MappedFile& mappedFile);
+
+    // Normalised left, right, bottom, top, near then far planes (xyz normal, w distance) of a column-major view projection with a [0, 1] depth range
+    void extractFrustumPlanes(const float matrix[16], float planes[6][4]);
+
     template <typename T>
     bool isPowerOf2(T x)
     {
@@ -1,15 +1,122 @@
 #include "frame.hpp"
 
+#include "commandBuffer.hpp"
 #include "creation.hpp"
 #include "detail/commandBuffer.hpp"
 #include "detail/detail.hpp"
+#include "detail/frame.hpp"
+#include "detail/image.hpp"
 #include "detail/state.hpp"
+#include <algorithm>
 
 namespace ava
 {
+    namespace detail
+    {
+        void retireObject(const std::shared_ptr<void>& object, const uint64_t extraFrames)
+        {
+            // A started frame may already reference the object, so it also has to complete
+            const uint64_t serial = State.submittedFrameSerial + (State.frameStarted ? 1 : 0) + extraFrames;
+            State.retiredObjects.emplace_back(serial, object);
+        }
+
+        void releaseRetiredObjects(const bool all)
+        {
+            if (all)
+            {
+                State.completedFrameSerial = State.submittedFrameSerial;
+                State.retiredObjects.clear();
+                return;
+            }
+
+            std::erase_if(State.retiredObjects, [](const auto& retiredObject)
+            {
+                return retiredObject.first <= State.completedFrameSerial;
+            });
+        }
+
+        void waitForSubmittedFrames()
+        {
+            // The started frame's fence has been reset and is only signalled once it is submitted
+            std::vector<vk::Fence> frameFences;
+            for (uint32_t frame = 0; frame < State.frameSerials.size(); frame++)
+            {
+                if (State.frameSerials[frame] > State.completedFrameSerial && !(State.frameStarted && frame == State.currentFrame))
+                {
+                    frameFences.push_back(State.inFlightGraphicsFences[frame]);
+                }
+            }
+
+            if (!frameFences.empty())
+            {
+                vk::detail::resultCheck(State.device.waitForFences(frameFences, true, std::numeric_limits<uint64_t>::max()), "Failed while waiting for submitted frame fences");
+            }
+            State.completedFrameSerial = State.submittedFrameSerial;
+        }
+    }
+
     using namespace detail;
 
-    std::optional<ava::CommandBuffer> startFrame(uint32_t* currentFrame, uint32_t* imageIndex)
+    // Present wait is best effort pacing, don't stall forever on a swapchain that isn't presenting (e.g. a minimized window)
+    constexpr uint64_t PRESENT_WAIT_TIMEOUT = 100'000'000; // 100ms
+
+    static double millisecondsBetween(const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end)
+    {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    // Returns false when the frame should not be started yet
+    static bool waitForFramePacing(const bool blocking)
+    {
+        if (State.framePacing != FramePacing::eLowLatency)
+        {
+            return true;
+        }
+
+        if (State.presentWaitEnabled && State.lastPresentId > 0)
+        {
+            try
+            {
+                const auto result = State.device.waitForPresentKHR(State.swapchain, State.lastPresentId, blocking ? PRESENT_WAIT_TIMEOUT : 0, State.dispatchLoader);
+                return blocking || result != vk::Result::eTimeout;
+            }
+            catch (const vk::OutOfDateKHRError&)
+            {
+                State.resizeNeeded = true;
+                return false;
+            }
+        }
+
+        // Without present wait, wait for the previous frame to finish on the GPU
+        const auto previousFrame = (State.currentFrame + State.framesInFlight - 1) % State.framesInFlight;
+        const auto result = State.device.waitForFences(State.inFlightGraphicsFences[previousFrame], true, blocking ? std::numeric_limits<uint64_t>::max() : 0);
+        if (result == vk::Result::eTimeout)
+        {
+            return false;
+        }
+        vk::detail::resultCheck(result, "Failed while waiting for previous frame fence");
+        return true;
+    }
+
+    // The frame slot's fence has been waited on, so its timestamps from its last submission are available
+    static void readFrameTimestamps()
+    {
+        if (!State.frameTimestampQueryPool || !State.frameSubmitted[State.currentFrame])
+        {
+            return;
+        }
+        State.frameSubmitted[State.currentFrame] = false;
+
+        uint64_t timestamps[2]{};
+        const auto result = State.device.getQueryPoolResults(State.frameTimestampQueryPool, State.currentFrame * 2, 2, sizeof(timestamps), timestamps, sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+        if (result == vk::Result::eSuccess)
+        {
+            const auto ticks = (timestamps[1] - timestamps[0]) & State.timestampMask;
+            State.gpuFrameTime = static_cast<double>(ticks) * State.timestampPeriod / 1'000'000.0;
+        }
+    }
+
+    static std::optional<ava::CommandBuffer> startFrameMain(uint32_t* currentFrame, uint32_t* imageIndex, const bool blocking)
     {
         if (currentFrame != nullptr)
         {
@@ -26,15 +133,43 @@ namespace ava
         AVA_CHECK(State.inFlightGraphicsFences.size() >= State.currentFrame, "In flight graphics fence was not properly initialized");
         AVA_CHECK(State.imageAvailableSemaphores.size() >= State.currentFrame, "Image available semaphores was not properly initialized");
         AVA_CHECK(State.renderFinishedSemaphores.size() >= State.currentFrame, "Render finished semaphores was not properly initialized");
-        vk::detail::resultCheck(State.device.waitForFences(State.inFlightGraphicsFences[State.currentFrame], true, std::numeric_limits<uint64_t>::max()), "Failed while waiting for previous frame fence");
 
-        auto nextImageResult = State.device.acquireNextImageKHR(State.swapchain, std::numeric_limits<uint64_t>::max(), State.imageAvailableSemaphores[State.currentFrame], nullptr, &State.imageIndex);
+        const auto waitStartTime = std::chrono::steady_clock::now();
+        const uint64_t timeout = blocking ? std::numeric_limits<uint64_t>::max() : 0;
+
+        if (!waitForFramePacing(blocking))
+        {
+            return {};
+        }
+
+        // Wait for the frame slot's last submission, and its present when present fences are available
+        std::vector<vk::Fence> frameFences{State.inFlightGraphicsFences[State.currentFrame]};
+        if (State.swapchainMaintenanceEnabled && State.presentFencePending[State.currentFrame])
+        {
+            frameFences.push_back(State.presentFences[State.currentFrame]);
+        }
+        const auto fenceResult = State.device.waitForFences(frameFences, true, timeout);
+        if (fenceResult == vk::Result::eTimeout)
+        {
+            return {};
+        }
+        vk::detail::resultCheck(fenceResult, "Failed while waiting for previous frame fence");
+
+        State.completedFrameSerial = std::max(State.completedFrameSerial, State.frameSerials[State.currentFrame]);
+        releaseRetiredObjects();
+        readFrameTimestamps();
+
+        auto nextImageResult = State.device.acquireNextImageKHR(State.swapchain, timeout, State.imageAvailableSemaphores[State.currentFrame], nullptr, &State.imageIndex);
         if (nextImageResult == vk::Result::eErrorOutOfDateKHR)
         {
             State.resizeNeeded = true;
             State.frameStarted = false;
             return {};
         }
+        if (nextImageResult == vk::Result::eNotReady || nextImageResult == vk::Result::eTimeout)
+        {
+            return {};
+        }
         if (nextImageResult != vk::Result::eSuccess && nextImageResult != vk::Result::eSuboptimalKHR)
         {
             throw std::runtime_error("Failed to acquire swapchain image");
@@ -57,11 +192,33 @@ namespace ava
             *imageIndex = State.imageIndex;
         }
 
+        // Frame timing
+        const auto frameStartTime = std::chrono::steady_clock::now();
+        State.cpuWaitTime = millisecondsBetween(waitStartTime, frameStartTime);
+        if (State.frameNumber > 0)
+        {
+            State.cpuFrameTime = millisecondsBetween(State.lastFrameStartTime, frameStartTime);
+        }
+        State.lastFrameStartTime = frameStartTime;
+        State.frameNumber++;
+        // Lets VMA fetch the heap budgets once per frame
+        State.allocator.setCurrentFrameIndex(static_cast<uint32_t>(State.frameNumber));
+
         State.frameStarted = true;
 
         return {commandBuffer};
     }
 
+    std::optional<ava::CommandBuffer> startFrame(uint32_t* currentFrame, uint32_t* imageIndex)
+    {
+        return startFrameMain(currentFrame, imageIndex, true);
+    }
+
+    std::optional<ava::CommandBuffer> tryStartFrame(uint32_t* currentFrame, uint32_t* imageIndex)
+    {
+        return startFrameMain(currentFrame, imageIndex, false);
+    }
+
     void presentFrame()
     {
         AVA_CHECK(State.frameStarted, "Frame not started, start one before presenting the frame");
@@ -80,10 +237,34 @@ namespace ava
         submitInfo.setWaitSemaphores(waitSemaphores);
         submitInfo.pWaitDstStageMask = waitStages;
         submitInfo.setSignalSemaphores(signalSemaphores);
-        submitInfo.setCommandBuffers(commandBuffer->commandBuffer);
+
+        // Surround the frame with its timestamp command buffers when frame timestamps are enabled
+        std::vector<vk::CommandBuffer> submitCommandBuffers;
+        if (State.frameTimestampQueryPool)
+        {
+            submitCommandBuffers = {State.frameTimestampBeginCommandBuffers[State.currentFrame]->commandBuffer, commandBuffer->commandBuffer, State.frameTimestampEndCommandBuffers[State.currentFrame]->commandBuffer};
+            State.frameSubmitted[State.currentFrame] = true;
+        }
+        else
+        {
+            submitCommandBuffers = {commandBuffer->commandBuffer};
+        }
+
+        // Images created since the last submission are transitioned to their initial layout first, freed once the frame's command buffer is reused
+        const auto imageTransitionCommandBuffer = recordPendingImageTransitions();
+        if (imageTransitionCommandBuffer != nullptr)
+        {
+            submitCommandBuffers.insert(submitCommandBuffers.begin(), imageTransitionCommandBuffer->commandBuffer);
+            trackObject(commandBuffer, std::shared_ptr<void>(nullptr, [imageTransitionCommandBuffer](void*)
+            {
+                freePendingImageTransitions(imageTransitionCommandBuffer);
+            }));
+        }
+        submitInfo.setCommandBuffers(submitCommandBuffers);
 
         // Submit to the graphics queue
         State.graphicsQueue.submit(submitInfo, State.inFlightGraphicsFences[State.currentFrame]);
+        State.frameSerials[State.currentFrame] = ++State.submittedFrameSerial;
 
         // Present
         vk::PresentInfoKHR presentInfo;
@@ -91,6 +272,28 @@ namespace ava
         presentInfo.setSwapchains(State.swapchain);
         presentInfo.setImageIndices(State.imageIndex);
 
+        // Tag the present so frame pacing can wait for it
+        const uint64_t nextPresentId = State.lastPresentId + 1;
+        vk::PresentIdKHR presentId;
+        if (State.presentWaitEnabled)
+        {
+            presentId.setPresentIds(nextPresentId);
+            presentInfo.pNext = &presentId;
+        }
+
+        // Signal the frame slot's present fence so retired swapchains can be released as soon as their presents are done
+        vk::SwapchainPresentFenceInfoEXT presentFenceInfo;
+        if (State.swapchainMaintenanceEnabled)
+        {
+            if (State.presentFencePending[State.currentFrame])
+            {
+                State.device.resetFences(State.presentFences[State.currentFrame]);
+            }
+            presentFenceInfo.setFences(State.presentFences[State.currentFrame]);
+            presentFenceInfo.pNext = presentInfo.pNext;
+            presentInfo.pNext = &presentFenceInfo;
+        }
+
         const vk::Result presentResult = State.presentQueue.presentKHR(&presentInfo);
         if (presentResult == vk::Result::eErrorOutOfDateKHR || presentResult == vk::Result::eSuboptimalKHR)
         {
@@ -101,12 +304,51 @@ namespace ava
             throw std::runtime_error("Failed to present frame!");
         }
 
+        if (State.presentWaitEnabled && presentResult != vk::Result::eErrorOutOfDateKHR)
+        {
+            State.lastPresentId = nextPresentId;
+        }
+        if (State.swapchainMaintenanceEnabled)
+        {
+            State.presentFencePending[State.currentFrame] = true; // Still signaled when the present is rejected as out of date
+        }
+
         // Change current frame
         State.currentFrame = (State.currentFrame + 1) % State.framesInFlight;
     }
 
+    void retireObject(const std::shared_ptr<void>& object)
+    {
+        detail::retireObject(object);
+    }
+
     bool resizeNeeded()
     {
         return State.resizeNeeded;
     }
+
+    void setFramePacing(const FramePacing framePacing)
+    {
+        State.framePacing = framePacing;
+    }
+
+    FramePacing getFramePacing()
+    {
+        return State.framePacing;
+    }
+
+    bool presentWaitEnabled()
+    {
+        return State.presentWaitEnabled;
+    }
+
+    FrameTimings getFrameTimings()
+    {
+        FrameTimings timings{};
+        timings.cpuFrameTime = State.cpuFrameTime;
+        timings.cpuWaitTime = State.cpuWaitTime;
+        timings.gpuFrameTime = State.gpuFrameTime;
+        timings.frameNumber = State.frameNumber;
+        return timings;
+    }
 }
@@ -4,19 +4,41 @@
 #include <cstdint>
 
 #include "commandBuffer.hpp"
+#include "creation.hpp"
 #include "detail/vulkan.hpp"
 
 namespace ava
 {
+    struct FrameTimings
+    {
+        double cpuFrameTime; // Milliseconds between the last two started frames
+        double cpuWaitTime; // Milliseconds the last started frame spent waiting on frame pacing, its fence and image acquisition
+        double gpuFrameTime; // Milliseconds the GPU spent on the last completed submission of the current frame slot, 0 when frame timestamps are unavailable
+        uint64_t frameNumber; // Number of frames started since the state was created
+    };
+
     // Returns an un-started & un-reset graphics command buffer when the operation was successful, otherwise it will have no value
     // currentFrame and imageIndex are optional outs
     [[nodiscard]] std::optional<CommandBuffer> startFrame(uint32_t* currentFrame = nullptr, uint32_t* imageIndex = nullptr);
+    // Same as startFrame but never blocks, has no value when the frame slot, frame pacing or a swapchain image is not ready yet
+    // Check resizeNeeded to tell a resize apart from the frame not being ready
+    [[nodiscard]] std::optional<CommandBuffer> tryStartFrame(uint32_t* currentFrame = nullptr, uint32_t* imageIndex = nullptr);
 
     // Presents the frame using the current frame's graphics command buffer
     void presentFrame();
 
+    // Keeps object alive until every frame submitted so far, including a started frame, has completed on the GPU
+    // Use to replace objects still referenced by frames in flight (e.g. swapchain framebuffers on resize) without waiting for the device to idle
+    void retireObject(const std::shared_ptr<void>& object);
+
     // Returns if a swapchain resize is required. Check before starting and after presenting a frame. Recreate any swapchain-sized images if true
     bool resizeNeeded();
+
+    void setFramePacing(FramePacing framePacing);
+    FramePacing getFramePacing();
+    // Whether VK_KHR_present_wait is used for FramePacing::eLowLatency, otherwise the previous frame's fence is waited on
+    bool presentWaitEnabled();
+    FrameTimings getFrameTimings();
 }
 
 #endif
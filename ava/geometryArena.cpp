@@ -0,0 +1,373 @@
+#include "geometryArena.hpp"
+#include "detail/geometryArena.hpp"
+
+#include "buffer.hpp"
+#include "commandBuffer.hpp"
+#include "detail/buffer.hpp"
+#include "detail/commandBuffer.hpp"
+#include "detail/detail.hpp"
+#include "detail/frame.hpp"
+#include "detail/state.hpp"
+#include "detail/vao.hpp"
+#include <algorithm>
+
+namespace ava
+{
+    namespace detail
+    {
+        void initArenaRanges(ArenaRangeAllocator& allocator, const uint32_t capacity)
+        {
+            allocator.capacity = capacity;
+            allocator.used = 0;
+            allocator.freeRanges.clear();
+            if (capacity > 0)
+            {
+                allocator.freeRanges[0] = capacity;
+            }
+        }
+
+        std::optional<uint32_t> allocateArenaRange(ArenaRangeAllocator& allocator, const uint32_t count)
+        {
+            for (auto it = allocator.freeRanges.begin(); it != allocator.freeRanges.end(); ++it)
+            {
+                if (it->second < count)
+                {
+                    continue;
+                }
+
+                const auto offset = it->first;
+                const auto remaining = it->second - count;
+                allocator.freeRanges.erase(it);
+                if (remaining > 0)
+                {
+                    allocator.freeRanges[offset + count] = remaining;
+                }
+                allocator.used += count;
+                return offset;
+            }
+            return {};
+        }
+
+        void freeArenaRange(ArenaRangeAllocator& allocator, const uint32_t offset, uint32_t count)
+        {
+            allocator.used -= count;
+
+            // Coalesce with the following free range
+            auto next = allocator.freeRanges.lower_bound(offset);
+            if (next != allocator.freeRanges.end() && offset + count == next->first)
+            {
+                count += next->second;
+                next = allocator.freeRanges.erase(next);
+            }
+
+            // Coalesce with the preceding free range
+            if (next != allocator.freeRanges.begin())
+            {
+                const auto previous = std::prev(next);
+                if (previous->first + previous->second == offset)
+                {
+                    previous->second += count;
+                    return;
+                }
+            }
+
+            allocator.freeRanges[offset] = count;
+        }
+
+        void growArenaRanges(ArenaRangeAllocator& allocator, const uint32_t newCapacity)
+        {
+            const auto oldCapacity = allocator.capacity;
+            const auto added = newCapacity - oldCapacity;
+            allocator.capacity = newCapacity;
+            allocator.used += added; // Balanced by freeing the new range
+            freeArenaRange(allocator, oldCapacity, added);
+        }
+    }
+
+    static Buffer createArenaVertexBuffer(const GeometryArena& arena, const uint32_t capacity)
+    {
+        return createBuffer(static_cast<vk::DeviceSize>(capacity) * arena->stride, DEFAULT_VERTEX_BUFFER_USAGE | arena->extraBufferUsage);
+    }
+
+    static Buffer createArenaIndexBuffer(const GeometryArena& arena, const uint32_t capacity)
+    {
+        return createBuffer(static_cast<vk::DeviceSize>(capacity) * arena->indexSize, DEFAULT_INDEX_BUFFER_USAGE | arena->extraBufferUsage);
+    }
+
+    // Frames in flight and the frame being recorded may still be reading the old buffer, so it is destroyed once they have completed
+    static void retireArenaBuffer(Buffer buffer)
+    {
+        detail::retireObject(std::shared_ptr<void>(nullptr, [buffer](void*) mutable
+        {
+            destroyBuffer(buffer);
+        }));
+    }
+
+    // Replaces buffer with a larger copy of itself
+    static void growArenaBuffer(const GeometryArena& arena, Buffer& buffer, detail::ArenaRangeAllocator& ranges, const uint32_t elementSize, const uint32_t required, const bool isIndexBuffer)
+    {
+        const uint32_t newCapacity = std::max(ranges.capacity * 2, ranges.capacity + required);
+        auto newBuffer = isIndexBuffer ? createArenaIndexBuffer(arena, newCapacity) : createArenaVertexBuffer(arena, newCapacity);
+
+        const auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eTransfer);
+        commandBuffer->commandBuffer.copyBuffer(buffer->buffer, newBuffer->buffer, vk::BufferCopy{0, 0, static_cast<vk::DeviceSize>(ranges.capacity) * elementSize});
+        endSingleTimeCommands(commandBuffer);
+
+        retireArenaBuffer(buffer);
+        buffer = newBuffer;
+        detail::growArenaRanges(ranges, newCapacity);
+    }
+
+    GeometryArena createGeometryArena(const GeometryArenaCreationInfo& creationInfo)
+    {
+        AVA_CHECK(detail::State.device, "Cannot create a geometry arena when State's device is invalid");
+        AVA_CHECK(creationInfo.vao != nullptr && !creationInfo.vao->strides.empty(), "Cannot create a geometry arena from an invalid VAO");
+        AVA_CHECK(creationInfo.binding < creationInfo.vao->strides.size(), "Cannot create a geometry arena when binding is out of range of VAO bindings");
+        AVA_CHECK(creationInfo.indexType == vk::IndexType::eUint32 || creationInfo.indexType == vk::IndexType::eUint16, "Cannot create a geometry arena with an index type other than eUint32 or eUint16");
+        AVA_CHECK(creationInfo.initialVertexCapacity > 0 && creationInfo.initialIndexCapacity > 0, "Cannot create a geometry arena with an initial capacity of 0");
+
+        const auto outArena = new detail::GeometryArena();
+        outArena->stride = creationInfo.vao->strides.at(creationInfo.binding);
+        outArena->binding = creationInfo.binding;
+        outArena->topology = creationInfo.vao->topology;
+        outArena->indexType = creationInfo.indexType;
+        outArena->indexSize = creationInfo.indexType == vk::IndexType::eUint32 ? sizeof(uint32_t) : sizeof(uint16_t);
+        outArena->extraBufferUsage = creationInfo.extraBufferUsage;
+        outArena->vertexBuffer = createArenaVertexBuffer(outArena, creationInfo.initialVertexCapacity);
+        outArena->indexBuffer = createArenaIndexBuffer(outArena, creationInfo.initialIndexCapacity);
+        detail::initArenaRanges(outArena->vertexRanges, creationInfo.initialVertexCapacity);
+        detail::initArenaRanges(outArena->indexRanges, creationInfo.initialIndexCapacity);
+        return outArena;
+    }
+
+    void destroyGeometryArena(GeometryArena& arena)
+    {
+        AVA_CHECK_NO_EXCEPT_RETURN(arena != nullptr, "Cannot destroy an invalid geometry arena");
+        AVA_CHECK_NO_EXCEPT_RETURN(detail::State.device, "Cannot destroy geometry arena when State's device is invalid");
+
+        for (auto& mesh : arena->meshes)
+        {
+            delete mesh;
+        }
+        arena->meshes.clear();
+
+        if (arena->vertexBuffer != nullptr)
+        {
+            destroyBuffer(arena->vertexBuffer);
+        }
+        if (arena->indexBuffer != nullptr)
+        {
+            destroyBuffer(arena->indexBuffer);
+        }
+
+        delete arena;
+        arena = nullptr;
+    }
+
+    ArenaMesh allocateArenaMesh(const GeometryArena& arena, const void* vertexData, const vk::DeviceSize vertexDataSize, const void* indexData, const uint32_t indexCount)
+    {
+        AVA_CHECK(arena != nullptr && arena->vertexBuffer != nullptr, "Cannot allocate a mesh from an invalid geometry arena");
+        AVA_CHECK(vertexData != nullptr && vertexDataSize > 0, "Cannot allocate an arena mesh without vertex data");
+        AVA_CHECK((vertexDataSize % arena->stride) == 0, "Cannot allocate an arena mesh when vertex data size is not a multiple of the arena's stride (" + std::to_string(arena->stride) + ")");
+        AVA_CHECK(indexCount == 0 || indexData != nullptr, "Cannot allocate an arena mesh when indexData is nullptr and indexCount is not 0");
+
+        const auto vertexCount = static_cast<uint32_t>(vertexDataSize / arena->stride);
+
+        auto vertexOffset = detail::allocateArenaRange(arena->vertexRanges, vertexCount);
+        if (!vertexOffset.has_value())
+        {
+            growArenaBuffer(arena, arena->vertexBuffer, arena->vertexRanges, arena->stride, vertexCount, false);
+            vertexOffset = detail::allocateArenaRange(arena->vertexRanges, vertexCount);
+        }
+        AVA_CHECK(vertexOffset.has_value(), "Failed to allocate " + std::to_string(vertexCount) + " vertices from the geometry arena");
+
+        std::optional<uint32_t> firstIndex = 0u;
+        if (indexCount > 0)
+        {
+            firstIndex = detail::allocateArenaRange(arena->indexRanges, indexCount);
+            if (!firstIndex.has_value())
+            {
+                growArenaBuffer(arena, arena->indexBuffer, arena->indexRanges, arena->indexSize, indexCount, true);
+                firstIndex = detail::allocateArenaRange(arena->indexRanges, indexCount);
+            }
+            AVA_CHECK(firstIndex.has_value(), "Failed to allocate " + std::to_string(indexCount) + " indices from the geometry arena");
+        }
+
+        updateBuffer(arena->vertexBuffer, vertexData, vertexDataSize, static_cast<vk::DeviceSize>(vertexOffset.value()) * arena->stride);
+        if (indexCount > 0)
+        {
+            updateBuffer(arena->indexBuffer, indexData, static_cast<vk::DeviceSize>(indexCount) * arena->indexSize, static_cast<vk::DeviceSize>(firstIndex.value()) * arena->indexSize);
+        }
+
+        const auto outMesh = new detail::ArenaMesh();
+        outMesh->arena = arena;
+        outMesh->vertexOffset = vertexOffset.value();
+        outMesh->vertexCount = vertexCount;
+        outMesh->firstIndex = firstIndex.value();
+        outMesh->indexCount = indexCount;
+        arena->meshes.push_back(outMesh);
+        return outMesh;
+    }
+
+    ArenaMesh allocateArenaMesh(const GeometryArena& arena, const void* vertexData, const vk::DeviceSize vertexDataSize, const void* indexData, const uint32_t indexCount, const vk::IndexType indexType)
+    {
+        AVA_CHECK(arena != nullptr, "Cannot allocate a mesh from an invalid geometry arena");
+        AVA_CHECK(indexType == arena->indexType, "Cannot allocate an arena mesh when its index type does not match the arena's index type");
+        return allocateArenaMesh(arena, vertexData, vertexDataSize, indexData, indexCount);
+    }
+
+    void freeArenaMesh(ArenaMesh& mesh)
+    {
+        AVA_CHECK_NO_EXCEPT_RETURN(mesh != nullptr && mesh->arena != nullptr, "Cannot free an invalid arena mesh");
+
+        const auto arena = mesh->arena;
+        detail::freeArenaRange(arena->vertexRanges, mesh->vertexOffset, mesh->vertexCount);
+        if (mesh->indexCount > 0)
+        {
+            detail::freeArenaRange(arena->indexRanges, mesh->firstIndex, mesh->indexCount);
+        }
+        std::erase(arena->meshes, mesh);
+
+        delete mesh;
+        mesh = nullptr;
+    }
+
+    // Compact when nothing is free, or the only free range is the tail of the arena
+    static bool isArenaRangesCompact(const detail::ArenaRangeAllocator& allocator)
+    {
+        if (allocator.freeRanges.empty())
+        {
+            return true;
+        }
+        const auto& [offset, count] = *allocator.freeRanges.begin();
+        return allocator.freeRanges.size() == 1 && offset + count == allocator.capacity;
+    }
+
+    void compactGeometryArena(const GeometryArena& arena)
+    {
+        AVA_CHECK(arena != nullptr && arena->vertexBuffer != nullptr, "Cannot compact an invalid geometry arena");
+        AVA_CHECK(detail::State.device, "Cannot compact a geometry arena when State's device is invalid");
+
+        if (isArenaRangesCompact(arena->vertexRanges) && isArenaRangesCompact(arena->indexRanges))
+        {
+            return;
+        }
+
+        // Pack meshes in offset order from the start of fresh buffers, keeping the meshes' relative order
+        auto meshes = arena->meshes;
+        std::vector<vk::BufferCopy> vertexCopies;
+        std::ranges::sort(meshes, {}, &detail::ArenaMesh::vertexOffset);
+        uint32_t usedVertices = 0;
+        for (const auto& mesh : meshes)
+        {
+            vertexCopies.emplace_back(static_cast<vk::DeviceSize>(mesh->vertexOffset) * arena->stride, static_cast<vk::DeviceSize>(usedVertices) * arena->stride, static_cast<vk::DeviceSize>(mesh->vertexCount) * arena->stride);
+            mesh->vertexOffset = usedVertices;
+            usedVertices += mesh->vertexCount;
+        }
+
+        std::vector<vk::BufferCopy> indexCopies;
+        std::ranges::sort(meshes, {}, &detail::ArenaMesh::firstIndex);
+        uint32_t usedIndices = 0;
+        for (const auto& mesh : meshes)
+        {
+            if (mesh->indexCount == 0)
+            {
+                continue;
+            }
+            indexCopies.emplace_back(static_cast<vk::DeviceSize>(mesh->firstIndex) * arena->indexSize, static_cast<vk::DeviceSize>(usedIndices) * arena->indexSize, static_cast<vk::DeviceSize>(mesh->indexCount) * arena->indexSize);
+            mesh->firstIndex = usedIndices;
+            usedIndices += mesh->indexCount;
+        }
+
+        // Copy into fresh buffers, as overlapping regions within one buffer are not allowed
+        auto newVertexBuffer = createArenaVertexBuffer(arena, arena->vertexRanges.capacity);
+        auto newIndexBuffer = createArenaIndexBuffer(arena, arena->indexRanges.capacity);
+
+        const auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eTransfer);
+        if (!vertexCopies.empty())
+        {
+            commandBuffer->commandBuffer.copyBuffer(arena->vertexBuffer->buffer, newVertexBuffer->buffer, vertexCopies);
+        }
+        if (!indexCopies.empty())
+        {
+            commandBuffer->commandBuffer.copyBuffer(arena->indexBuffer->buffer, newIndexBuffer->buffer, indexCopies);
+        }
+        endSingleTimeCommands(commandBuffer);
+
+        retireArenaBuffer(arena->vertexBuffer);
+        retireArenaBuffer(arena->indexBuffer);
+        arena->vertexBuffer = newVertexBuffer;
+        arena->indexBuffer = newIndexBuffer;
+
+        detail::initArenaRanges(arena->vertexRanges, arena->vertexRanges.capacity);
+        detail::initArenaRanges(arena->indexRanges, arena->indexRanges.capacity);
+        if (usedVertices > 0)
+        {
+            (void)detail::allocateArenaRange(arena->vertexRanges, usedVertices);
+        }
+        if (usedIndices > 0)
+        {
+            (void)detail::allocateArenaRange(arena->indexRanges, usedIndices);
+        }
+    }
+
+    void bindGeometryArena(const CommandBuffer& commandBuffer, const GeometryArena& arena)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot bind geometry arena to an invalid command buffer");
+        AVA_CHECK(arena != nullptr && arena->vertexBuffer != nullptr && arena->indexBuffer != nullptr, "Cannot bind an invalid geometry arena");
+        AVA_CHECK(commandBuffer->pipelineCurrentlyBound, "Cannot bind a geometry arena when a pipeline has not yet been bound");
+
+        commandBuffer->commandBuffer.bindVertexBuffers(arena->binding, arena->vertexBuffer->buffer, {0u});
+        commandBuffer->commandBuffer.bindIndexBuffer(arena->indexBuffer->buffer, 0u, arena->indexType);
+        commandBuffer->lastBoundIndexBufferIndexCount = 0; // Each mesh provides its own index count
+    }
+
+    void drawArenaMesh(const CommandBuffer& commandBuffer, const ArenaMesh& mesh, const uint32_t instanceCount, const uint32_t firstInstance)
+    {
+        AVA_CHECK(mesh != nullptr, "Cannot draw an invalid arena mesh");
+
+        if (mesh->indexCount > 0)
+        {
+            drawIndexed(commandBuffer, mesh->indexCount, instanceCount, mesh->firstIndex, static_cast<int32_t>(mesh->vertexOffset), firstInstance);
+        }
+        else
+        {
+            draw(commandBuffer, mesh->vertexCount, instanceCount, mesh->vertexOffset, firstInstance);
+        }
+    }
+
+    vk::DrawIndexedIndirectCommand getArenaMeshDrawCommand(const ArenaMesh& mesh, const uint32_t instanceCount, const uint32_t firstInstance)
+    {
+        AVA_CHECK(mesh != nullptr, "Cannot get the draw command of an invalid arena mesh");
+        AVA_CHECK(mesh->indexCount > 0, "Cannot get an indexed draw command of an arena mesh without indices");
+
+        return vk::DrawIndexedIndirectCommand{mesh->indexCount, instanceCount, mesh->firstIndex, static_cast<int32_t>(mesh->vertexOffset), firstInstance};
+    }
+
+    Buffer getGeometryArenaVertexBuffer(const GeometryArena& arena)
+    {
+        AVA_CHECK(arena != nullptr, "Cannot get the vertex buffer of an invalid geometry arena");
+        return arena->vertexBuffer;
+    }
+
+    Buffer getGeometryArenaIndexBuffer(const GeometryArena& arena)
+    {
+        AVA_CHECK(arena != nullptr, "Cannot get the index buffer of an invalid geometry arena");
+        return arena->indexBuffer;
+    }
+
+    GeometryArenaStatistics getGeometryArenaStatistics(const GeometryArena& arena)
+    {
+        AVA_CHECK(arena != nullptr, "Cannot get statistics of an invalid geometry arena");
+
+        GeometryArenaStatistics statistics{};
+        statistics.meshCount = static_cast<uint32_t>(arena->meshes.size());
+        statistics.usedVertices = arena->vertexRanges.used;
+        statistics.vertexCapacity = arena->vertexRanges.capacity;
+        statistics.usedIndices = arena->indexRanges.used;
+        statistics.indexCapacity = arena->indexRanges.capacity;
+        statistics.freeVertexRanges = static_cast<uint32_t>(arena->vertexRanges.freeRanges.size());
+        statistics.freeIndexRanges = static_cast<uint32_t>(arena->indexRanges.freeRanges.size());
+        return statistics;
+    }
+}
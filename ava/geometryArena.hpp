@@ -0,0 +1,66 @@
+#ifndef AVA_GEOMETRYARENA_HPP
+#define AVA_GEOMETRYARENA_HPP
+
+#include "types.hpp"
+#include <type_traits>
+
+namespace ava
+{
+    struct GeometryArenaCreationInfo
+    {
+        VAO vao = nullptr; // Vertex layout shared by every mesh in the arena
+        uint32_t binding = 0; // VAO binding the vertices are laid out for, and the binding the arena is bound to
+        vk::IndexType indexType = vk::IndexType::eUint32;
+        uint32_t initialVertexCapacity = 65536;
+        uint32_t initialIndexCapacity = 262144;
+        vk::BufferUsageFlags extraBufferUsage = {}; // Added to both buffers, e.g. eStorageBuffer for vertex pulling
+    };
+
+    struct GeometryArenaStatistics
+    {
+        uint32_t meshCount;
+        uint32_t usedVertices;
+        uint32_t vertexCapacity;
+        uint32_t usedIndices;
+        uint32_t indexCapacity;
+        uint32_t freeVertexRanges;
+        uint32_t freeIndexRanges;
+    };
+
+    [[nodiscard]] GeometryArena createGeometryArena(const GeometryArenaCreationInfo& creationInfo);
+    // Also frees every mesh still allocated from the arena
+    void destroyGeometryArena(GeometryArena& arena);
+
+    // Uploads the mesh into free ranges of the arena. vertexDataSize must be a multiple of the VAO binding's stride
+    // Indices are relative to the mesh's first vertex and must match the arena's index type
+    // Growing the arena replaces its buffers, the old ones are destroyed once the frames that may use them have completed
+    // Rebind the arena and rewrite descriptors or device addresses of its buffers afterwards, see getGeometryArenaVertexBuffer
+    [[nodiscard]] ArenaMesh allocateArenaMesh(const GeometryArena& arena, const void* vertexData, vk::DeviceSize vertexDataSize, const void* indexData, uint32_t indexCount);
+    // Checks indexType against the arena's index type first
+    [[nodiscard]] ArenaMesh allocateArenaMesh(const GeometryArena& arena, const void* vertexData, vk::DeviceSize vertexDataSize, const void* indexData, uint32_t indexCount, vk::IndexType indexType);
+
+    template <typename V, typename I>
+    [[nodiscard]] ArenaMesh allocateArenaMesh(const GeometryArena& arena, const std::vector<V>& vertices, const std::vector<I>& indices)
+    {
+        static_assert(std::is_same_v<I, uint32_t> || std::is_same_v<I, uint16_t>, "Arena mesh indices must be uint32_t or uint16_t");
+        constexpr auto indexType = std::is_same_v<I, uint32_t> ? vk::IndexType::eUint32 : vk::IndexType::eUint16;
+        return allocateArenaMesh(arena, vertices.data(), vertices.size() * sizeof(V), indices.data(), static_cast<uint32_t>(indices.size()), indexType);
+    }
+
+    void freeArenaMesh(ArenaMesh& mesh);
+
+    // Moves every mesh down to close freed ranges, mesh handles stay valid but their offsets change
+    // The arena's buffers are replaced like when growing, so rebind the arena and rewrite descriptors or device addresses of its buffers afterwards
+    void compactGeometryArena(const GeometryArena& arena);
+
+    // Binds the arena's vertex buffer at its binding and its index buffer
+    void bindGeometryArena(const CommandBuffer& commandBuffer, const GeometryArena& arena);
+    void drawArenaMesh(const CommandBuffer& commandBuffer, const ArenaMesh& mesh, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
+    vk::DrawIndexedIndirectCommand getArenaMeshDrawCommand(const ArenaMesh& mesh, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
+
+    Buffer getGeometryArenaVertexBuffer(const GeometryArena& arena);
+    Buffer getGeometryArenaIndexBuffer(const GeometryArena& arena);
+    GeometryArenaStatistics getGeometryArenaStatistics(const GeometryArena& arena);
+}
+
+#endif
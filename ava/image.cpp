@@ -1,22 +1,38 @@
 #include "image.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include "detail/image.hpp"
 #include "detail/buffer.hpp"
 #include "detail/commandBuffer.hpp"
 #include "detail/detail.hpp"
+#include "detail/frame.hpp"
+#include "detail/memoryPool.hpp"
+#include "detail/shaders.hpp"
 #include "detail/state.hpp"
 #include "buffer.hpp"
 #include "commandBuffer.hpp"
+#include "compute.hpp"
+#include "descriptors.hpp"
 
 namespace ava
 {
-    Image createImage(const vk::Extent3D extent, const vk::Format format, const vk::ImageUsageFlags usageFlags, const vk::ImageType imageType, const vk::ImageTiling tiling, const uint32_t mipLevels, const uint32_t arrayLayers, const vk::SampleCountFlagBits samples, const MemoryLocation memoryLocation)
+    Image createImage(const vk::Extent3D extent, const vk::Format format, const vk::ImageUsageFlags usageFlags, const vk::ImageType imageType, const vk::ImageTiling tiling, const uint32_t mipLevels, const uint32_t arrayLayers, const vk::SampleCountFlagBits samples, const MemoryLocation memoryLocation, const InitialImageLayout initialLayout,
+                      const vk::ImageCreateFlags createFlags, const MemoryPool& memoryPool)
     {
         AVA_CHECK(extent.width > 0 && extent.height > 0 && extent.depth > 0, "Invalid image extent when creating image");
         AVA_CHECK(detail::State.allocator, "Cannot create an image without a valid State allocator");
+        AVA_CHECK(memoryPool == nullptr || (memoryPool->holdsImages && memoryPool->memoryLocation == memoryLocation), "Cannot create an image with a memory pool which is for buffers or another memory location");
+
+        auto usage = usageFlags;
+        if ((usage & vk::ImageUsageFlagBits::eHostTransferEXT) && !isHostImageCopySupported(format, tiling))
+        {
+            usage &= ~vk::ImageUsageFlags{vk::ImageUsageFlagBits::eHostTransferEXT};
+        }
 
         vk::ImageCreateInfo createInfo;
+        createInfo.flags = createFlags;
         createInfo.imageType = imageType;
         createInfo.extent = extent;
         createInfo.tiling = tiling;
@@ -24,14 +40,24 @@ namespace ava
         createInfo.arrayLayers = arrayLayers;
         createInfo.format = format;
         createInfo.initialLayout = vk::ImageLayout::eUndefined;
-        createInfo.usage = usageFlags;
+        createInfo.usage = usage;
         createInfo.samples = samples;
         createInfo.sharingMode = vk::SharingMode::eExclusive;
 
         vma::AllocationCreateInfo allocInfo;
         allocInfo.usage = getMemoryUsageFromBufferLocation(memoryLocation);
+        if (memoryPool != nullptr)
+        {
+            allocInfo.pool = memoryPool->pool;
+        }
 
         const auto pair = detail::State.allocator.createImage(createInfo, allocInfo);
+        const bool withinBudget = detail::isMemoryPoolWithinBudget(memoryPool);
+        if (!withinBudget)
+        {
+            detail::State.allocator.destroyImage(pair.first, pair.second);
+        }
+        AVA_CHECK(withinBudget, "Cannot create an image when it would take memory pool " + memoryPool->name + " over its budget of " + std::to_string(memoryPool->budget) + " bytes");
         const auto allocationInfo = detail::State.allocator.getAllocationInfo(pair.second);
 
         auto newImage = new detail::Image();
@@ -40,16 +66,47 @@ namespace ava
         newImage->imageLayout = vk::ImageLayout::eUndefined;
         newImage->creationInfo = createInfo;
         newImage->allocationInfo = allocationInfo;
+        newImage->allocationOwner = detail::AllocationOwner{detail::AllocationOwnerType::eImage, newImage};
+        detail::State.allocator.setAllocationUserData(newImage->allocation, &newImage->allocationOwner);
+        detail::State.imageMemory.count++;
+        detail::State.imageMemory.bytes += allocationInfo.size;
 
-        auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eTransfer);
-        transitionImageLayout(commandBuffer, newImage, vk::ImageLayout::eGeneral, getImageAspectFlagsForFormat(format));
-        endSingleTimeCommands(commandBuffer);
+        // The image reports its initial layout straight away, so descriptors can be written before the transition is submitted
+        switch (initialLayout)
+        {
+        case InitialImageLayout::eGeneral:
+            newImage->imageLayout = vk::ImageLayout::eGeneral;
+            break;
+        case InitialImageLayout::eOptimal:
+            newImage->imageLayout = getOptimalImageLayout(usageFlags, format);
+            break;
+        case InitialImageLayout::eUndefined:
+        default:
+            break;
+        }
+        if (newImage->imageLayout != vk::ImageLayout::eUndefined)
+        {
+            newImage->initialTransitionPending = true;
+            detail::State.pendingImageTransitions.push_back(newImage);
+        }
         return newImage;
     }
 
-    Image createImage2D(const vk::Extent2D extent, const vk::Format format, const vk::ImageUsageFlags usageFlags, const uint32_t mipLevels)
+    Image createImage2D(const vk::Extent2D extent, const vk::Format format, const vk::ImageUsageFlags usageFlags, const uint32_t mipLevels, const InitialImageLayout initialLayout)
+    {
+        return createImage(vk::Extent3D{extent, 1}, format, usageFlags, vk::ImageType::e2D, vk::ImageTiling::eOptimal, mipLevels, 1, vk::SampleCountFlagBits::e1, MemoryLocation::eGpuOnly, initialLayout);
+    }
+
+    void submitPendingImageTransitions()
     {
-        return createImage(vk::Extent3D{extent, 1}, format, usageFlags, vk::ImageType::e2D, vk::ImageTiling::eOptimal, mipLevels, 1, vk::SampleCountFlagBits::e1, MemoryLocation::eGpuOnly);
+        if (detail::State.pendingImageTransitions.empty())
+        {
+            return;
+        }
+
+        // endSingleTimeCommands submits the pending transitions ahead of the empty command buffer
+        const auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eGraphics);
+        endSingleTimeCommands(commandBuffer);
     }
 
     void destroyImage(Image& image)
@@ -58,11 +115,27 @@ namespace ava
         AVA_CHECK_NO_EXCEPT_RETURN(detail::State.device, "Cannot destroy image when State's device is invalid");
         AVA_CHECK_NO_EXCEPT_RETURN(!image->isSwapchainImage, "Cannot destroy swapchain image");
 
+        detail::removePendingImageTransition(image);
+        for (const auto imageView : image->imageViews)
+        {
+            imageView->image = nullptr;
+        }
         if (image->image)
         {
             if (image->allocation)
             {
-                detail::State.allocator.destroyImage(image->image, image->allocation);
+                if (image->defragmentationMove != nullptr)
+                {
+                    // Both the moved from and moved to memory are freed when the pending pass ends
+                    detail::State.device.destroyImage(image->image);
+                    image->defragmentationMove->operation = vma::DefragmentationMoveOperation::eDestroy;
+                }
+                else
+                {
+                    detail::State.allocator.destroyImage(image->image, image->allocation);
+                }
+                detail::State.imageMemory.count--;
+                detail::State.imageMemory.bytes -= image->allocationInfo.size;
             }
             else
             {
@@ -98,11 +171,24 @@ namespace ava
         createInfo.subresourceRange = subresourceRange.value();
         createInfo.setComponents(vk::ComponentMapping{});
 
+        // The image's views double as its view cache
+        for (const auto existingImageView : image->imageViews)
+        {
+            if (existingImageView->creationInfo == createInfo)
+            {
+                existingImageView->referenceCount++;
+                return existingImageView;
+            }
+        }
+
         const auto imageView = detail::State.device.createImageView(createInfo);
 
         const auto outImageView = new detail::ImageView();
         outImageView->imageView = imageView;
         outImageView->format = selectedFormat;
+        outImageView->image = image;
+        outImageView->creationInfo = createInfo;
+        image->imageViews.push_back(outImageView);
 
         return outImageView;
     }
@@ -113,10 +199,19 @@ namespace ava
         AVA_CHECK_NO_EXCEPT_RETURN(detail::State.device, "Cannot destroy image view when State's device is invalid");
         AVA_CHECK_NO_EXCEPT_RETURN(!imageView->isSwapchainImageView, "Cannot destroy swapchain image view");
 
+        if (--imageView->referenceCount > 0)
+        {
+            imageView = nullptr;
+            return;
+        }
         if (imageView->imageView)
         {
             detail::State.device.destroyImageView(imageView->imageView);
         }
+        if (imageView->image != nullptr)
+        {
+            std::erase(imageView->image->imageViews, imageView);
+        }
 
         delete imageView;
         imageView = nullptr;
@@ -135,9 +230,10 @@ namespace ava
         AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot insert image memory barrier when command buffer is invalid");
         AVA_CHECK(image != nullptr && image->image, "Cannot insert image memory barrier when image is invalid");
 
-        const auto oldLayout = image->imageLayout;
-        if (oldLayout == newLayout)
+        if (image->imageLayout == newLayout)
         {
+            // A pending initial transition would otherwise run in a later submission than this command buffer
+            detail::recordInitialImageTransition(commandBuffer, image);
             return;
         }
 
@@ -148,7 +244,7 @@ namespace ava
 
         vk::ImageMemoryBarrier barrier;
         barrier.image = image->image;
-        barrier.oldLayout = oldLayout;
+        barrier.oldLayout = detail::takeOverInitialImageTransition(commandBuffer, image, subresourceRange.value());
         barrier.newLayout = newLayout;
         barrier.srcAccessMask = srcAccessMask;
         barrier.dstAccessMask = dstAccessMask;
@@ -166,9 +262,10 @@ namespace ava
         AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot insert image memory barrier when command buffer is invalid");
         AVA_CHECK(image != nullptr && image->image, "Cannot insert image memory barrier when image is invalid");
 
-        const auto oldLayout = image->imageLayout;
-        if (oldLayout == newLayout)
+        if (image->imageLayout == newLayout)
         {
+            // A pending initial transition would otherwise run in a later submission than this command buffer
+            detail::recordInitialImageTransition(commandBuffer, image);
             return;
         }
 
@@ -176,6 +273,7 @@ namespace ava
         {
             subresourceRange = vk::ImageSubresourceRange{aspectFlags, 0, image->creationInfo.mipLevels, 0, image->creationInfo.arrayLayers};
         }
+        const auto oldLayout = detail::takeOverInitialImageTransition(commandBuffer, image, subresourceRange.value());
 
         vk::ImageMemoryBarrier barrier{};
         barrier.image = image->image;
@@ -327,6 +425,60 @@ namespace ava
         transitionImageLayout(commandBuffer, image, oldLayout, vk::ImageAspectFlagBits::eNone, vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands, subresourceRange);
     }
 
+    bool isHostImageCopySupported(const vk::Format format, const vk::ImageTiling tiling)
+    {
+        if (!detail::State.hostImageCopyEnabled)
+        {
+            return false;
+        }
+
+        const auto formatProperties = detail::State.physicalDevice.getFormatProperties2<vk::FormatProperties2, vk::FormatProperties3>(format).get<vk::FormatProperties3>();
+        const auto features = (tiling == vk::ImageTiling::eLinear) ? formatProperties.linearTilingFeatures : formatProperties.optimalTilingFeatures;
+        return (features & vk::FormatFeatureFlagBits2::eHostImageTransferEXT) == vk::FormatFeatureFlagBits2::eHostImageTransferEXT;
+    }
+
+    static bool canHostCopyToImage(const Image& image)
+    {
+        return detail::State.hostImageCopyEnabled && (image->creationInfo.usage & vk::ImageUsageFlagBits::eHostTransferEXT) && std::ranges::find(detail::State.hostImageCopyDstLayouts, image->imageLayout) != detail::State.hostImageCopyDstLayouts.end();
+    }
+
+    static void hostCopyToImage(const Image& image, const void* data, const vk::BufferImageCopy& region)
+    {
+        // Nothing on the GPU has used an image still waiting for its initial transition, so it can be done on the host instead
+        if (image->initialTransitionPending)
+        {
+            detail::removePendingImageTransition(image);
+
+            const auto initialBarrier = detail::getInitialImageTransitionBarrier(image);
+            vk::HostImageLayoutTransitionInfoEXT transitionInfo{};
+            transitionInfo.image = image->image;
+            transitionInfo.oldLayout = vk::ImageLayout::eUndefined;
+            transitionInfo.newLayout = image->imageLayout;
+            transitionInfo.subresourceRange = initialBarrier.subresourceRange;
+            detail::State.device.transitionImageLayoutEXT(transitionInfo, detail::State.dispatchLoader);
+        }
+        else
+        {
+            // The host write is not ordered against the GPU, so submitted frames that may still read the image have to finish first
+            // Commands recorded into the started frame are submitted later and see the new data, the same as with a single time command
+            detail::waitForSubmittedFrames();
+        }
+
+        vk::MemoryToImageCopyEXT copyRegion{};
+        copyRegion.pHostPointer = data;
+        copyRegion.memoryRowLength = region.bufferRowLength;
+        copyRegion.memoryImageHeight = region.bufferImageHeight;
+        copyRegion.imageSubresource = region.imageSubresource;
+        copyRegion.imageOffset = region.imageOffset;
+        copyRegion.imageExtent = region.imageExtent;
+
+        vk::CopyMemoryToImageInfoEXT copyInfo{};
+        copyInfo.dstImage = image->image;
+        copyInfo.dstImageLayout = image->imageLayout;
+        copyInfo.setRegions(copyRegion);
+        detail::State.device.copyMemoryToImageEXT(copyInfo, detail::State.dispatchLoader);
+    }
+
     void updateImage(const Image& image, const void* data, const vk::DeviceSize dataSize, const vk::ImageAspectFlags aspectFlags, std::optional<vk::ImageSubresourceLayers> subresourceLayers, std::optional<vk::ImageSubresourceRange> subresourceRange)
     {
         AVA_CHECK(image != nullptr && image->image, "Cannot update image when image is invalid");
@@ -350,6 +502,12 @@ namespace ava
         region.imageOffset = vk::Offset3D{0, 0, 0};
         region.imageSubresource = subresourceLayers.value();
 
+        if (canHostCopyToImage(image))
+        {
+            hostCopyToImage(image, data, region);
+            return;
+        }
+
         auto stagingBuffer = createBuffer(dataSize, vk::BufferUsageFlagBits::eTransferSrc, MemoryLocation::eCpuToGpu, 0);
         updateBuffer(stagingBuffer, data, dataSize);
 
@@ -360,6 +518,198 @@ namespace ava
         destroyBuffer(stagingBuffer);
     }
 
+    bool canBlitMipmaps(const vk::Format format, const vk::ImageTiling tiling)
+    {
+        AVA_CHECK(detail::State.physicalDevice, "Cannot check format blit support when State's physical device is invalid");
+
+        const auto formatProperties = detail::State.physicalDevice.getFormatProperties(format);
+        const auto features = (tiling == vk::ImageTiling::eLinear) ? formatProperties.linearTilingFeatures : formatProperties.optimalTilingFeatures;
+        constexpr auto requiredFeatures = vk::FormatFeatureFlagBits::eBlitSrc | vk::FormatFeatureFlagBits::eBlitDst | vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+        return (features & requiredFeatures) == requiredFeatures;
+    }
+
+    static void blitMipmaps(const CommandBuffer& commandBuffer, const Image& image, const vk::ImageLayout oldLayout, const vk::ImageLayout finalLayout)
+    {
+        const auto aspectFlags = getImageAspectFlagsForFormat(image->creationInfo.format);
+        const auto mipLevels = image->creationInfo.mipLevels;
+        const auto arrayLayers = image->creationInfo.arrayLayers;
+
+        vk::ImageMemoryBarrier barrier{};
+        barrier.image = image->image;
+        barrier.srcQueueFamilyIndex = vk::QueueFamilyIgnored;
+        barrier.dstQueueFamilyIndex = vk::QueueFamilyIgnored;
+
+        // Mip 0 becomes the first blit source while the rest are overwritten, so their contents can be discarded
+        std::array<vk::ImageMemoryBarrier, 2> barriers{barrier, barrier};
+        barriers[0].oldLayout = oldLayout;
+        barriers[0].newLayout = vk::ImageLayout::eTransferSrcOptimal;
+        barriers[0].srcAccessMask = vk::AccessFlagBits::eMemoryWrite;
+        barriers[0].dstAccessMask = vk::AccessFlagBits::eTransferRead;
+        barriers[0].subresourceRange = vk::ImageSubresourceRange{aspectFlags, 0, 1, 0, arrayLayers};
+        barriers[1].oldLayout = vk::ImageLayout::eUndefined;
+        barriers[1].newLayout = vk::ImageLayout::eTransferDstOptimal;
+        barriers[1].srcAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite;
+        barriers[1].dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+        barriers[1].subresourceRange = vk::ImageSubresourceRange{aspectFlags, 1, mipLevels - 1, 0, arrayLayers};
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {}, nullptr, nullptr, barriers);
+
+        auto sourceExtent = image->creationInfo.extent;
+        for (uint32_t mip = 1; mip < mipLevels; mip++)
+        {
+            const vk::Extent3D destinationExtent{std::max(sourceExtent.width / 2, 1u), std::max(sourceExtent.height / 2, 1u), std::max(sourceExtent.depth / 2, 1u)};
+
+            vk::ImageBlit blit{};
+            blit.srcSubresource = vk::ImageSubresourceLayers{aspectFlags, mip - 1, 0, arrayLayers};
+            blit.srcOffsets[1] = vk::Offset3D{static_cast<int32_t>(sourceExtent.width), static_cast<int32_t>(sourceExtent.height), static_cast<int32_t>(sourceExtent.depth)};
+            blit.dstSubresource = vk::ImageSubresourceLayers{aspectFlags, mip, 0, arrayLayers};
+            blit.dstOffsets[1] = vk::Offset3D{static_cast<int32_t>(destinationExtent.width), static_cast<int32_t>(destinationExtent.height), static_cast<int32_t>(destinationExtent.depth)};
+            commandBuffer->commandBuffer.blitImage(image->image, vk::ImageLayout::eTransferSrcOptimal, image->image, vk::ImageLayout::eTransferDstOptimal, blit, vk::Filter::eLinear);
+
+            // The last mip is never read from, it goes straight to the final layout below
+            if (mip + 1 < mipLevels)
+            {
+                barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+                barrier.newLayout = vk::ImageLayout::eTransferSrcOptimal;
+                barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+                barrier.dstAccessMask = vk::AccessFlagBits::eTransferRead;
+                barrier.subresourceRange = vk::ImageSubresourceRange{aspectFlags, mip, 1, 0, arrayLayers};
+                commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, {}, nullptr, nullptr, barrier);
+            }
+            sourceExtent = destinationExtent;
+        }
+
+        barriers[0].oldLayout = vk::ImageLayout::eTransferSrcOptimal;
+        barriers[0].newLayout = finalLayout;
+        barriers[0].srcAccessMask = vk::AccessFlagBits::eTransferRead;
+        barriers[0].dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite;
+        barriers[0].subresourceRange = vk::ImageSubresourceRange{aspectFlags, 0, mipLevels - 1, 0, arrayLayers};
+        barriers[1].oldLayout = vk::ImageLayout::eTransferDstOptimal;
+        barriers[1].newLayout = finalLayout;
+        barriers[1].srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        barriers[1].dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite;
+        barriers[1].subresourceRange = vk::ImageSubresourceRange{aspectFlags, mipLevels - 1, 1, 0, arrayLayers};
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands, {}, nullptr, nullptr, barriers);
+    }
+
+    static void downsampleMipmaps(const CommandBuffer& commandBuffer, const Image& image, const ComputePipeline& downsamplePipeline, const vk::ImageLayout oldLayout, const vk::ImageLayout finalLayout)
+    {
+        const auto mipLevels = image->creationInfo.mipLevels;
+        const auto arrayLayers = image->creationInfo.arrayLayers;
+        const auto extent = image->creationInfo.extent;
+
+        AVA_CHECK(!downsamplePipeline->layoutBindings.empty(), "Cannot generate mipmaps when the downsample pipeline has no descriptor set 0");
+        const auto& layoutBindings = downsamplePipeline->layoutBindings.at(0);
+        const auto mipBinding = std::ranges::find_if(layoutBindings, [](const vk::DescriptorSetLayoutBinding& binding) { return binding.binding == 0; });
+        AVA_CHECK(mipBinding != layoutBindings.end() && mipBinding->descriptorType == vk::DescriptorType::eStorageImage, "Cannot generate mipmaps when binding 0 of the downsample pipeline is not a storage image array");
+        AVA_CHECK(mipBinding->descriptorCount >= mipLevels, "Cannot generate " + std::to_string(mipLevels) + " mips when the downsample pipeline's storage image array only has " + std::to_string(mipBinding->descriptorCount) + " elements");
+
+        // The whole image stays in eGeneral while the shader reads and writes it, mip 0 keeps its contents
+        vk::ImageMemoryBarrier barrier{};
+        barrier.image = image->image;
+        barrier.srcQueueFamilyIndex = vk::QueueFamilyIgnored;
+        barrier.dstQueueFamilyIndex = vk::QueueFamilyIgnored;
+
+        std::array<vk::ImageMemoryBarrier, 2> barriers{barrier, barrier};
+        barriers[0].oldLayout = oldLayout;
+        barriers[0].newLayout = vk::ImageLayout::eGeneral;
+        barriers[0].srcAccessMask = vk::AccessFlagBits::eMemoryWrite;
+        barriers[0].dstAccessMask = vk::AccessFlagBits::eShaderRead;
+        barriers[0].subresourceRange = vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, 0, 1, 0, arrayLayers};
+        barriers[1].oldLayout = vk::ImageLayout::eUndefined;
+        barriers[1].newLayout = vk::ImageLayout::eGeneral;
+        barriers[1].srcAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite;
+        barriers[1].dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+        barriers[1].subresourceRange = vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, 1, mipLevels - 1, 0, arrayLayers};
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eComputeShader, {}, nullptr, nullptr, barriers);
+
+        std::vector<ava::ImageView> mipImageViews;
+        mipImageViews.reserve(mipLevels);
+        for (uint32_t mip = 0; mip < mipLevels; mip++)
+        {
+            mipImageViews.push_back(createImageView(image, vk::ImageAspectFlagBits::eColor, vk::ImageViewType::e2DArray, {}, vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, mip, 1, 0, arrayLayers}));
+        }
+
+        auto counterBuffer = createBuffer(sizeof(uint32_t) * arrayLayers, DEFAULT_STORAGE_BUFFER_USAGE);
+        commandBuffer->commandBuffer.fillBuffer(counterBuffer->buffer, 0, vk::WholeSize, 0);
+        insertBufferMemoryBarrier(commandBuffer, counterBuffer, vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eComputeShader, vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite);
+
+        auto descriptorPool = createDescriptorPool(downsamplePipeline, 1);
+        const auto descriptorSet = allocateDescriptorSet(descriptorPool, 0);
+        // Elements past the image's mips still need a valid descriptor
+        for (uint32_t element = 0; element < mipBinding->descriptorCount; element++)
+        {
+            bindImage(descriptorSet, 0, image, mipImageViews.at(std::min(element, mipLevels - 1)), nullptr, vk::ImageLayout::eGeneral, element);
+        }
+        bindBuffer(descriptorSet, 1, counterBuffer);
+
+        const uint32_t workGroupsX = (extent.width + MIPMAP_DOWNSAMPLE_TILE_SIZE - 1) / MIPMAP_DOWNSAMPLE_TILE_SIZE;
+        const uint32_t workGroupsY = (extent.height + MIPMAP_DOWNSAMPLE_TILE_SIZE - 1) / MIPMAP_DOWNSAMPLE_TILE_SIZE;
+
+        bindComputePipeline(commandBuffer, downsamplePipeline);
+        bindDescriptorSet(commandBuffer, descriptorSet);
+        const MipmapDownsamplePushConstants pushConstantData{{extent.width, extent.height}, mipLevels, workGroupsX * workGroupsY};
+        pushConstants(commandBuffer, vk::ShaderStageFlagBits::eCompute, pushConstantData);
+        dispatch(commandBuffer, workGroupsX, workGroupsY, arrayLayers);
+
+        barrier.oldLayout = vk::ImageLayout::eGeneral;
+        barrier.newLayout = finalLayout;
+        barrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+        barrier.dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite;
+        barrier.subresourceRange = vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, 0, mipLevels, 0, arrayLayers};
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eAllCommands, {}, nullptr, nullptr, barrier);
+
+        trackObject(commandBuffer, std::shared_ptr<void>(nullptr, [mipImageViews, counterBuffer, descriptorPool](void*) mutable
+        {
+            for (auto& mipImageView : mipImageViews)
+            {
+                destroyImageView(mipImageView);
+            }
+            destroyBuffer(counterBuffer);
+            destroyDescriptorPool(descriptorPool);
+        }));
+    }
+
+    void generateMipmaps(const CommandBuffer& commandBuffer, const Image& image, const ComputePipeline& downsamplePipeline, const std::optional<vk::ImageLayout> finalLayout)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot generate mipmaps with an invalid command buffer");
+        AVA_CHECK(image != nullptr && image->image, "Cannot generate mipmaps when image is invalid");
+
+        if (image->creationInfo.mipLevels <= 1)
+        {
+            return;
+        }
+
+        const auto oldLayout = detail::takeOverInitialImageTransition(commandBuffer, image, vk::ImageSubresourceRange{getImageAspectFlagsForFormat(image->creationInfo.format), 0, vk::RemainingMipLevels, 0, vk::RemainingArrayLayers});
+        // An image in eUndefined has no defined layout to return to, so it is left ready for sampling
+        auto newLayout = finalLayout.value_or(image->imageLayout);
+        if (newLayout == vk::ImageLayout::eUndefined)
+        {
+            newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+        }
+
+        const bool canBlit = canBlitMipmaps(image->creationInfo.format, image->creationInfo.tiling) && (image->creationInfo.usage & DEFAULT_IMAGE_TRANSFER_USAGE_FLAGS) == DEFAULT_IMAGE_TRANSFER_USAGE_FLAGS;
+        if (canBlit && commandBuffer->primaryQueue != vk::QueueFlagBits::eCompute)
+        {
+            blitMipmaps(commandBuffer, image, oldLayout, newLayout);
+        }
+        else
+        {
+            AVA_CHECK(downsamplePipeline == nullptr || downsamplePipeline->pipeline, "Cannot generate mipmaps with an invalid downsample pipeline");
+            AVA_CHECK((image->creationInfo.usage & vk::ImageUsageFlagBits::eStorage) != vk::ImageUsageFlags{}, "Cannot generate mipmaps with a downsample pipeline when the image was not created with eStorage usage");
+            AVA_CHECK(image->creationInfo.imageType == vk::ImageType::e2D, "Cannot generate mipmaps of a non-2D image with a downsample pipeline");
+            downsampleMipmaps(commandBuffer, image, downsamplePipeline != nullptr ? downsamplePipeline : detail::getMipmapDownsamplePipeline(), oldLayout, newLayout);
+        }
+
+        image->imageLayout = newLayout;
+    }
+
+    void generateMipmaps(const Image& image, const ComputePipeline& downsamplePipeline, const std::optional<vk::ImageLayout> finalLayout)
+    {
+        const auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eGraphics);
+        generateMipmaps(commandBuffer, image, downsamplePipeline, finalLayout);
+        endSingleTimeCommands(commandBuffer);
+    }
+
     ava::Image getSwapchainImage(const uint32_t index)
     {
         AVA_CHECK(index < detail::State.swapchainImageCount, "Cannot get swapchain image when index is out of range of image count");
@@ -401,4 +751,34 @@ namespace ava
         }
         return aspectFlags;
     }
+
+    vk::ImageLayout getOptimalImageLayout(const vk::ImageUsageFlags usageFlags, const vk::Format format)
+    {
+        // Storage images can only be accessed in eGeneral
+        if (usageFlags & vk::ImageUsageFlagBits::eStorage)
+        {
+            return vk::ImageLayout::eGeneral;
+        }
+        if (usageFlags & vk::ImageUsageFlagBits::eDepthStencilAttachment || ((usageFlags & vk::ImageUsageFlagBits::eColorAttachment) && detail::vulkanFormatHasDepth(format)))
+        {
+            return vk::ImageLayout::eDepthStencilAttachmentOptimal;
+        }
+        if (usageFlags & vk::ImageUsageFlagBits::eColorAttachment)
+        {
+            return vk::ImageLayout::eColorAttachmentOptimal;
+        }
+        if (usageFlags & (vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eInputAttachment))
+        {
+            return vk::ImageLayout::eShaderReadOnlyOptimal;
+        }
+        if (usageFlags & vk::ImageUsageFlagBits::eTransferDst)
+        {
+            return vk::ImageLayout::eTransferDstOptimal;
+        }
+        if (usageFlags & vk::ImageUsageFlagBits::eTransferSrc)
+        {
+            return vk::ImageLayout::eTransferSrcOptimal;
+        }
+        return vk::ImageLayout::eGeneral;
+    }
 }
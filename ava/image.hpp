@@ -12,17 +12,44 @@ namespace ava
     constexpr vk::ImageUsageFlags DEFAULT_IMAGE_STORAGE_USAGE_FLAGS = vk::ImageUsageFlagBits::eStorage | DEFAULT_IMAGE_TRANSFER_USAGE_FLAGS;
     constexpr vk::ImageUsageFlags DEFAULT_IMAGE_DEPTH_ATTACHMENT_USAGE_FLAGS = vk::ImageUsageFlagBits::eDepthStencilAttachment;
     constexpr vk::ImageUsageFlags DEFAULT_IMAGE_COLOR_ATTACHMENT_USAGE_FLAGS = vk::ImageUsageFlagBits::eColorAttachment;
+    // Sampled image that updateImage can write to from the host, transfer usage is kept for the staging fallback
+    constexpr vk::ImageUsageFlags DEFAULT_IMAGE_HOST_TRANSFER_USAGE_FLAGS = vk::ImageUsageFlagBits::eHostTransferEXT | DEFAULT_IMAGE_SAMPLED_USAGE_FLAGS;
 
-    // Generic and more advanced image creation
+    // Mip 0 tile each workgroup of a compute downsample shader given to generateMipmaps covers
+    constexpr uint32_t MIPMAP_DOWNSAMPLE_TILE_SIZE = 64;
+    // Mips the built-in downsample shader of generateMipmaps can write
+    constexpr uint32_t MIPMAP_DOWNSAMPLE_MAX_MIP_LEVELS = 16;
+
+    // Matches the push constants of a compute downsample shader given to generateMipmaps
+    struct MipmapDownsamplePushConstants
+    {
+        uint32_t extent[2]; // Of mip 0
+        uint32_t mipLevels;
+        uint32_t workGroupCount; // Per array layer
+    };
+
+    enum class InitialImageLayout
+    {
+        eGeneral, // Usable for anything but optimal for nothing
+        eOptimal, // Picked from the usage flags by getOptimalImageLayout
+        eUndefined, // No transition, for images whose first use transitions them such as attachments of render passes with an eUndefined initial layout
+    };
+
+    // eHostTransferEXT usage is dropped when isHostImageCopySupported is false for the format, so it can always be requested
+    // Images are not transitioned on creation. The transition to their initial layout is recorded into the first command buffer that transitions them
+    // Otherwise it is batched with the transitions of other new images ahead of the next submission made by endSingleTimeCommands or presentFrame
     [[nodiscard]] Image createImage(vk::Extent3D extent, vk::Format format, vk::ImageUsageFlags usageFlags = DEFAULT_IMAGE_SAMPLED_USAGE_FLAGS, vk::ImageType imageType = vk::ImageType::e2D, vk::ImageTiling tiling = vk::ImageTiling::eOptimal,
-                                    uint32_t mipLevels = 1, uint32_t arrayLayers = 1, vk::SampleCountFlagBits samples = vk::SampleCountFlagBits::e1, MemoryLocation memoryLocation = MemoryLocation::eGpuOnly);
+                                    uint32_t mipLevels = 1, uint32_t arrayLayers = 1, vk::SampleCountFlagBits samples = vk::SampleCountFlagBits::e1, MemoryLocation memoryLocation = MemoryLocation::eGpuOnly, InitialImageLayout initialLayout = InitialImageLayout::eGeneral,
+                                    vk::ImageCreateFlags createFlags = {}, const MemoryPool& memoryPool = nullptr);
     // Simpler image creation
-    [[nodiscard]] Image createImage2D(vk::Extent2D extent, vk::Format format, vk::ImageUsageFlags usageFlags = DEFAULT_IMAGE_SAMPLED_USAGE_FLAGS, uint32_t mipLevels = 1);
+    [[nodiscard]] Image createImage2D(vk::Extent2D extent, vk::Format format, vk::ImageUsageFlags usageFlags = DEFAULT_IMAGE_SAMPLED_USAGE_FLAGS, uint32_t mipLevels = 1, InitialImageLayout initialLayout = InitialImageLayout::eGeneral);
+    // Only needed before submitting command buffers without ava, submits the pending initial transitions of new images and waits for them
+    void submitPendingImageTransitions();
 
     void destroyImage(Image& image);
     vk::Image getImage(const Image& image);
 
-    // Image view creation
+    // Image view creation. Identical views of an image are shared and reference counted like samplers
     [[nodiscard]] ImageView createImageView(const Image& image, vk::ImageAspectFlags aspectFlags = vk::ImageAspectFlagBits::eColor, vk::ImageViewType imageViewType = vk::ImageViewType::e2D, std::optional<vk::Format> format = {}, std::optional<vk::ImageSubresourceRange> subresourceRange = {});
     void destroyImageView(ImageView& imageView);
 
@@ -34,8 +61,13 @@ namespace ava
                                std::optional<vk::ImageSubresourceRange> subresourceRange = {});
     void overrideOldImageLayout(const Image& image, vk::ImageLayout imageLayout);
 
+    // True when host image copy is enabled in State and the format supports it with the tiling
+    bool isHostImageCopySupported(vk::Format format, vk::ImageTiling tiling = vk::ImageTiling::eOptimal);
+
     // Update whole image using a buffer image copy
     void updateImage(const CommandBuffer& commandBuffer, const Image& image, const Buffer& stagingBuffer, const vk::BufferImageCopy& bufferImageCopy, std::optional<vk::ImageSubresourceRange> subresourceRange = {});
+    // Images with eHostTransferEXT usage are written straight from data on the host with no staging buffer or submission, when their layout allows it
+    // A host copy to an image the GPU has used first waits for every submitted frame. Otherwise data goes through a staging buffer and a single time command
     void updateImage(const Image& image, const void* data, vk::DeviceSize dataSize, vk::ImageAspectFlags aspectFlags = vk::ImageAspectFlagBits::eColor, std::optional<vk::ImageSubresourceLayers> subresourceLayers = {}, std::optional<vk::ImageSubresourceRange> subresourceRange = {});
 
     template <typename T>
@@ -50,12 +82,25 @@ namespace ava
         updateImage(image, data.data(), data.size() * sizeof(T), aspectFlags, subresourceLayers, subresourceRange);
     }
 
+    // True when mips can be generated with linear filtered blits, which requires the graphics queue
+    bool canBlitMipmaps(vk::Format format, vk::ImageTiling tiling = vk::ImageTiling::eOptimal);
+    // Generates mips 1 and up of every array layer from mip 0, then leaves the whole image in finalLayout (its current layout when not provided)
+    // Can be recorded straight after updateImage in the same command buffer. Blits each mip from the last when canBlitMipmaps, otherwise dispatches a compute downsampler once
+    // The compute path uses a built-in downsampler needing shaderStorageImageReadWithoutFormat and shaderStorageImageWriteWithoutFormat, unless downsamplePipeline overrides it
+    // An overriding downsample shader is given set 0 binding 0 as an array of 2D array storage images, element i being mip i, and binding 1 as a storage buffer of one zeroed uint per array layer
+    // Each workgroup downsamples a MIPMAP_DOWNSAMPLE_TILE_SIZE tile of mip 0, the last workgroup of a layer to increment its counter continues with the remaining mips
+    // Push constants are MipmapDownsamplePushConstants and z of the dispatch is the array layer. The compute path requires eStorage usage on a 2D image
+    void generateMipmaps(const CommandBuffer& commandBuffer, const Image& image, const ComputePipeline& downsamplePipeline = nullptr, std::optional<vk::ImageLayout> finalLayout = {});
+    void generateMipmaps(const Image& image, const ComputePipeline& downsamplePipeline = nullptr, std::optional<vk::ImageLayout> finalLayout = {});
+
     ava::Image getSwapchainImage(uint32_t imageIndex);
     ava::ImageView getSwapchainImageView(uint32_t imageIndex);
     std::vector<ava::Image> getSwapchainImages();
     std::vector<ava::ImageView> getSwapchainImageViews();
 
     vk::ImageAspectFlags getImageAspectFlagsForFormat(vk::Format format);
+    // eGeneral for storage, then attachment layouts, then eShaderReadOnlyOptimal for sampled and input attachments, then transfer layouts
+    vk::ImageLayout getOptimalImageLayout(vk::ImageUsageFlags usageFlags, vk::Format format);
 }
 
 
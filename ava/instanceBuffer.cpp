@@ -0,0 +1,102 @@
+#include "instanceBuffer.hpp"
+#include "detail/instanceBuffer.hpp"
+
+#include "buffer.hpp"
+#include "detail/buffer.hpp"
+#include "detail/commandBuffer.hpp"
+#include "detail/detail.hpp"
+#include "detail/state.hpp"
+#include "detail/vao.hpp"
+#include <algorithm>
+
+namespace ava
+{
+    static Buffer createInstanceVertexBuffer(const uint32_t stride, const uint32_t capacity)
+    {
+        return createVertexBuffer(static_cast<vk::DeviceSize>(stride) * capacity, {}, MemoryLocation::eCpuToGpu);
+    }
+
+    InstanceBuffer createInstanceBuffer(const VAO& vao, const uint32_t binding, const uint32_t initialCapacity)
+    {
+        AVA_CHECK(detail::State.device, "Cannot create an instance buffer when State's device is invalid");
+        AVA_CHECK(vao != nullptr && !vao->strides.empty(), "Cannot create an instance buffer from an invalid VAO");
+        AVA_CHECK(binding < vao->strides.size(), "Cannot create an instance buffer when binding is out of range of VAO bindings");
+        AVA_CHECK(initialCapacity > 0, "Cannot create an instance buffer with an initial capacity of 0");
+
+        const auto bindingDescription = std::ranges::find(vao->bindingDescriptions, binding, &vk::VertexInputBindingDescription::binding);
+        AVA_CHECK(bindingDescription != vao->bindingDescriptions.end(), "Cannot create an instance buffer when the VAO has no binding " + std::to_string(binding));
+        if (bindingDescription->inputRate != vk::VertexInputRate::eInstance)
+        {
+            AVA_WARN("Instance buffer created for VAO binding " + std::to_string(binding) + " which advances per vertex");
+        }
+
+        const auto outInstanceBuffer = new detail::InstanceBuffer();
+        outInstanceBuffer->stride = vao->strides.at(binding);
+        outInstanceBuffer->binding = binding;
+        for (uint32_t i = 0; i < detail::State.framesInFlight; ++i)
+        {
+            outInstanceBuffer->buffers.push_back(createInstanceVertexBuffer(outInstanceBuffer->stride, initialCapacity));
+            outInstanceBuffer->capacities.push_back(initialCapacity);
+            outInstanceBuffer->instanceCounts.push_back(0);
+        }
+        return outInstanceBuffer;
+    }
+
+    void destroyInstanceBuffer(InstanceBuffer& instanceBuffer)
+    {
+        AVA_CHECK_NO_EXCEPT_RETURN(instanceBuffer != nullptr, "Cannot destroy an invalid instance buffer");
+        AVA_CHECK_NO_EXCEPT_RETURN(detail::State.device, "Cannot destroy instance buffer when State's device is invalid");
+
+        for (auto& buffer : instanceBuffer->buffers)
+        {
+            if (buffer != nullptr)
+            {
+                destroyBuffer(buffer);
+            }
+        }
+
+        delete instanceBuffer;
+        instanceBuffer = nullptr;
+    }
+
+    void updateInstanceBuffer(const InstanceBuffer& instanceBuffer, const void* data, const vk::DeviceSize size)
+    {
+        AVA_CHECK(instanceBuffer != nullptr, "Cannot update an invalid instance buffer");
+        AVA_CHECK(size == 0 || data != nullptr, "Cannot update an instance buffer when data is nullptr");
+        AVA_CHECK((size % instanceBuffer->stride) == 0, "Cannot update an instance buffer when size is not a multiple of the VAO binding's stride (" + std::to_string(instanceBuffer->stride) + ")");
+
+        const auto frame = detail::State.currentFrame;
+        const auto instanceCount = static_cast<uint32_t>(size / instanceBuffer->stride);
+        instanceBuffer->instanceCounts[frame] = instanceCount;
+        if (instanceCount == 0)
+        {
+            return;
+        }
+
+        // This frame's fence has been waited on by startFrame, so its buffer is no longer in use and can be replaced
+        if (instanceCount > instanceBuffer->capacities[frame])
+        {
+            const auto newCapacity = std::max(instanceBuffer->capacities[frame] * 2, instanceCount);
+            destroyBuffer(instanceBuffer->buffers[frame]);
+            instanceBuffer->buffers[frame] = createInstanceVertexBuffer(instanceBuffer->stride, newCapacity);
+            instanceBuffer->capacities[frame] = newCapacity;
+        }
+
+        updateBuffer(instanceBuffer->buffers[frame], data, size, 0);
+    }
+
+    void bindInstanceBuffer(const CommandBuffer& commandBuffer, const InstanceBuffer& instanceBuffer)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot bind an instance buffer to an invalid command buffer");
+        AVA_CHECK(instanceBuffer != nullptr, "Cannot bind an invalid instance buffer");
+        AVA_CHECK(commandBuffer->pipelineCurrentlyBound, "Cannot bind an instance buffer when a pipeline has not yet been bound");
+
+        commandBuffer->commandBuffer.bindVertexBuffers(instanceBuffer->binding, instanceBuffer->buffers[detail::State.currentFrame]->buffer, {0u});
+    }
+
+    uint32_t getInstanceCount(const InstanceBuffer& instanceBuffer)
+    {
+        AVA_CHECK(instanceBuffer != nullptr, "Cannot get the instance count of an invalid instance buffer");
+        return instanceBuffer->instanceCounts[detail::State.currentFrame];
+    }
+}
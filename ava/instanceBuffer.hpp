@@ -0,0 +1,35 @@
+#ifndef AVA_INSTANCEBUFFER_HPP
+#define AVA_INSTANCEBUFFER_HPP
+
+#include "detail/vulkan.hpp"
+#include "types.hpp"
+
+namespace ava
+{
+    // Creates a host visible per-instance vertex buffer for a VAO binding created with VertexAttribute::perInstance
+    [[nodiscard]] InstanceBuffer createInstanceBuffer(const VAO& vao, uint32_t binding, uint32_t initialCapacity = 256);
+    void destroyInstanceBuffer(InstanceBuffer& instanceBuffer);
+
+    // Writes this frame's instances, growing this frame's buffer when needed. Call after startFrame
+    // size must be a multiple of the VAO binding's stride
+    void updateInstanceBuffer(const InstanceBuffer& instanceBuffer, const void* data, vk::DeviceSize size);
+
+    template <typename T>
+    void updateInstanceBuffer(const InstanceBuffer& instanceBuffer, const std::span<T> data)
+    {
+        updateInstanceBuffer(instanceBuffer, data.data(), data.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void updateInstanceBuffer(const InstanceBuffer& instanceBuffer, const std::vector<T>& data)
+    {
+        updateInstanceBuffer(instanceBuffer, data.data(), data.size() * sizeof(T));
+    }
+
+    // Binds this frame's buffer at the instance binding
+    void bindInstanceBuffer(const CommandBuffer& commandBuffer, const InstanceBuffer& instanceBuffer);
+    // Number of instances written this frame, use as the draw's instanceCount
+    uint32_t getInstanceCount(const InstanceBuffer& instanceBuffer);
+}
+
+#endif
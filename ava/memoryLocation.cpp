@@ -12,6 +12,8 @@ namespace ava
             return vma::MemoryUsage::eGpuOnly;
         case MemoryLocation::eCpuToGpu:
             return vma::MemoryUsage::eCpuToGpu;
+        case MemoryLocation::eGpuToCpu:
+            return vma::MemoryUsage::eGpuToCpu;
         case MemoryLocation::eLazyGpu:
             {
                 if (!detail::State.lazyGpuMemoryAvailable)
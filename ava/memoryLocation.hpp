@@ -9,6 +9,7 @@ namespace ava
     {
         eGpuOnly,
         eCpuToGpu,
+        eGpuToCpu, // Persistently mapped for reading back results from the GPU
         eLazyGpu, // Lazily allocated (useful for multi-sample attachments)
     };
 
@@ -0,0 +1,133 @@
+#include "memoryPool.hpp"
+#include "detail/memoryPool.hpp"
+
+#include "detail/detail.hpp"
+#include "detail/state.hpp"
+
+namespace ava
+{
+    namespace detail
+    {
+        bool isMemoryPoolWithinBudget(const MemoryPool* memoryPool)
+        {
+            if (memoryPool == nullptr || memoryPool->budget == 0)
+            {
+                return true;
+            }
+            return State.allocator.getPoolStatistics(memoryPool->pool).allocationBytes <= memoryPool->budget;
+        }
+    }
+
+    MemoryPool createMemoryPool(const MemoryPoolCreationInfo& creationInfo)
+    {
+        AVA_CHECK(detail::State.device, "Cannot create a memory pool when State's device is invalid");
+        AVA_CHECK(detail::State.allocator, "Cannot create a memory pool when State's allocator is invalid");
+        AVA_CHECK(creationInfo.bufferUsage || creationInfo.imageUsage, "Cannot create a memory pool without buffer or image usage to pick its memory type from");
+        AVA_CHECK(creationInfo.maxBlockCount == 0 || creationInfo.minBlockCount <= creationInfo.maxBlockCount, "Cannot create a memory pool when minBlockCount is greater than maxBlockCount");
+
+        vma::AllocationCreateInfo allocationCreateInfo{};
+        allocationCreateInfo.usage = getMemoryUsageFromBufferLocation(creationInfo.memoryLocation);
+
+        // The memory type is picked the same way createBuffer and createImage would for a resource like the ones the pool holds
+        const bool holdsImages = static_cast<bool>(creationInfo.imageUsage);
+        uint32_t memoryTypeIndex;
+        if (holdsImages)
+        {
+            vk::ImageCreateInfo imageCreateInfo{};
+            imageCreateInfo.imageType = vk::ImageType::e2D;
+            imageCreateInfo.extent = vk::Extent3D{1, 1, 1};
+            imageCreateInfo.mipLevels = 1;
+            imageCreateInfo.arrayLayers = 1;
+            imageCreateInfo.format = creationInfo.imageFormat;
+            imageCreateInfo.tiling = vk::ImageTiling::eOptimal;
+            imageCreateInfo.initialLayout = vk::ImageLayout::eUndefined;
+            imageCreateInfo.usage = creationInfo.imageUsage;
+            imageCreateInfo.samples = vk::SampleCountFlagBits::e1;
+            imageCreateInfo.sharingMode = vk::SharingMode::eExclusive;
+            memoryTypeIndex = detail::State.allocator.findMemoryTypeIndexForImageInfo(imageCreateInfo, allocationCreateInfo);
+        }
+        else
+        {
+            vk::BufferCreateInfo bufferCreateInfo{};
+            bufferCreateInfo.size = 1024;
+            bufferCreateInfo.sharingMode = vk::SharingMode::eExclusive;
+            bufferCreateInfo.usage = creationInfo.bufferUsage;
+            if (detail::State.shaderDeviceAddressEnabled)
+            {
+                bufferCreateInfo.usage |= vk::BufferUsageFlagBits::eShaderDeviceAddress;
+            }
+            memoryTypeIndex = detail::State.allocator.findMemoryTypeIndexForBufferInfo(bufferCreateInfo, allocationCreateInfo);
+        }
+
+        vma::PoolCreateInfo poolCreateInfo{};
+        poolCreateInfo.memoryTypeIndex = memoryTypeIndex;
+        poolCreateInfo.blockSize = creationInfo.blockSize;
+        poolCreateInfo.minBlockCount = creationInfo.minBlockCount;
+        poolCreateInfo.maxBlockCount = creationInfo.maxBlockCount;
+        switch (creationInfo.algorithm)
+        {
+        case MemoryPoolAlgorithm::eLinear:
+            poolCreateInfo.flags = vma::PoolCreateFlagBits::eLinearAlgorithm;
+            break;
+        case MemoryPoolAlgorithm::eRing:
+            // VMA's linear algorithm only wraps around as a ring buffer when the pool has a single block
+            poolCreateInfo.flags = vma::PoolCreateFlagBits::eLinearAlgorithm;
+            poolCreateInfo.minBlockCount = 1;
+            poolCreateInfo.maxBlockCount = 1;
+            break;
+        case MemoryPoolAlgorithm::eDefault:
+        default:
+            break;
+        }
+
+        const auto pool = detail::State.allocator.createPool(poolCreateInfo);
+        if (!creationInfo.name.empty())
+        {
+            detail::State.allocator.setPoolName(pool, creationInfo.name.c_str());
+        }
+
+        const auto outPool = new detail::MemoryPool();
+        outPool->pool = pool;
+        outPool->memoryTypeIndex = memoryTypeIndex;
+        outPool->memoryLocation = creationInfo.memoryLocation;
+        outPool->holdsImages = holdsImages;
+        outPool->budget = creationInfo.budget;
+        outPool->name = creationInfo.name.empty() ? "(unnamed)" : creationInfo.name;
+        return outPool;
+    }
+
+    void destroyMemoryPool(MemoryPool& memoryPool)
+    {
+        AVA_CHECK_NO_EXCEPT_RETURN(memoryPool != nullptr, "Cannot destroy an invalid memory pool");
+        AVA_CHECK_NO_EXCEPT_RETURN(detail::State.allocator, "Cannot destroy memory pool when State's allocator is invalid");
+
+        if (memoryPool->pool)
+        {
+            AVA_CHECK_NO_EXCEPT_RETURN(detail::State.allocator.getPoolStatistics(memoryPool->pool).allocationCount == 0, "Cannot destroy memory pool " + memoryPool->name + " while buffers or images created with it still exist");
+            detail::State.allocator.destroyPool(memoryPool->pool);
+        }
+
+        delete memoryPool;
+        memoryPool = nullptr;
+    }
+
+    void setMemoryPoolBudget(const MemoryPool& memoryPool, const vk::DeviceSize budget)
+    {
+        AVA_CHECK(memoryPool != nullptr, "Cannot set the budget of an invalid memory pool");
+        memoryPool->budget = budget;
+    }
+
+    MemoryPoolStatistics getMemoryPoolStatistics(const MemoryPool& memoryPool)
+    {
+        AVA_CHECK(memoryPool != nullptr && memoryPool->pool, "Cannot get statistics of an invalid memory pool");
+
+        const auto poolStatistics = detail::State.allocator.getPoolStatistics(memoryPool->pool);
+        MemoryPoolStatistics statistics{};
+        statistics.blockCount = poolStatistics.blockCount;
+        statistics.allocationCount = poolStatistics.allocationCount;
+        statistics.blockBytes = poolStatistics.blockBytes;
+        statistics.allocationBytes = poolStatistics.allocationBytes;
+        statistics.budget = memoryPool->budget;
+        return statistics;
+    }
+}
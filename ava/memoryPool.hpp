@@ -0,0 +1,48 @@
+#ifndef AVA_MEMORYPOOL_HPP
+#define AVA_MEMORYPOOL_HPP
+
+#include "types.hpp"
+#include "memoryLocation.hpp"
+
+namespace ava
+{
+    enum class MemoryPoolAlgorithm
+    {
+        eDefault, // General purpose, for allocations freed in any order such as meshes and textures
+        eLinear, // Allocations are packed one after another, for transient data freed all at once or in the order it was allocated
+        eRing, // Linear within a single block which wraps around once allocations are freed in order, for per frame data
+    };
+
+    struct MemoryPoolCreationInfo
+    {
+        MemoryLocation memoryLocation = MemoryLocation::eGpuOnly;
+        MemoryPoolAlgorithm algorithm = MemoryPoolAlgorithm::eDefault;
+        vk::BufferUsageFlags bufferUsage = {}; // Usage of the buffers the pool holds, picks its memory type
+        vk::ImageUsageFlags imageUsage = {}; // When not empty, the pool holds images with this usage and imageFormat instead of buffers
+        vk::Format imageFormat = vk::Format::eR8G8B8A8Unorm;
+        vk::DeviceSize blockSize = 0; // 0 to let VMA pick. Fixed block sizes suit allocations of a known size range, such as meshes
+        size_t minBlockCount = 0; // Blocks allocated up front and kept while empty
+        size_t maxBlockCount = 0; // 0 when unlimited, always 1 for eRing
+        vk::DeviceSize budget = 0; // Bytes the pool's allocations can use, 0 when unlimited. Creating a buffer or image over budget throws
+        std::string name;
+    };
+
+    struct MemoryPoolStatistics
+    {
+        uint32_t blockCount;
+        uint32_t allocationCount;
+        vk::DeviceSize blockBytes; // Device memory the pool holds
+        vk::DeviceSize allocationBytes; // Memory used by the pool's allocations
+        vk::DeviceSize budget;
+    };
+
+    // Buffers and images created with a memory pool are kept apart from the default pools and other memory pools, so they do not fragment each other
+    [[nodiscard]] MemoryPool createMemoryPool(const MemoryPoolCreationInfo& creationInfo);
+    // Every buffer and image created with the pool has to be destroyed first
+    void destroyMemoryPool(MemoryPool& memoryPool);
+
+    void setMemoryPoolBudget(const MemoryPool& memoryPool, vk::DeviceSize budget);
+    MemoryPoolStatistics getMemoryPoolStatistics(const MemoryPool& memoryPool);
+}
+
+#endif
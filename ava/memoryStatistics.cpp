@@ -0,0 +1,51 @@
+#include "memoryStatistics.hpp"
+
+#include "detail/detail.hpp"
+#include "detail/state.hpp"
+
+namespace ava
+{
+    MemoryStatistics getMemoryStatistics()
+    {
+        AVA_CHECK(detail::State.physicalDevice, "Cannot get memory statistics when State's physical device is invalid");
+        AVA_CHECK(detail::State.allocator, "Cannot get memory statistics when State's allocator is invalid");
+
+        const auto memoryProperties = detail::State.physicalDevice.getMemoryProperties();
+        std::vector<vma::Budget> budgets(memoryProperties.memoryHeapCount);
+        detail::State.allocator.getHeapBudgets(budgets.data());
+
+        MemoryStatistics statistics{};
+        statistics.memoryBudgetEnabled = detail::State.memoryBudgetEnabled;
+        statistics.heaps.reserve(memoryProperties.memoryHeapCount);
+        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+        {
+            MemoryHeapStatistics heap{};
+            heap.flags = memoryProperties.memoryHeaps[i].flags;
+            heap.size = memoryProperties.memoryHeaps[i].size;
+            heap.budget = budgets[i].budget;
+            heap.usage = budgets[i].usage;
+            heap.blockCount = budgets[i].statistics.blockCount;
+            heap.allocationCount = budgets[i].statistics.allocationCount;
+            heap.blockBytes = budgets[i].statistics.blockBytes;
+            heap.allocationBytes = budgets[i].statistics.allocationBytes;
+            statistics.heaps.push_back(heap);
+        }
+
+        statistics.buffers = detail::State.bufferMemory;
+        statistics.images = detail::State.imageMemory;
+        statistics.accelerationStructures = detail::State.accelerationStructureMemory;
+        statistics.descriptorPools = {detail::State.descriptorPoolCount, 0};
+        statistics.descriptorCount = detail::State.descriptorCount;
+        return statistics;
+    }
+
+    std::string getMemoryStatisticsJson(const bool detailedMap)
+    {
+        AVA_CHECK(detail::State.allocator, "Cannot get memory statistics when State's allocator is invalid");
+
+        char* statisticsString = detail::State.allocator.buildStatsString(detailedMap);
+        std::string json = statisticsString;
+        detail::State.allocator.freeStatsString(statisticsString);
+        return json;
+    }
+}
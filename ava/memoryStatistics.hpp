@@ -0,0 +1,44 @@
+#ifndef AVA_MEMORYSTATISTICS_HPP
+#define AVA_MEMORYSTATISTICS_HPP
+
+#include "detail/vulkan.hpp"
+
+namespace ava
+{
+    struct MemoryHeapStatistics
+    {
+        vk::MemoryHeapFlags flags;
+        vk::DeviceSize size;
+        vk::DeviceSize budget; // Memory the process can use before allocations start failing or evicting
+        vk::DeviceSize usage; // Memory the process uses, including other APIs and allocations made outside of VMA
+        uint32_t blockCount; // Device memory allocations made by VMA
+        uint32_t allocationCount; // Buffers and images placed in those blocks
+        vk::DeviceSize blockBytes;
+        vk::DeviceSize allocationBytes;
+    };
+
+    struct MemoryObjectStatistics
+    {
+        uint32_t count;
+        vk::DeviceSize bytes;
+    };
+
+    struct MemoryStatistics
+    {
+        bool memoryBudgetEnabled; // Whether heap budgets and usage come from VK_EXT_memory_budget, otherwise they are estimated by VMA
+        std::vector<MemoryHeapStatistics> heaps;
+
+        MemoryObjectStatistics buffers; // Including the scratch and input buffers of acceleration structures
+        MemoryObjectStatistics images;
+        MemoryObjectStatistics accelerationStructures; // The storage buffers of BLASes and TLASes
+        MemoryObjectStatistics descriptorPools; // Vulkan descriptor pools, drivers do not report their memory so bytes is always 0
+        uint32_t descriptorCount; // Descriptors the descriptor pools were created with
+    };
+
+    // Heap budgets are refreshed once per frame by startFrame
+    MemoryStatistics getMemoryStatistics();
+    // VMA's statistics as JSON, detailedMap includes every block and allocation. Can be viewed with VMA's GpuMemDumpVis.py
+    std::string getMemoryStatisticsJson(bool detailedMap = true);
+}
+
+#endif
@@ -14,10 +14,19 @@
 #include "raii/ibo.hpp"
 #include "raii/vbo.hpp"
 #include "raii/vibo.hpp"
+#include "raii/instanceBuffer.hpp"
 #include "raii/renderPass.hpp"
 #include "raii/framebuffer.hpp"
 #include "raii/shaders.hpp"
 #include "raii/rayTracing.hpp"
+#include "raii/accelerationStructureCache.hpp"
 #include "raii/rayTracingPipeline.hpp"
+#include "raii/culling.hpp"
+#include "raii/geometryArena.hpp"
+#include "raii/texture.hpp"
+#include "raii/textureStreamer.hpp"
+#include "raii/memoryPool.hpp"
+#include "raii/defragmentation.hpp"
+#include "raii/transientImageSet.hpp"
 
 #endif
@@ -0,0 +1,48 @@
+#include "accelerationStructureCache.hpp"
+
+#include "rayTracing.hpp"
+#include "ava/detail/detail.hpp"
+
+namespace ava::raii
+{
+    void saveAccelerationStructureCache(const std::string& fileName, const std::vector<Pointer<BLAS>>& blases, const std::vector<Pointer<TLAS>>& tlases)
+    {
+        std::vector<ava::BLAS> avaBLASes;
+        avaBLASes.reserve(blases.size());
+        for (const auto& blas : blases)
+        {
+            AVA_CHECK(blas != nullptr && blas->blas != nullptr, "Cannot save an invalid BLAS to an acceleration structure cache");
+            avaBLASes.push_back(blas->blas);
+        }
+
+        std::vector<ava::TLAS> avaTLASes;
+        avaTLASes.reserve(tlases.size());
+        for (const auto& tlas : tlases)
+        {
+            AVA_CHECK(tlas != nullptr && tlas->tlas != nullptr, "Cannot save an invalid TLAS to an acceleration structure cache");
+            avaTLASes.push_back(tlas->tlas);
+        }
+
+        ava::saveAccelerationStructureCache(fileName, avaBLASes, avaTLASes);
+    }
+
+    std::optional<AccelerationStructureCache> loadAccelerationStructureCache(const std::string& fileName)
+    {
+        const auto avaCache = ava::loadAccelerationStructureCache(fileName);
+        if (!avaCache.has_value())
+            return std::nullopt;
+
+        AccelerationStructureCache cache{};
+        cache.blases.reserve(avaCache->blases.size());
+        for (const auto blas : avaCache->blases)
+        {
+            cache.blases.push_back(std::make_shared<BLAS>(blas));
+        }
+        cache.tlases.reserve(avaCache->tlases.size());
+        for (const auto tlas : avaCache->tlases)
+        {
+            cache.tlases.push_back(std::make_shared<TLAS>(tlas));
+        }
+        return cache;
+    }
+}
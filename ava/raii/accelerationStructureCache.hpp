@@ -0,0 +1,20 @@
+#ifndef AVA_RAII_ACCELERATIONSTRUCTURECACHE_HPP
+#define AVA_RAII_ACCELERATIONSTRUCTURECACHE_HPP
+
+#include "types.hpp"
+#include "ava/accelerationStructureCache.hpp"
+
+namespace ava::raii
+{
+    struct AccelerationStructureCache
+    {
+        std::vector<Pointer<BLAS>> blases; // In the order they were saved
+        std::vector<Pointer<TLAS>> tlases;
+    };
+
+    // See ava::saveAccelerationStructureCache and ava::loadAccelerationStructureCache
+    void saveAccelerationStructureCache(const std::string& fileName, const std::vector<Pointer<BLAS>>& blases, const std::vector<Pointer<TLAS>>& tlases);
+    std::optional<AccelerationStructureCache> loadAccelerationStructureCache(const std::string& fileName);
+}
+
+#endif
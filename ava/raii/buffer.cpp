@@ -3,13 +3,14 @@
 #include "ava/detail/buffer.hpp"
 
 #include "commandBuffer.hpp"
+#include "memoryPool.hpp"
 #include "ava/detail/detail.hpp"
 
 namespace ava::raii
 {
-    Buffer::Buffer(const vk::DeviceSize size, const vk::BufferUsageFlags bufferUsage, const MemoryLocation bufferLocation, const vk::DeviceSize alignment)
+    Buffer::Buffer(const vk::DeviceSize size, const vk::BufferUsageFlags bufferUsage, const MemoryLocation bufferLocation, const vk::DeviceSize alignment, const Pointer<MemoryPool>& memoryPool)
     {
-        buffer = ava::createBuffer(size, bufferUsage, bufferLocation, alignment);
+        buffer = ava::createBuffer(size, bufferUsage, bufferLocation, alignment, memoryPool != nullptr ? memoryPool->memoryPool : nullptr);
     }
 
     Buffer::Buffer(const ava::Buffer& existingBuffer)
@@ -67,9 +68,9 @@ namespace ava::raii
         ava::updateBuffer(buffer, commandBuffer->commandBuffer, stagingBuffer->buffer, offset, size);
     }
 
-    Pointer<Buffer> Buffer::create(vk::DeviceSize size, vk::BufferUsageFlags bufferUsage, MemoryLocation bufferLocation, vk::DeviceSize alignment)
+    Pointer<Buffer> Buffer::create(vk::DeviceSize size, vk::BufferUsageFlags bufferUsage, MemoryLocation bufferLocation, vk::DeviceSize alignment, const Pointer<MemoryPool>& memoryPool)
     {
-        return std::make_shared<Buffer>(size, bufferUsage, bufferLocation, alignment);
+        return std::make_shared<Buffer>(size, bufferUsage, bufferLocation, alignment, memoryPool);
     }
 
     Pointer<Buffer> Buffer::createUniform(vk::DeviceSize size, const vk::BufferUsageFlags extraBufferUsage, MemoryLocation bufferLocation, vk::DeviceSize alignment)
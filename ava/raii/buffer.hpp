@@ -11,7 +11,7 @@ namespace ava::raii
     public:
         using Ptr = Pointer<Buffer>;
 
-        Buffer(vk::DeviceSize size, vk::BufferUsageFlags bufferUsage, MemoryLocation bufferLocation = MemoryLocation::eGpuOnly, vk::DeviceSize alignment = 0);
+        Buffer(vk::DeviceSize size, vk::BufferUsageFlags bufferUsage, MemoryLocation bufferLocation = MemoryLocation::eGpuOnly, vk::DeviceSize alignment = 0, const Pointer<MemoryPool>& memoryPool = nullptr);
         explicit Buffer(const ava::Buffer& existingBuffer);
         virtual ~Buffer();
 
@@ -47,7 +47,7 @@ namespace ava::raii
             update(reinterpret_cast<const void*>(data.data()), data.size() * sizeof(T), offset);
         }
 
-        static Pointer<Buffer> create(vk::DeviceSize size, vk::BufferUsageFlags bufferUsage, MemoryLocation bufferLocation = MemoryLocation::eGpuOnly, vk::DeviceSize alignment = 0);
+        static Pointer<Buffer> create(vk::DeviceSize size, vk::BufferUsageFlags bufferUsage, MemoryLocation bufferLocation = MemoryLocation::eGpuOnly, vk::DeviceSize alignment = 0, const Pointer<MemoryPool>& memoryPool = nullptr);
         static Pointer<Buffer> createUniform(vk::DeviceSize size, vk::BufferUsageFlags extraBufferUsage = {}, MemoryLocation = MemoryLocation::eCpuToGpu, vk::DeviceSize alignment = 0);
     };
 }
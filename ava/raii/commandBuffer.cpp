@@ -126,6 +126,32 @@ namespace ava::raii
         ava::drawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
     }
 
+    void CommandBuffer::drawIndirect(const Pointer<Buffer>& buffer, const vk::DeviceSize offset, const uint32_t drawCount, const uint32_t stride) const
+    {
+        AVA_CHECK(buffer != nullptr && buffer->buffer != nullptr, "Cannot drawIndirect with an invalid buffer");
+        ava::drawIndirect(commandBuffer, buffer->buffer, offset, drawCount, stride);
+    }
+
+    void CommandBuffer::drawIndexedIndirect(const Pointer<Buffer>& buffer, const vk::DeviceSize offset, const uint32_t drawCount, const uint32_t stride) const
+    {
+        AVA_CHECK(buffer != nullptr && buffer->buffer != nullptr, "Cannot drawIndexedIndirect with an invalid buffer");
+        ava::drawIndexedIndirect(commandBuffer, buffer->buffer, offset, drawCount, stride);
+    }
+
+    void CommandBuffer::drawIndirectCount(const Pointer<Buffer>& buffer, const vk::DeviceSize offset, const Pointer<Buffer>& countBuffer, const vk::DeviceSize countOffset, const uint32_t maxDrawCount, const uint32_t stride) const
+    {
+        AVA_CHECK(buffer != nullptr && buffer->buffer != nullptr, "Cannot drawIndirectCount with an invalid buffer");
+        AVA_CHECK(countBuffer != nullptr && countBuffer->buffer != nullptr, "Cannot drawIndirectCount with an invalid count buffer");
+        ava::drawIndirectCount(commandBuffer, buffer->buffer, offset, countBuffer->buffer, countOffset, maxDrawCount, stride);
+    }
+
+    void CommandBuffer::drawIndexedIndirectCount(const Pointer<Buffer>& buffer, const vk::DeviceSize offset, const Pointer<Buffer>& countBuffer, const vk::DeviceSize countOffset, const uint32_t maxDrawCount, const uint32_t stride) const
+    {
+        AVA_CHECK(buffer != nullptr && buffer->buffer != nullptr, "Cannot drawIndexedIndirectCount with an invalid buffer");
+        AVA_CHECK(countBuffer != nullptr && countBuffer->buffer != nullptr, "Cannot drawIndexedIndirectCount with an invalid count buffer");
+        ava::drawIndexedIndirectCount(commandBuffer, buffer->buffer, offset, countBuffer->buffer, countOffset, maxDrawCount, stride);
+    }
+
     void CommandBuffer::dispatch(const uint32_t groupCountX, const uint32_t groupCountY, const uint32_t groupCountZ) const
     {
         ava::dispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
@@ -185,6 +211,13 @@ namespace ava::raii
         ava::traceRays(commandBuffer, width, height, depth);
     }
 
+    void CommandBuffer::traceRays(const Pointer<ShaderBindingTable>& shaderBindingTable, const uint32_t width, const uint32_t height, const uint32_t depth) const
+    {
+        AVA_CHECK(shaderBindingTable != nullptr && shaderBindingTable->shaderBindingTable != nullptr, "Cannot trace rays with an invalid shader binding table");
+
+        ava::traceRays(commandBuffer, shaderBindingTable->shaderBindingTable, width, height, depth);
+    }
+
     Pointer<CommandBuffer> CommandBuffer::beginSingleTime(const vk::QueueFlagBits queueType)
     {
         return std::make_shared<CommandBuffer>(ava::beginSingleTimeCommands(queueType));
@@ -41,6 +41,10 @@ namespace ava::raii
         void draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0, uint32_t firstInstance = 0) const;
         // indexCount of 0 means it will draw the number of indices in the currently bound IBO
         void drawIndexed(uint32_t indexCount = 0, uint32_t instanceCount = 1, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0) const;
+        void drawIndirect(const Pointer<Buffer>& buffer, vk::DeviceSize offset = 0, uint32_t drawCount = 1, uint32_t stride = sizeof(vk::DrawIndirectCommand)) const;
+        void drawIndexedIndirect(const Pointer<Buffer>& buffer, vk::DeviceSize offset = 0, uint32_t drawCount = 1, uint32_t stride = sizeof(vk::DrawIndexedIndirectCommand)) const;
+        void drawIndirectCount(const Pointer<Buffer>& buffer, vk::DeviceSize offset, const Pointer<Buffer>& countBuffer, vk::DeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride = sizeof(vk::DrawIndirectCommand)) const;
+        void drawIndexedIndirectCount(const Pointer<Buffer>& buffer, vk::DeviceSize offset, const Pointer<Buffer>& countBuffer, vk::DeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride = sizeof(vk::DrawIndexedIndirectCommand)) const;
         void dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) const;
 
         void bindComputePipeline(const Pointer<ComputePipeline>& pipeline) const;
@@ -65,6 +69,7 @@ namespace ava::raii
 
         void bindRayTracingPipeline(const Pointer<RayTracingPipeline>& rayTracingPipeline) const;
         void traceRays(uint32_t width, uint32_t height, uint32_t depth = 1) const;
+        void traceRays(const Pointer<ShaderBindingTable>& shaderBindingTable, uint32_t width, uint32_t height, uint32_t depth = 1) const;
 
         static Pointer<CommandBuffer> beginSingleTime(vk::QueueFlagBits queueType);
     };
@@ -0,0 +1,94 @@
+#include "culling.hpp"
+#include "ava/culling.hpp"
+
+#include "buffer.hpp"
+#include "commandBuffer.hpp"
+#include "image.hpp"
+#include "shaders.hpp"
+#include "ava/detail/detail.hpp"
+#include <cstring>
+
+namespace ava::raii
+{
+    CullingPass::CullingPass(const ava::CullingPass& existingCullingPass)
+    {
+        AVA_CHECK(existingCullingPass != nullptr, "Cannot create a RAII culling pass from an invalid culling pass");
+
+        cullingPass = existingCullingPass;
+    }
+
+    CullingPass::~CullingPass()
+    {
+        if (cullingPass != nullptr)
+        {
+            ava::destroyCullingPass(cullingPass);
+        }
+    }
+
+    CullingPass::CullingPass(CullingPass&& other) noexcept
+    {
+        cullingPass = other.cullingPass;
+        other.cullingPass = nullptr;
+    }
+
+    CullingPass& CullingPass::operator=(CullingPass&& other) noexcept
+    {
+        if (this != &other)
+        {
+            cullingPass = other.cullingPass;
+            other.cullingPass = nullptr;
+        }
+        return *this;
+    }
+
+    void CullingPass::updateDrawTemplates(const std::vector<CullingDrawTemplate>& drawTemplates) const
+    {
+        ava::updateCullingDrawTemplates(cullingPass, drawTemplates);
+    }
+
+    void CullingPass::record(const Pointer<CommandBuffer>& commandBuffer, const Pointer<Buffer>& instanceBuffer, const uint32_t instanceCount, const float viewProjection[16], const bool frustumCulling, const bool occlusionCulling) const
+    {
+        AVA_CHECK(commandBuffer != nullptr, "Cannot record culling on an invalid command buffer");
+        AVA_CHECK(instanceBuffer != nullptr, "Cannot record culling with an invalid instance buffer");
+
+        CullingParameters parameters{};
+        parameters.instanceBuffer = instanceBuffer->buffer;
+        parameters.instanceCount = instanceCount;
+        std::memcpy(parameters.viewProjection, viewProjection, sizeof(parameters.viewProjection));
+        parameters.frustumCulling = frustumCulling;
+        parameters.occlusionCulling = occlusionCulling;
+        ava::recordCulling(commandBuffer->commandBuffer, cullingPass, parameters);
+    }
+
+    void CullingPass::buildHiZPyramid(const Pointer<CommandBuffer>& commandBuffer, const Pointer<Image>& depthImage, const Pointer<ImageView>& depthImageView, const vk::ImageLayout depthLayout) const
+    {
+        AVA_CHECK(commandBuffer != nullptr, "Cannot build a Hi-Z pyramid on an invalid command buffer");
+        AVA_CHECK(depthImage != nullptr && depthImageView != nullptr, "Cannot build a Hi-Z pyramid from an invalid depth image");
+        ava::buildHiZPyramid(commandBuffer->commandBuffer, cullingPass, depthImage->image, depthImageView->imageView, depthLayout);
+    }
+
+    void CullingPass::draw(const Pointer<CommandBuffer>& commandBuffer) const
+    {
+        AVA_CHECK(commandBuffer != nullptr, "Cannot draw culled instances with an invalid command buffer");
+        ava::drawCulled(commandBuffer->commandBuffer, cullingPass);
+    }
+
+    CullingStatistics CullingPass::getStatistics() const
+    {
+        return ava::getCullingStatistics(cullingPass);
+    }
+
+    Pointer<CullingPass> CullingPass::create(const CullingPassCreationInfo& creationInfo)
+    {
+        return std::make_shared<CullingPass>(ava::createCullingPass(creationInfo));
+    }
+
+    void populateCullingPassCreationInfo(CullingPassCreationInfo& creationInfo, const Pointer<Shader>& cullShader, const Pointer<Shader>& hiZShader, const uint32_t maxInstances, const uint32_t maxDrawTemplates, const bool indexed)
+    {
+        creationInfo.cullShader = cullShader != nullptr ? cullShader->shader : nullptr;
+        creationInfo.hiZShader = hiZShader != nullptr ? hiZShader->shader : nullptr;
+        creationInfo.maxInstances = maxInstances;
+        creationInfo.maxDrawTemplates = maxDrawTemplates;
+        creationInfo.indexed = indexed;
+    }
+}
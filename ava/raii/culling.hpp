@@ -0,0 +1,38 @@
+#ifndef AVA_RAII_CULLING_HPP
+#define AVA_RAII_CULLING_HPP
+
+#include "types.hpp"
+#include "ava/culling.hpp"
+
+namespace ava::raii
+{
+    class CullingPass
+    {
+    public:
+        using Ptr = Pointer<CullingPass>;
+
+        explicit CullingPass(const ava::CullingPass& existingCullingPass);
+        ~CullingPass();
+
+        ava::CullingPass cullingPass;
+
+        CullingPass(const CullingPass& other) = delete;
+        CullingPass& operator=(CullingPass& other) = delete;
+        CullingPass(CullingPass&& other) noexcept;
+        CullingPass& operator=(CullingPass&& other) noexcept;
+
+        void updateDrawTemplates(const std::vector<CullingDrawTemplate>& drawTemplates) const;
+
+        void record(const Pointer<CommandBuffer>& commandBuffer, const Pointer<Buffer>& instanceBuffer, uint32_t instanceCount, const float viewProjection[16], bool frustumCulling = true, bool occlusionCulling = true) const;
+        void buildHiZPyramid(const Pointer<CommandBuffer>& commandBuffer, const Pointer<Image>& depthImage, const Pointer<ImageView>& depthImageView, vk::ImageLayout depthLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal) const;
+        void draw(const Pointer<CommandBuffer>& commandBuffer) const;
+
+        [[nodiscard]] CullingStatistics getStatistics() const;
+
+        static Pointer<CullingPass> create(const CullingPassCreationInfo& creationInfo);
+    };
+
+    void populateCullingPassCreationInfo(CullingPassCreationInfo& creationInfo, const Pointer<Shader>& cullShader, const Pointer<Shader>& hiZShader, uint32_t maxInstances, uint32_t maxDrawTemplates = 1, bool indexed = true);
+}
+
+#endif
@@ -0,0 +1,55 @@
+#include "defragmentation.hpp"
+#include "ava/defragmentation.hpp"
+
+#include "commandBuffer.hpp"
+#include "ava/detail/detail.hpp"
+
+namespace ava::raii
+{
+    Defragmentation::Defragmentation(const ava::Defragmentation& existingDefragmentation)
+    {
+        AVA_CHECK(existingDefragmentation != nullptr, "Cannot create a RAII defragmentation from an invalid defragmentation");
+
+        defragmentation = existingDefragmentation;
+    }
+
+    Defragmentation::~Defragmentation()
+    {
+        if (defragmentation != nullptr)
+        {
+            ava::endDefragmentation(defragmentation);
+        }
+    }
+
+    Defragmentation::Defragmentation(Defragmentation&& other) noexcept
+    {
+        defragmentation = other.defragmentation;
+        other.defragmentation = nullptr;
+    }
+
+    Defragmentation& Defragmentation::operator=(Defragmentation&& other) noexcept
+    {
+        if (this != &other)
+        {
+            defragmentation = other.defragmentation;
+            other.defragmentation = nullptr;
+        }
+        return *this;
+    }
+
+    bool Defragmentation::defragment(const Pointer<CommandBuffer>& commandBuffer) const
+    {
+        AVA_CHECK(commandBuffer != nullptr, "Cannot defragment memory with an invalid command buffer");
+        return ava::defragmentMemory(commandBuffer->commandBuffer, defragmentation);
+    }
+
+    DefragmentationStatistics Defragmentation::getStatistics() const
+    {
+        return ava::getDefragmentationStatistics(defragmentation);
+    }
+
+    Pointer<Defragmentation> Defragmentation::create(const DefragmentationCreationInfo& creationInfo)
+    {
+        return std::make_shared<Defragmentation>(ava::beginDefragmentation(creationInfo));
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef AVA_RAII_DEFRAGMENTATION_HPP
+#define AVA_RAII_DEFRAGMENTATION_HPP
+
+#include "types.hpp"
+#include "ava/defragmentation.hpp"
+
+namespace ava::raii
+{
+    class Defragmentation
+    {
+    public:
+        using Ptr = Pointer<Defragmentation>;
+
+        explicit Defragmentation(const ava::Defragmentation& existingDefragmentation);
+        ~Defragmentation();
+
+        ava::Defragmentation defragmentation;
+
+        Defragmentation(const Defragmentation& other) = delete;
+        Defragmentation& operator=(Defragmentation& other) = delete;
+        Defragmentation(Defragmentation&& other) noexcept;
+        Defragmentation& operator=(Defragmentation&& other) noexcept;
+
+        // See ava::defragmentMemory
+        bool defragment(const Pointer<CommandBuffer>& commandBuffer) const;
+        [[nodiscard]] DefragmentationStatistics getStatistics() const;
+
+        static Pointer<Defragmentation> create(const DefragmentationCreationInfo& creationInfo = {});
+    };
+}
+
+#endif
@@ -10,4 +10,10 @@ namespace ava::raii
         auto cbRet = ava::startFrame(currentFrame, imageIndex);
         return cbRet.has_value() ? std::make_shared<CommandBuffer>(cbRet.value()) : nullptr;
     }
+
+    Pointer<CommandBuffer> tryStartFrame(uint32_t* currentFrame, uint32_t* imageIndex)
+    {
+        auto cbRet = ava::tryStartFrame(currentFrame, imageIndex);
+        return cbRet.has_value() ? std::make_shared<CommandBuffer>(cbRet.value()) : nullptr;
+    }
 }
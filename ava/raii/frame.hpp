@@ -2,11 +2,23 @@
 #define AVA_RAII_FRAME_HPP
 
 #include "types.hpp"
+#include "ava/frame.hpp"
+#include <type_traits>
 
 namespace ava::raii
 {
     // Returns nullptr on failure
     [[nodiscard]] Pointer<CommandBuffer> startFrame(uint32_t* currentFrame = nullptr, uint32_t* imageIndex = nullptr);
+    // Returns nullptr on failure or when the frame is not ready yet, never blocks
+    [[nodiscard]] Pointer<CommandBuffer> tryStartFrame(uint32_t* currentFrame = nullptr, uint32_t* imageIndex = nullptr);
+
+    // Moves object into the retired objects, keeping it alive until every frame submitted so far has completed
+    // e.g. ava::raii::retire(std::move(framebuffers)) before recreating swapchain framebuffers
+    template <typename T>
+    void retire(T&& object)
+    {
+        ava::retireObject(std::make_shared<std::decay_t<T>>(std::forward<T>(object)));
+    }
 }
 
 #endif
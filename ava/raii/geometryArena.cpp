@@ -0,0 +1,132 @@
+#include "geometryArena.hpp"
+#include "ava/geometryArena.hpp"
+
+#include "commandBuffer.hpp"
+#include "vao.hpp"
+#include "ava/detail/detail.hpp"
+
+namespace ava::raii
+{
+    GeometryArena::GeometryArena(const ava::GeometryArena& existingArena)
+    {
+        AVA_CHECK(existingArena != nullptr, "Cannot create a RAII geometry arena from an invalid geometry arena");
+
+        arena = existingArena;
+    }
+
+    GeometryArena::~GeometryArena()
+    {
+        if (arena != nullptr)
+        {
+            ava::destroyGeometryArena(arena);
+        }
+    }
+
+    GeometryArena::GeometryArena(GeometryArena&& other) noexcept
+    {
+        arena = other.arena;
+        other.arena = nullptr;
+    }
+
+    GeometryArena& GeometryArena::operator=(GeometryArena&& other) noexcept
+    {
+        if (this != &other)
+        {
+            arena = other.arena;
+            other.arena = nullptr;
+        }
+        return *this;
+    }
+
+    Pointer<ArenaMesh> GeometryArena::allocateMesh(const void* vertexData, const vk::DeviceSize vertexDataSize, const void* indexData, const uint32_t indexCount)
+    {
+        return std::make_shared<ArenaMesh>(shared_from_this(), ava::allocateArenaMesh(arena, vertexData, vertexDataSize, indexData, indexCount));
+    }
+
+    Pointer<ArenaMesh> GeometryArena::allocateMesh(const void* vertexData, const vk::DeviceSize vertexDataSize, const void* indexData, const uint32_t indexCount, const vk::IndexType indexType)
+    {
+        return std::make_shared<ArenaMesh>(shared_from_this(), ava::allocateArenaMesh(arena, vertexData, vertexDataSize, indexData, indexCount, indexType));
+    }
+
+    void GeometryArena::bind(const Pointer<CommandBuffer>& commandBuffer) const
+    {
+        AVA_CHECK(commandBuffer != nullptr, "Cannot bind a geometry arena to an invalid command buffer");
+        ava::bindGeometryArena(commandBuffer->commandBuffer, arena);
+    }
+
+    void GeometryArena::compact() const
+    {
+        ava::compactGeometryArena(arena);
+    }
+
+    GeometryArenaStatistics GeometryArena::getStatistics() const
+    {
+        return ava::getGeometryArenaStatistics(arena);
+    }
+
+    Pointer<GeometryArena> GeometryArena::create(const GeometryArenaCreationInfo& creationInfo)
+    {
+        return std::make_shared<GeometryArena>(ava::createGeometryArena(creationInfo));
+    }
+
+    Pointer<GeometryArena> GeometryArena::create(const Pointer<VAO>& vao, const uint32_t binding, const vk::IndexType indexType)
+    {
+        AVA_CHECK(vao != nullptr && vao->vao != nullptr, "Cannot create a geometry arena with an invalid VAO");
+
+        GeometryArenaCreationInfo creationInfo{};
+        creationInfo.vao = vao->vao;
+        creationInfo.binding = binding;
+        creationInfo.indexType = indexType;
+        return create(creationInfo);
+    }
+
+    ArenaMesh::ArenaMesh(const Pointer<GeometryArena>& arenaAllocatedFrom, const ava::ArenaMesh& existingMesh)
+    {
+        AVA_CHECK(arenaAllocatedFrom != nullptr && arenaAllocatedFrom->arena != nullptr, "Cannot create a RAII arena mesh from an invalid geometry arena");
+        AVA_CHECK(existingMesh != nullptr, "Cannot create a RAII arena mesh from an invalid arena mesh");
+
+        allocatedFromArena = arenaAllocatedFrom;
+        mesh = existingMesh;
+    }
+
+    ArenaMesh::~ArenaMesh()
+    {
+        // Meshes are freed alongside their arena, so only free while the arena is alive
+        if (mesh != nullptr)
+        {
+            if (const auto arena = allocatedFromArena.lock(); arena != nullptr && arena->arena != nullptr)
+            {
+                ava::freeArenaMesh(mesh);
+            }
+        }
+    }
+
+    ArenaMesh::ArenaMesh(ArenaMesh&& other) noexcept
+    {
+        allocatedFromArena = std::move(other.allocatedFromArena);
+        mesh = other.mesh;
+        other.mesh = nullptr;
+    }
+
+    ArenaMesh& ArenaMesh::operator=(ArenaMesh&& other) noexcept
+    {
+        if (this != &other)
+        {
+            allocatedFromArena = std::move(other.allocatedFromArena);
+            mesh = other.mesh;
+            other.mesh = nullptr;
+        }
+        return *this;
+    }
+
+    void ArenaMesh::draw(const Pointer<CommandBuffer>& commandBuffer, const uint32_t instanceCount, const uint32_t firstInstance) const
+    {
+        AVA_CHECK(commandBuffer != nullptr, "Cannot draw an arena mesh with an invalid command buffer");
+        ava::drawArenaMesh(commandBuffer->commandBuffer, mesh, instanceCount, firstInstance);
+    }
+
+    vk::DrawIndexedIndirectCommand ArenaMesh::getDrawCommand(const uint32_t instanceCount, const uint32_t firstInstance) const
+    {
+        return ava::getArenaMeshDrawCommand(mesh, instanceCount, firstInstance);
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef AVA_RAII_GEOMETRYARENA_HPP
+#define AVA_RAII_GEOMETRYARENA_HPP
+
+#include "types.hpp"
+#include "ava/geometryArena.hpp"
+
+namespace ava::raii
+{
+    class GeometryArena : public std::enable_shared_from_this<GeometryArena>
+    {
+    public:
+        using Ptr = Pointer<GeometryArena>;
+
+        explicit GeometryArena(const ava::GeometryArena& existingArena);
+        ~GeometryArena();
+
+        ava::GeometryArena arena;
+
+        GeometryArena(const GeometryArena& other) = delete;
+        GeometryArena& operator=(GeometryArena& other) = delete;
+        GeometryArena(GeometryArena&& other) noexcept;
+        GeometryArena& operator=(GeometryArena&& other) noexcept;
+
+        [[nodiscard]] Pointer<ArenaMesh> allocateMesh(const void* vertexData, vk::DeviceSize vertexDataSize, const void* indexData, uint32_t indexCount);
+        [[nodiscard]] Pointer<ArenaMesh> allocateMesh(const void* vertexData, vk::DeviceSize vertexDataSize, const void* indexData, uint32_t indexCount, vk::IndexType indexType);
+
+        template <typename V, typename I>
+        [[nodiscard]] Pointer<ArenaMesh> allocateMesh(const std::vector<V>& vertices, const std::vector<I>& indices)
+        {
+            static_assert(std::is_same_v<I, uint32_t> || std::is_same_v<I, uint16_t>, "Arena mesh indices must be uint32_t or uint16_t");
+            constexpr auto indexType = std::is_same_v<I, uint32_t> ? vk::IndexType::eUint32 : vk::IndexType::eUint16;
+            return allocateMesh(vertices.data(), vertices.size() * sizeof(V), indices.data(), static_cast<uint32_t>(indices.size()), indexType);
+        }
+
+        void bind(const Pointer<CommandBuffer>& commandBuffer) const;
+        void compact() const;
+
+        [[nodiscard]] GeometryArenaStatistics getStatistics() const;
+
+        static Pointer<GeometryArena> create(const GeometryArenaCreationInfo& creationInfo);
+        static Pointer<GeometryArena> create(const Pointer<VAO>& vao, uint32_t binding = 0, vk::IndexType indexType = vk::IndexType::eUint32);
+    };
+
+    class ArenaMesh
+    {
+    public:
+        using Ptr = Pointer<ArenaMesh>;
+
+        explicit ArenaMesh(const Pointer<GeometryArena>& arenaAllocatedFrom, const ava::ArenaMesh& existingMesh);
+        ~ArenaMesh();
+
+        WeakPointer<GeometryArena> allocatedFromArena;
+        ava::ArenaMesh mesh;
+
+        ArenaMesh(const ArenaMesh& other) = delete;
+        ArenaMesh& operator=(ArenaMesh& other) = delete;
+        ArenaMesh(ArenaMesh&& other) noexcept;
+        ArenaMesh& operator=(ArenaMesh&& other) noexcept;
+
+        void draw(const Pointer<CommandBuffer>& commandBuffer, uint32_t instanceCount = 1, uint32_t firstInstance = 0) const;
+        [[nodiscard]] vk::DrawIndexedIndirectCommand getDrawCommand(uint32_t instanceCount = 1, uint32_t firstInstance = 0) const;
+    };
+}
+
+#endif
@@ -4,6 +4,8 @@
 
 #include "buffer.hpp"
 #include "commandBuffer.hpp"
+#include "compute.hpp"
+#include "memoryPool.hpp"
 #include "ava/detail/detail.hpp"
 
 namespace ava::raii
@@ -68,19 +70,31 @@ namespace ava::raii
         ava::updateImage(image, data, dataSize, aspectFlags, subresourceLayers, subresourceRange);
     }
 
+    void Image::generateMipmaps(const Pointer<CommandBuffer>& commandBuffer, const Pointer<ComputePipeline>& downsamplePipeline, const std::optional<vk::ImageLayout> finalLayout) const
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot generate mipmaps with an invalid command buffer");
+        ava::generateMipmaps(commandBuffer->commandBuffer, image, downsamplePipeline != nullptr ? downsamplePipeline->pipeline : nullptr, finalLayout);
+    }
+
+    void Image::generateMipmaps(const Pointer<ComputePipeline>& downsamplePipeline, const std::optional<vk::ImageLayout> finalLayout) const
+    {
+        ava::generateMipmaps(image, downsamplePipeline != nullptr ? downsamplePipeline->pipeline : nullptr, finalLayout);
+    }
+
     Pointer<ImageView> Image::createImageView(const vk::ImageAspectFlags aspectFlags, const vk::ImageViewType imageViewType, const std::optional<vk::Format> format, const std::optional<vk::ImageSubresourceRange>& subresourceRange) const
     {
         return std::make_shared<ImageView>(ava::createImageView(image, aspectFlags, imageViewType, format, subresourceRange));
     }
 
-    Pointer<Image> Image::create(const vk::Extent3D extent, const vk::Format format, const vk::ImageUsageFlags usageFlags, const vk::ImageType imageType, const vk::ImageTiling tiling, const uint32_t mipLevels, const uint32_t arrayLayers, const vk::SampleCountFlagBits samples, const MemoryLocation memoryLocation)
+    Pointer<Image> Image::create(const vk::Extent3D extent, const vk::Format format, const vk::ImageUsageFlags usageFlags, const vk::ImageType imageType, const vk::ImageTiling tiling, const uint32_t mipLevels, const uint32_t arrayLayers, const vk::SampleCountFlagBits samples, const MemoryLocation memoryLocation, const InitialImageLayout initialLayout,
+                                 const vk::ImageCreateFlags createFlags, const Pointer<MemoryPool>& memoryPool)
     {
-        return std::make_shared<Image>(ava::createImage(extent, format, usageFlags, imageType, tiling, mipLevels, arrayLayers, samples, memoryLocation));
+        return std::make_shared<Image>(ava::createImage(extent, format, usageFlags, imageType, tiling, mipLevels, arrayLayers, samples, memoryLocation, initialLayout, createFlags, memoryPool != nullptr ? memoryPool->memoryPool : nullptr));
     }
 
-    Pointer<Image> Image::create2D(const vk::Extent2D extent, const vk::Format format, const vk::ImageUsageFlags usageFlags, const uint32_t mipLevels)
+    Pointer<Image> Image::create2D(const vk::Extent2D extent, const vk::Format format, const vk::ImageUsageFlags usageFlags, const uint32_t mipLevels, const InitialImageLayout initialLayout)
     {
-        return std::make_shared<Image>(ava::createImage2D(extent, format, usageFlags, mipLevels));
+        return std::make_shared<Image>(ava::createImage2D(extent, format, usageFlags, mipLevels, initialLayout));
     }
 
     ImageView::ImageView(const ava::ImageView& existingImageView)
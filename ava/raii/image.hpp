@@ -43,13 +43,18 @@ namespace ava::raii
             update(data.data(), data.size() * sizeof(T), aspectFlags, subresourceLayers, subresourceRange);
         }
 
+        // Generates mips 1 and up from mip 0, blitting when the format supports it and otherwise dispatching the built-in downsampler or downsamplePipeline
+        void generateMipmaps(const Pointer<CommandBuffer>& commandBuffer, const Pointer<ComputePipeline>& downsamplePipeline = nullptr, std::optional<vk::ImageLayout> finalLayout = {}) const;
+        void generateMipmaps(const Pointer<ComputePipeline>& downsamplePipeline = nullptr, std::optional<vk::ImageLayout> finalLayout = {}) const;
+
         [[nodiscard]] Pointer<ImageView> createImageView(vk::ImageAspectFlags aspectFlags = vk::ImageAspectFlagBits::eColor, vk::ImageViewType imageViewType = vk::ImageViewType::e2D, std::optional<vk::Format> format = {}, const std::optional<vk::ImageSubresourceRange>& subresourceRange = {}) const;
 
         // Generic and more advanced image creation
         [[nodiscard]] static Pointer<Image> create(vk::Extent3D extent, vk::Format format, vk::ImageUsageFlags usageFlags = DEFAULT_IMAGE_SAMPLED_USAGE_FLAGS, vk::ImageType imageType = vk::ImageType::e2D, vk::ImageTiling tiling = vk::ImageTiling::eOptimal,
-                                                   uint32_t mipLevels = 1, uint32_t arrayLayers = 1, vk::SampleCountFlagBits samples = vk::SampleCountFlagBits::e1, MemoryLocation memoryLocation = MemoryLocation::eGpuOnly);
+                                                   uint32_t mipLevels = 1, uint32_t arrayLayers = 1, vk::SampleCountFlagBits samples = vk::SampleCountFlagBits::e1, MemoryLocation memoryLocation = MemoryLocation::eGpuOnly, InitialImageLayout initialLayout = InitialImageLayout::eGeneral,
+                                                   vk::ImageCreateFlags createFlags = {}, const Pointer<MemoryPool>& memoryPool = nullptr);
         // Simpler image creation
-        [[nodiscard]] static Pointer<Image> create2D(vk::Extent2D extent, vk::Format format, vk::ImageUsageFlags usageFlags = DEFAULT_IMAGE_SAMPLED_USAGE_FLAGS, uint32_t mipLevels = 1);
+        [[nodiscard]] static Pointer<Image> create2D(vk::Extent2D extent, vk::Format format, vk::ImageUsageFlags usageFlags = DEFAULT_IMAGE_SAMPLED_USAGE_FLAGS, uint32_t mipLevels = 1, InitialImageLayout initialLayout = InitialImageLayout::eGeneral);
     };
 
     class ImageView
@@ -0,0 +1,63 @@
+#include "instanceBuffer.hpp"
+#include "ava/instanceBuffer.hpp"
+
+#include "commandBuffer.hpp"
+#include "vao.hpp"
+#include "ava/detail/detail.hpp"
+
+namespace ava::raii
+{
+    InstanceBuffer::InstanceBuffer(const ava::InstanceBuffer& existingInstanceBuffer)
+    {
+        AVA_CHECK(existingInstanceBuffer != nullptr, "Cannot create a RAII instance buffer from an invalid instance buffer");
+
+        instanceBuffer = existingInstanceBuffer;
+    }
+
+    InstanceBuffer::~InstanceBuffer()
+    {
+        if (instanceBuffer != nullptr)
+        {
+            ava::destroyInstanceBuffer(instanceBuffer);
+        }
+    }
+
+    InstanceBuffer::InstanceBuffer(InstanceBuffer&& other) noexcept
+    {
+        instanceBuffer = other.instanceBuffer;
+        other.instanceBuffer = nullptr;
+    }
+
+    InstanceBuffer& InstanceBuffer::operator=(InstanceBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            instanceBuffer = other.instanceBuffer;
+            other.instanceBuffer = nullptr;
+        }
+        return *this;
+    }
+
+    void InstanceBuffer::update(const void* data, const vk::DeviceSize size) const
+    {
+        ava::updateInstanceBuffer(instanceBuffer, data, size);
+    }
+
+    void InstanceBuffer::bind(const Pointer<CommandBuffer>& commandBuffer) const
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot bind an instance buffer to an invalid command buffer");
+        ava::bindInstanceBuffer(commandBuffer->commandBuffer, instanceBuffer);
+    }
+
+    uint32_t InstanceBuffer::getInstanceCount() const
+    {
+        return ava::getInstanceCount(instanceBuffer);
+    }
+
+    Pointer<InstanceBuffer> InstanceBuffer::create(const Pointer<VAO>& vao, const uint32_t binding, const uint32_t initialCapacity)
+    {
+        AVA_CHECK(vao != nullptr && vao->vao != nullptr, "Cannot create an instance buffer with an invalid VAO");
+
+        return std::make_shared<InstanceBuffer>(ava::createInstanceBuffer(vao->vao, binding, initialCapacity));
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef AVA_RAII_INSTANCEBUFFER_HPP
+#define AVA_RAII_INSTANCEBUFFER_HPP
+
+#include "types.hpp"
+
+namespace ava::raii
+{
+    class InstanceBuffer
+    {
+    public:
+        using Ptr = Pointer<InstanceBuffer>;
+
+        explicit InstanceBuffer(const ava::InstanceBuffer& existingInstanceBuffer);
+        ~InstanceBuffer();
+
+        ava::InstanceBuffer instanceBuffer;
+
+        InstanceBuffer(const InstanceBuffer& other) = delete;
+        InstanceBuffer& operator=(InstanceBuffer& other) = delete;
+        InstanceBuffer(InstanceBuffer&& other) noexcept;
+        InstanceBuffer& operator=(InstanceBuffer&& other) noexcept;
+
+        void update(const void* data, vk::DeviceSize size) const;
+
+        template <typename T>
+        void update(const std::span<T> data) const
+        {
+            update(data.data(), data.size() * sizeof(T));
+        }
+
+        template <typename T>
+        void update(const std::vector<T>& data) const
+        {
+            update(data.data(), data.size() * sizeof(T));
+        }
+
+        void bind(const Pointer<CommandBuffer>& commandBuffer) const;
+        [[nodiscard]] uint32_t getInstanceCount() const;
+
+        static Pointer<InstanceBuffer> create(const Pointer<VAO>& vao, uint32_t binding, uint32_t initialCapacity = 256);
+    };
+}
+
+#endif
@@ -0,0 +1,53 @@
+#include "memoryPool.hpp"
+#include "ava/memoryPool.hpp"
+
+#include "ava/detail/detail.hpp"
+
+namespace ava::raii
+{
+    MemoryPool::MemoryPool(const ava::MemoryPool& existingMemoryPool)
+    {
+        AVA_CHECK(existingMemoryPool != nullptr, "Cannot create a RAII memory pool from an invalid memory pool");
+
+        memoryPool = existingMemoryPool;
+    }
+
+    MemoryPool::~MemoryPool()
+    {
+        if (memoryPool != nullptr)
+        {
+            ava::destroyMemoryPool(memoryPool);
+        }
+    }
+
+    MemoryPool::MemoryPool(MemoryPool&& other) noexcept
+    {
+        memoryPool = other.memoryPool;
+        other.memoryPool = nullptr;
+    }
+
+    MemoryPool& MemoryPool::operator=(MemoryPool&& other) noexcept
+    {
+        if (this != &other)
+        {
+            memoryPool = other.memoryPool;
+            other.memoryPool = nullptr;
+        }
+        return *this;
+    }
+
+    void MemoryPool::setBudget(const vk::DeviceSize budget) const
+    {
+        ava::setMemoryPoolBudget(memoryPool, budget);
+    }
+
+    MemoryPoolStatistics MemoryPool::getStatistics() const
+    {
+        return ava::getMemoryPoolStatistics(memoryPool);
+    }
+
+    Pointer<MemoryPool> MemoryPool::create(const MemoryPoolCreationInfo& creationInfo)
+    {
+        return std::make_shared<MemoryPool>(ava::createMemoryPool(creationInfo));
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef AVA_RAII_MEMORYPOOL_HPP
+#define AVA_RAII_MEMORYPOOL_HPP
+
+#include "types.hpp"
+#include "ava/memoryPool.hpp"
+
+namespace ava::raii
+{
+    class MemoryPool
+    {
+    public:
+        using Ptr = Pointer<MemoryPool>;
+
+        explicit MemoryPool(const ava::MemoryPool& existingMemoryPool);
+        ~MemoryPool();
+
+        ava::MemoryPool memoryPool;
+
+        MemoryPool(const MemoryPool& other) = delete;
+        MemoryPool& operator=(MemoryPool& other) = delete;
+        MemoryPool(MemoryPool&& other) noexcept;
+        MemoryPool& operator=(MemoryPool&& other) noexcept;
+
+        void setBudget(vk::DeviceSize budget) const;
+        [[nodiscard]] MemoryPoolStatistics getStatistics() const;
+
+        static Pointer<MemoryPool> create(const MemoryPoolCreationInfo& creationInfo);
+    };
+}
+
+#endif
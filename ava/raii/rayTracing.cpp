@@ -3,6 +3,8 @@
 #include "ava/rayTracing.hpp"
 #include "ava/detail/rayTracing.hpp"
 
+#include "buffer.hpp"
+#include "commandBuffer.hpp"
 #include "ibo.hpp"
 #include "vbo.hpp"
 #include "vibo.hpp"
@@ -29,6 +31,23 @@ namespace ava::raii
         blas = ava::createBottomLevelAccelerationStructure(vbo->vbo, {});
     }
 
+    BLAS::BLAS(const std::vector<BLASGeometry>& geometries)
+    {
+        blas = ava::createBottomLevelAccelerationStructure(geometries);
+    }
+
+    BLAS::BLAS(const Pointer<Buffer>& aabbBuffer, const uint32_t aabbCount, const vk::DeviceSize aabbOffset, const uint32_t aabbStride, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        AVA_CHECK(aabbBuffer != nullptr && aabbBuffer->buffer != nullptr, "Cannot create a BLAS from an invalid AABB buffer");
+        blas = ava::createBottomLevelAccelerationStructure(aabbBuffer->buffer, aabbCount, aabbOffset, aabbStride, geometryFlags);
+    }
+
+    BLAS::BLAS(const ava::BLAS existingBLAS)
+    {
+        AVA_CHECK(existingBLAS != nullptr, "Cannot create a RAII BLAS from an invalid BLAS");
+        blas = existingBLAS;
+    }
+
     BLAS::~BLAS()
     {
         if (blas != nullptr)
@@ -58,11 +77,67 @@ namespace ava::raii
         ava::rebuildBLAS(blas, buildFlags, geometryFlags);
     }
 
+    void BLAS::rebuild(const Pointer<CommandBuffer>& commandBuffer, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags) const
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot rebuild BLAS with an invalid command buffer");
+        ava::rebuildBLAS(commandBuffer->commandBuffer, blas, buildFlags, geometryFlags);
+    }
+
+    void BLAS::refit(const Pointer<CommandBuffer>& commandBuffer) const
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot refit BLAS with an invalid command buffer");
+        ava::refitBLASes(commandBuffer->commandBuffer, {blas});
+    }
+
+    static std::vector<ava::BLAS> getAvaBLASes(const std::vector<Pointer<BLAS>>& blases)
+    {
+        std::vector<ava::BLAS> avaBLASes;
+        avaBLASes.reserve(blases.size());
+        for (const auto& blas : blases)
+        {
+            AVA_CHECK(blas != nullptr && blas->blas != nullptr, "Cannot build an invalid BLAS");
+            avaBLASes.push_back(blas->blas);
+        }
+        return avaBLASes;
+    }
+
+    void BLAS::buildBatch(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<BLAS>>& blases, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot build BLASes with an invalid command buffer");
+        ava::buildBLASes(commandBuffer->commandBuffer, getAvaBLASes(blases), buildFlags, geometryFlags);
+    }
+
+    void BLAS::buildBatch(const std::vector<Pointer<BLAS>>& blases, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        ava::buildBLASes(getAvaBLASes(blases), buildFlags, geometryFlags);
+    }
+
+    void BLAS::refitBatch(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<BLAS>>& blases)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot refit BLASes with an invalid command buffer");
+        ava::refitBLASes(commandBuffer->commandBuffer, getAvaBLASes(blases));
+    }
+
+    void BLAS::refitBatch(const std::vector<Pointer<BLAS>>& blases)
+    {
+        ava::refitBLASes(getAvaBLASes(blases));
+    }
+
+    BLASCompactionStatistics BLAS::compactBatch(const std::vector<Pointer<BLAS>>& blases, const uint32_t batchSize)
+    {
+        return ava::compactBLASes(getAvaBLASes(blases), batchSize);
+    }
+
     Pointer<BLASInstance> BLAS::createInstance(const int32_t instanceCustomIndex, const uint8_t mask) const
     {
         return std::make_shared<BLASInstance>(ava::createBLASInstance(blas, instanceCustomIndex, mask));
     }
 
+    vk::DeviceSize BLAS::getAccelerationStructureSize() const
+    {
+        return ava::getAccelerationStructureSize(blas);
+    }
+
     vk::DeviceAddress BLAS::getVertexBufferAddress() const
     {
         return ava::getVertexBufferAddress(blas);
@@ -88,6 +163,28 @@ namespace ava::raii
         return std::make_shared<BLAS>(vbo, ibo);
     }
 
+    Pointer<BLAS> BLAS::create(const std::vector<BLASGeometry>& geometries)
+    {
+        return std::make_shared<BLAS>(geometries);
+    }
+
+    Pointer<BLAS> BLAS::create(const Pointer<Buffer>& aabbBuffer, const uint32_t aabbCount, const vk::DeviceSize aabbOffset, const uint32_t aabbStride, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        return std::make_shared<BLAS>(aabbBuffer, aabbCount, aabbOffset, aabbStride, geometryFlags);
+    }
+
+    BLASGeometry BLAS::getGeometry(const Pointer<VBO>& vbo, const Pointer<IBO>& ibo, const uint32_t positionOffset, const vk::Format positionFormat)
+    {
+        AVA_CHECK(vbo != nullptr && vbo->vbo != nullptr, "Cannot get BLAS geometry from an invalid VBO");
+        return ava::getBLASGeometry(vbo->vbo, (ibo != nullptr) ? ibo->ibo : nullptr, positionOffset, positionFormat);
+    }
+
+    BLASGeometry BLAS::getGeometry(const Pointer<VIBO>& vibo, const uint32_t positionOffset, const vk::Format positionFormat)
+    {
+        AVA_CHECK(vibo != nullptr && vibo->vibo != nullptr, "Cannot get BLAS geometry from an invalid VIBO");
+        return ava::getBLASGeometry(vibo->vibo, positionOffset, positionFormat);
+    }
+
     BLASInstance::BLASInstance(const Pointer<BLAS>& blas, const int32_t instanceCustomIndex, const uint8_t mask)
     {
         AVA_CHECK(blas != nullptr, "Cannot create a RAII BLAS instance from an invalid BLAS");
@@ -129,6 +226,28 @@ namespace ava::raii
         ava::updateTransformMatrix(blasInstance, transformMatrix);
     }
 
+    void BLASInstance::updateShaderBindingTableRecordOffset(const uint32_t recordOffset) const
+    {
+        ava::updateShaderBindingTableRecordOffset(blasInstance, recordOffset);
+    }
+
+    void BLASInstance::updateBoundingSphere(const float center[3], const float radius) const
+    {
+        ava::updateBoundingSphere(blasInstance, center, radius);
+    }
+
+    void BLASInstance::updateLODs(const std::vector<std::pair<Pointer<BLAS>, float>>& lods) const
+    {
+        std::vector<BLASInstanceLOD> avaLODs;
+        avaLODs.reserve(lods.size());
+        for (const auto& [blas, minDistance] : lods)
+        {
+            AVA_CHECK(blas != nullptr, "Cannot update LODs of a BLAS instance with an invalid LOD BLAS");
+            avaLODs.push_back({blas->blas, minDistance});
+        }
+        ava::updateLODs(blasInstance, avaLODs);
+    }
+
     Pointer<BLASInstance> BLASInstance::create(const Pointer<BLAS>& blas, const int32_t instanceCustomIndex, const uint8_t mask)
     {
         return std::make_shared<BLASInstance>(blas, instanceCustomIndex, mask);
@@ -139,6 +258,12 @@ namespace ava::raii
         tlas = ava::createTopLevelAccelerationStructure();
     }
 
+    TLAS::TLAS(const ava::TLAS existingTLAS)
+    {
+        AVA_CHECK(existingTLAS != nullptr, "Cannot create a RAII TLAS from an invalid TLAS");
+        tlas = existingTLAS;
+    }
+
     TLAS::~TLAS()
     {
         if (tlas != nullptr)
@@ -163,7 +288,7 @@ namespace ava::raii
         return *this;
     }
 
-    void TLAS::rebuild(const std::vector<Pointer<BLASInstance>>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags, vk::GeometryFlagsKHR geometryFlags) const
+    static std::vector<ava::BLASInstance> getAvaBLASInstances(const std::vector<Pointer<BLASInstance>>& blasInstances)
     {
         auto avaBlasInstances = std::vector<ava::BLASInstance>();
         avaBlasInstances.reserve(blasInstances.size());
@@ -174,23 +299,52 @@ namespace ava::raii
                 avaBlasInstances.push_back(blasInstance->blasInstance);
             }
         }
+        return avaBlasInstances;
+    }
 
-        ava::rebuildTLAS(tlas, avaBlasInstances, buildFlags, geometryFlags);
+    void TLAS::rebuild(const std::vector<Pointer<BLASInstance>>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags, vk::GeometryFlagsKHR geometryFlags) const
+    {
+        ava::rebuildTLAS(tlas, getAvaBLASInstances(blasInstances), buildFlags, geometryFlags);
     }
 
     bool TLAS::update(const std::vector<Pointer<BLASInstance>>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags, vk::GeometryFlagsKHR geometryFlags) const
     {
-        auto avaBlasInstances = std::vector<ava::BLASInstance>();
-        avaBlasInstances.reserve(blasInstances.size());
-        for (const auto& blasInstance : blasInstances)
-        {
-            if (blasInstance != nullptr && blasInstance->blasInstance != nullptr)
-            {
-                avaBlasInstances.push_back(blasInstance->blasInstance);
-            }
-        }
+        return ava::updateTLAS(tlas, getAvaBLASInstances(blasInstances), buildFlags, geometryFlags);
+    }
+
+    void TLAS::rebuild(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<BLASInstance>>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags, vk::GeometryFlagsKHR geometryFlags) const
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot rebuild TLAS with an invalid command buffer");
+        ava::rebuildTLAS(commandBuffer->commandBuffer, tlas, getAvaBLASInstances(blasInstances), buildFlags, geometryFlags);
+    }
 
-        return ava::updateTLAS(tlas, avaBlasInstances, buildFlags, geometryFlags);
+    bool TLAS::update(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<BLASInstance>>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags, vk::GeometryFlagsKHR geometryFlags) const
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot update TLAS with an invalid command buffer");
+        return ava::updateTLAS(commandBuffer->commandBuffer, tlas, getAvaBLASInstances(blasInstances), buildFlags, geometryFlags);
+    }
+
+    void TLAS::refit(const Pointer<CommandBuffer>& commandBuffer) const
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot refit TLAS with an invalid command buffer");
+        ava::refitTLAS(commandBuffer->commandBuffer, tlas);
+    }
+
+    void TLAS::rebuild(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<BLASInstance>>& blasInstances, const TLASCullingParameters& cullingParameters, vk::BuildAccelerationStructureFlagsKHR buildFlags, vk::GeometryFlagsKHR geometryFlags) const
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot rebuild TLAS with an invalid command buffer");
+        ava::rebuildTLAS(commandBuffer->commandBuffer, tlas, getAvaBLASInstances(blasInstances), cullingParameters, buildFlags, geometryFlags);
+    }
+
+    bool TLAS::update(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<BLASInstance>>& blasInstances, const TLASCullingParameters& cullingParameters, vk::BuildAccelerationStructureFlagsKHR buildFlags, vk::GeometryFlagsKHR geometryFlags) const
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot update TLAS with an invalid command buffer");
+        return ava::updateTLAS(commandBuffer->commandBuffer, tlas, getAvaBLASInstances(blasInstances), cullingParameters, buildFlags, geometryFlags);
+    }
+
+    TLASCullingStatistics TLAS::getCullingStatistics() const
+    {
+        return ava::getTLASCullingStatistics(tlas);
     }
 
     Pointer<TLAS> TLAS::create()
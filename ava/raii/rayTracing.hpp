@@ -3,6 +3,7 @@
 
 #include "types.hpp"
 #include "../types.hpp"
+#include "../rayTracing.hpp"
 
 namespace ava::raii
 {
@@ -13,6 +14,11 @@ namespace ava::raii
 
         explicit BLAS(const Pointer<VIBO>& meshBuffer);
         explicit BLAS(const Pointer<VBO>& vbo, const Pointer<IBO>& ibo = nullptr);
+        // References the geometries' buffers without a copy, they must outlive the BLAS's builds
+        explicit BLAS(const std::vector<BLASGeometry>& geometries);
+        // Procedural AABBs for intersection shaders, references aabbBuffer without a copy so it must outlive the BLAS's builds
+        BLAS(const Pointer<Buffer>& aabbBuffer, uint32_t aabbCount, vk::DeviceSize aabbOffset = 0, uint32_t aabbStride = sizeof(vk::AabbPositionsKHR), vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque);
+        explicit BLAS(ava::BLAS existingBLAS);
         ~BLAS();
 
         ava::BLAS blas;
@@ -23,14 +29,35 @@ namespace ava::raii
         BLAS& operator=(BLAS&& other) noexcept;
 
         void rebuild(vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque) const;
+        void rebuild(const Pointer<CommandBuffer>& commandBuffer, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque) const;
+        // Requires the last build to have had eAllowUpdate
+        void refit(const Pointer<CommandBuffer>& commandBuffer) const;
         Pointer<BLASInstance> createInstance(int32_t instanceCustomIndex = -1, uint8_t mask = 0xFF) const;
 
+        vk::DeviceSize getAccelerationStructureSize() const;
         vk::DeviceAddress getVertexBufferAddress() const;
         vk::DeviceAddress getIndexBufferAddress() const;
         vk::IndexType getIndexBufferType() const;
 
+        // Builds all BLASes with one shared scratch buffer, see ava::buildBLASes
+        static void buildBatch(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<BLAS>>& blases, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque);
+        static void buildBatch(const std::vector<Pointer<BLAS>>& blases, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque);
+
+        // Refits BLASes built with eAllowUpdate, see ava::refitBLASes
+        static void refitBatch(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<BLAS>>& blases);
+        static void refitBatch(const std::vector<Pointer<BLAS>>& blases);
+
+        // Compacts BLASes built with eAllowCompaction, see ava::compactBLASes
+        static BLASCompactionStatistics compactBatch(const std::vector<Pointer<BLAS>>& blases, uint32_t batchSize = 64);
+
         static Pointer<BLAS> create(const Pointer<VIBO>& meshBuffer);
         static Pointer<BLAS> create(const Pointer<VBO>& vbo, const Pointer<IBO>& ibo = nullptr);
+        static Pointer<BLAS> create(const std::vector<BLASGeometry>& geometries);
+        static Pointer<BLAS> create(const Pointer<Buffer>& aabbBuffer, uint32_t aabbCount, vk::DeviceSize aabbOffset = 0, uint32_t aabbStride = sizeof(vk::AabbPositionsKHR), vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque);
+
+        // positionOffset is the byte offset of the position within a vertex
+        static BLASGeometry getGeometry(const Pointer<VBO>& vbo, const Pointer<IBO>& ibo = nullptr, uint32_t positionOffset = 0, vk::Format positionFormat = vk::Format::eR32G32B32Sfloat);
+        static BLASGeometry getGeometry(const Pointer<VIBO>& vibo, uint32_t positionOffset = 0, vk::Format positionFormat = vk::Format::eR32G32B32Sfloat);
     };
 
     class BLASInstance
@@ -49,6 +76,10 @@ namespace ava::raii
         BLASInstance& operator=(BLASInstance&& other) noexcept;
 
         void updateTransformMatrix(const vk::TransformMatrixKHR& transformMatrix) const;
+        void updateShaderBindingTableRecordOffset(uint32_t recordOffset) const;
+        void updateBoundingSphere(const float center[3], float radius) const;
+        // LOD BLASes and the distances they are used from, see ava::updateLODs. The BLASes must outlive the instance
+        void updateLODs(const std::vector<std::pair<Pointer<BLAS>, float>>& lods) const;
 
         static Pointer<BLASInstance> create(const Pointer<BLAS>& blas, int32_t instanceCustomIndex = -1, uint8_t mask = 0xFF);
     };
@@ -58,6 +89,7 @@ namespace ava::raii
     public:
         using Ptr = Pointer<TLAS>;
         TLAS();
+        explicit TLAS(ava::TLAS existingTLAS);
         ~TLAS();
 
         ava::TLAS tlas;
@@ -69,6 +101,14 @@ namespace ava::raii
 
         void rebuild(const std::vector<Pointer<BLASInstance>>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {}) const;
         [[nodiscard]] bool update(const std::vector<Pointer<BLASInstance>>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {}) const;
+        void rebuild(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<BLASInstance>>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {}) const;
+        [[nodiscard]] bool update(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<BLASInstance>>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {}) const;
+        void refit(const Pointer<CommandBuffer>& commandBuffer) const;
+
+        // Culls the instances and selects their LODs before building, see ava::rebuildTLAS
+        void rebuild(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<BLASInstance>>& blasInstances, const TLASCullingParameters& cullingParameters, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {}) const;
+        [[nodiscard]] bool update(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<BLASInstance>>& blasInstances, const TLASCullingParameters& cullingParameters, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {}) const;
+        TLASCullingStatistics getCullingStatistics() const;
 
         static Pointer<TLAS> create();
     };
@@ -1,5 +1,6 @@
 #include "rayTracingPipeline.hpp"
 
+#include "commandBuffer.hpp"
 #include "shaders.hpp"
 #include "ava/detail/detail.hpp"
 
@@ -23,6 +24,7 @@ namespace ava::raii
     RayTracingPipeline::RayTracingPipeline(RayTracingPipeline&& other) noexcept
     {
         pipeline = other.pipeline;
+        libraries = std::move(other.libraries);
         other.pipeline = nullptr;
     }
 
@@ -31,16 +33,136 @@ namespace ava::raii
         if (this != &other)
         {
             pipeline = other.pipeline;
+            libraries = std::move(other.libraries);
             other.pipeline = nullptr;
         }
         return *this;
     }
 
+    RayTracingPipelineCreationTimes RayTracingPipeline::getCreationTimes() const
+    {
+        return ava::getRayTracingPipelineCreationTimes(pipeline);
+    }
+
     Pointer<RayTracingPipeline> RayTracingPipeline::create(const RayTracingPipelineCreationInfo& creationInfo)
     {
         return std::make_shared<RayTracingPipeline>(ava::createRayTracingPipeline(creationInfo));
     }
 
+    Pointer<RayTracingPipeline> RayTracingPipeline::link(const std::vector<Pointer<RayTracingPipelineLibrary>>& libraries)
+    {
+        std::vector<ava::RayTracingPipelineLibrary> avaLibraries;
+        avaLibraries.reserve(libraries.size());
+        for (const auto& library : libraries)
+        {
+            AVA_CHECK(library != nullptr, "Cannot link a ray tracing pipeline from an invalid library");
+            avaLibraries.push_back(library->library);
+        }
+
+        auto outPipeline = std::make_shared<RayTracingPipeline>(ava::linkRayTracingPipeline(avaLibraries));
+        outPipeline->libraries = libraries;
+        return outPipeline;
+    }
+
+    RayTracingPipelineLibrary::RayTracingPipelineLibrary(const ava::RayTracingPipelineLibrary existingRayTracingPipelineLibrary)
+    {
+        AVA_CHECK(existingRayTracingPipelineLibrary != nullptr, "Cannot create RAII ray tracing pipeline library when existing ray tracing pipeline library is invalid");
+
+        library = existingRayTracingPipelineLibrary;
+    }
+
+    RayTracingPipelineLibrary::~RayTracingPipelineLibrary()
+    {
+        if (library != nullptr)
+        {
+            ava::destroyRayTracingPipelineLibrary(library);
+        }
+    }
+
+    RayTracingPipelineLibrary::RayTracingPipelineLibrary(RayTracingPipelineLibrary&& other) noexcept
+    {
+        library = other.library;
+        other.library = nullptr;
+    }
+
+    RayTracingPipelineLibrary& RayTracingPipelineLibrary::operator=(RayTracingPipelineLibrary&& other) noexcept
+    {
+        if (this != &other)
+        {
+            library = other.library;
+            other.library = nullptr;
+        }
+        return *this;
+    }
+
+    double RayTracingPipelineLibrary::getCreationTime() const
+    {
+        return ava::getRayTracingPipelineLibraryCreationTime(library);
+    }
+
+    Pointer<RayTracingPipelineLibrary> RayTracingPipelineLibrary::create(const RayTracingPipelineLibraryCreationInfo& creationInfo)
+    {
+        return std::make_shared<RayTracingPipelineLibrary>(ava::createRayTracingPipelineLibrary(creationInfo));
+    }
+
+    ShaderBindingTable::ShaderBindingTable(const Pointer<RayTracingPipeline>& rayTracingPipeline, const ShaderBindingTableCreationInfo& creationInfo)
+    {
+        AVA_CHECK(rayTracingPipeline != nullptr && rayTracingPipeline->pipeline != nullptr, "Cannot create a shader binding table from an invalid ray tracing pipeline");
+        shaderBindingTable = ava::createShaderBindingTable(rayTracingPipeline->pipeline, creationInfo);
+    }
+
+    ShaderBindingTable::ShaderBindingTable(const ava::ShaderBindingTable existingShaderBindingTable)
+    {
+        AVA_CHECK(existingShaderBindingTable != nullptr, "Cannot create RAII shader binding table when existing shader binding table is invalid");
+
+        shaderBindingTable = existingShaderBindingTable;
+    }
+
+    ShaderBindingTable::~ShaderBindingTable()
+    {
+        if (shaderBindingTable != nullptr)
+        {
+            ava::destroyShaderBindingTable(shaderBindingTable);
+        }
+    }
+
+    ShaderBindingTable::ShaderBindingTable(ShaderBindingTable&& other) noexcept
+    {
+        shaderBindingTable = other.shaderBindingTable;
+        other.shaderBindingTable = nullptr;
+    }
+
+    ShaderBindingTable& ShaderBindingTable::operator=(ShaderBindingTable&& other) noexcept
+    {
+        if (this != &other)
+        {
+            shaderBindingTable = other.shaderBindingTable;
+            other.shaderBindingTable = nullptr;
+        }
+        return *this;
+    }
+
+    void ShaderBindingTable::updateRecordData(const ShaderBindingTableRegion region, const uint32_t recordIndex, const void* data, const uint32_t size, const uint32_t offset) const
+    {
+        ava::updateShaderBindingTableRecordData(shaderBindingTable, region, recordIndex, data, size, offset);
+    }
+
+    void ShaderBindingTable::updateRecordData(const Pointer<CommandBuffer>& commandBuffer, const ShaderBindingTableRegion region, const uint32_t recordIndex, const void* data, const uint32_t size, const uint32_t offset) const
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot update shader binding table record data with an invalid command buffer");
+        ava::updateShaderBindingTableRecordData(commandBuffer->commandBuffer, shaderBindingTable, region, recordIndex, data, size, offset);
+    }
+
+    uint32_t ShaderBindingTable::getRecordCount(const ShaderBindingTableRegion region) const
+    {
+        return ava::getShaderBindingTableRecordCount(shaderBindingTable, region);
+    }
+
+    Pointer<ShaderBindingTable> ShaderBindingTable::create(const Pointer<RayTracingPipeline>& rayTracingPipeline, const ShaderBindingTableCreationInfo& creationInfo)
+    {
+        return std::make_shared<ShaderBindingTable>(rayTracingPipeline, creationInfo);
+    }
+
     void populateRayTracingPipelineCreationInfo(RayTracingPipelineCreationInfo& rayTracingPipelineCreationInfo, const std::vector<Pointer<Shader>>& shaders)
     {
         std::vector<ava::Shader> avaShaders;
@@ -59,4 +181,20 @@ namespace ava::raii
 
         rayTracingPipelineCreationInfo.shaders = avaShaders;
     }
+
+    void populateRayTracingPipelineLibraryCreationInfo(RayTracingPipelineLibraryCreationInfo& rayTracingPipelineLibraryCreationInfo, const std::vector<Pointer<Shader>>& shaders, const std::vector<Pointer<Shader>>& layoutShaders)
+    {
+        auto getAvaShaders = [](const std::vector<Pointer<Shader>>& raiiShaders)
+        {
+            std::vector<ava::Shader> avaShaders;
+            avaShaders.reserve(raiiShaders.size());
+            for (const auto& shader : raiiShaders)
+            {
+                avaShaders.push_back(shader != nullptr ? shader->shader : nullptr);
+            }
+            return avaShaders;
+        };
+
+        ava::populateRayTracingPipelineLibraryCreationInfo(rayTracingPipelineLibraryCreationInfo, getAvaShaders(shaders), getAvaShaders(layoutShaders));
+    }
 }
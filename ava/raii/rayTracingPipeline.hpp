@@ -16,16 +16,78 @@ namespace ava::raii
         ~RayTracingPipeline();
 
         ava::RayTracingPipeline pipeline;
+        std::vector<Pointer<RayTracingPipelineLibrary>> libraries; // Kept alive for as long as the pipeline linked from them
 
         RayTracingPipeline(const RayTracingPipeline& other) = delete;
         RayTracingPipeline& operator=(RayTracingPipeline& other) = delete;
         RayTracingPipeline(RayTracingPipeline&& other) noexcept;
         RayTracingPipeline& operator=(RayTracingPipeline&& other) noexcept;
 
+        RayTracingPipelineCreationTimes getCreationTimes() const;
+
         static Pointer<RayTracingPipeline> create(const RayTracingPipelineCreationInfo& creationInfo);
+        static Pointer<RayTracingPipeline> link(const std::vector<Pointer<RayTracingPipelineLibrary>>& libraries);
+    };
+
+    class RayTracingPipelineLibrary
+    {
+    public:
+        using Ptr = std::shared_ptr<RayTracingPipelineLibrary>;
+
+        explicit RayTracingPipelineLibrary(ava::RayTracingPipelineLibrary existingRayTracingPipelineLibrary);
+        ~RayTracingPipelineLibrary();
+
+        ava::RayTracingPipelineLibrary library;
+
+        RayTracingPipelineLibrary(const RayTracingPipelineLibrary& other) = delete;
+        RayTracingPipelineLibrary& operator=(RayTracingPipelineLibrary& other) = delete;
+        RayTracingPipelineLibrary(RayTracingPipelineLibrary&& other) noexcept;
+        RayTracingPipelineLibrary& operator=(RayTracingPipelineLibrary&& other) noexcept;
+
+        double getCreationTime() const;
+
+        static Pointer<RayTracingPipelineLibrary> create(const RayTracingPipelineLibraryCreationInfo& creationInfo);
+    };
+
+    class ShaderBindingTable
+    {
+    public:
+        using Ptr = std::shared_ptr<ShaderBindingTable>;
+
+        ShaderBindingTable(const Pointer<RayTracingPipeline>& rayTracingPipeline, const ShaderBindingTableCreationInfo& creationInfo);
+        explicit ShaderBindingTable(ava::ShaderBindingTable existingShaderBindingTable);
+        ~ShaderBindingTable();
+
+        ava::ShaderBindingTable shaderBindingTable;
+
+        ShaderBindingTable(const ShaderBindingTable& other) = delete;
+        ShaderBindingTable& operator=(ShaderBindingTable& other) = delete;
+        ShaderBindingTable(ShaderBindingTable&& other) noexcept;
+        ShaderBindingTable& operator=(ShaderBindingTable&& other) noexcept;
+
+        // See ava::updateShaderBindingTableRecordData, the host variant must not be used while the table is in use
+        void updateRecordData(ShaderBindingTableRegion region, uint32_t recordIndex, const void* data, uint32_t size, uint32_t offset = 0) const;
+        void updateRecordData(const Pointer<CommandBuffer>& commandBuffer, ShaderBindingTableRegion region, uint32_t recordIndex, const void* data, uint32_t size, uint32_t offset = 0) const;
+
+        template <typename T>
+        void updateRecordData(const ShaderBindingTableRegion region, const uint32_t recordIndex, const T& data, const uint32_t offset = 0) const
+        {
+            updateRecordData(region, recordIndex, &data, sizeof(T), offset);
+        }
+
+        template <typename T>
+        void updateRecordData(const Pointer<CommandBuffer>& commandBuffer, const ShaderBindingTableRegion region, const uint32_t recordIndex, const T& data, const uint32_t offset = 0) const
+        {
+            updateRecordData(commandBuffer, region, recordIndex, &data, sizeof(T), offset);
+        }
+
+        uint32_t getRecordCount(ShaderBindingTableRegion region) const;
+
+        static Pointer<ShaderBindingTable> create(const Pointer<RayTracingPipeline>& rayTracingPipeline, const ShaderBindingTableCreationInfo& creationInfo);
     };
 
     void populateRayTracingPipelineCreationInfo(RayTracingPipelineCreationInfo& rayTracingPipelineCreationInfo, const std::vector<Pointer<Shader>>& shaders);
+    void populateRayTracingPipelineLibraryCreationInfo(RayTracingPipelineLibraryCreationInfo& rayTracingPipelineLibraryCreationInfo, const std::vector<Pointer<Shader>>& shaders, const std::vector<Pointer<Shader>>& layoutShaders = {});
 }
 
 #endif
@@ -0,0 +1,19 @@
+#include "texture.hpp"
+
+#include "commandBuffer.hpp"
+#include "image.hpp"
+#include "ava/detail/detail.hpp"
+
+namespace ava::raii
+{
+    Pointer<Image> loadTexture(const Pointer<CommandBuffer>& commandBuffer, const std::string& fileName, const vk::ImageUsageFlags usageFlags, const vk::ImageLayout finalLayout)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot load texture with an invalid command buffer");
+        return std::make_shared<Image>(ava::loadTexture(commandBuffer->commandBuffer, fileName, usageFlags, finalLayout));
+    }
+
+    Pointer<Image> loadTexture(const std::string& fileName, const vk::ImageUsageFlags usageFlags, const vk::ImageLayout finalLayout)
+    {
+        return std::make_shared<Image>(ava::loadTexture(fileName, usageFlags, finalLayout));
+    }
+}
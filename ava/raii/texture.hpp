@@ -0,0 +1,14 @@
+#ifndef AVA_RAII_TEXTURE_HPP
+#define AVA_RAII_TEXTURE_HPP
+
+#include "types.hpp"
+#include "ava/texture.hpp"
+
+namespace ava::raii
+{
+    // See ava::loadTexture
+    [[nodiscard]] Pointer<Image> loadTexture(const Pointer<CommandBuffer>& commandBuffer, const std::string& fileName, vk::ImageUsageFlags usageFlags = DEFAULT_IMAGE_SAMPLED_USAGE_FLAGS, vk::ImageLayout finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal);
+    [[nodiscard]] Pointer<Image> loadTexture(const std::string& fileName, vk::ImageUsageFlags usageFlags = DEFAULT_IMAGE_SAMPLED_USAGE_FLAGS, vk::ImageLayout finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal);
+}
+
+#endif
@@ -0,0 +1,125 @@
+#include "textureStreamer.hpp"
+#include "ava/textureStreamer.hpp"
+
+#include "commandBuffer.hpp"
+#include "ava/detail/detail.hpp"
+
+namespace ava::raii
+{
+    TextureStreamer::TextureStreamer(const ava::TextureStreamer& existingStreamer)
+    {
+        AVA_CHECK(existingStreamer != nullptr, "Cannot create a RAII texture streamer from an invalid texture streamer");
+
+        streamer = existingStreamer;
+    }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        if (streamer != nullptr)
+        {
+            ava::destroyTextureStreamer(streamer);
+        }
+    }
+
+    TextureStreamer::TextureStreamer(TextureStreamer&& other) noexcept
+    {
+        streamer = other.streamer;
+        other.streamer = nullptr;
+    }
+
+    TextureStreamer& TextureStreamer::operator=(TextureStreamer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            streamer = other.streamer;
+            other.streamer = nullptr;
+        }
+        return *this;
+    }
+
+    Pointer<StreamedTexture> TextureStreamer::add(const Pointer<CommandBuffer>& commandBuffer, const std::string& fileName, const vk::ImageUsageFlags usageFlags)
+    {
+        AVA_CHECK(commandBuffer != nullptr, "Cannot add a streamed texture with an invalid command buffer");
+        return std::make_shared<StreamedTexture>(shared_from_this(), ava::addStreamedTexture(commandBuffer->commandBuffer, streamer, fileName, usageFlags));
+    }
+
+    void TextureStreamer::update(const Pointer<CommandBuffer>& commandBuffer) const
+    {
+        AVA_CHECK(commandBuffer != nullptr, "Cannot update a texture streamer with an invalid command buffer");
+        ava::updateTextureStreamer(commandBuffer->commandBuffer, streamer);
+    }
+
+    TextureStreamerStatistics TextureStreamer::getStatistics() const
+    {
+        return ava::getTextureStreamerStatistics(streamer);
+    }
+
+    Pointer<TextureStreamer> TextureStreamer::create(const TextureStreamerCreationInfo& creationInfo)
+    {
+        return std::make_shared<TextureStreamer>(ava::createTextureStreamer(creationInfo));
+    }
+
+    StreamedTexture::StreamedTexture(const Pointer<TextureStreamer>& streamerAddedTo, const ava::StreamedTexture& existingTexture)
+    {
+        AVA_CHECK(streamerAddedTo != nullptr && streamerAddedTo->streamer != nullptr, "Cannot create a RAII streamed texture from an invalid texture streamer");
+        AVA_CHECK(existingTexture != nullptr, "Cannot create a RAII streamed texture from an invalid streamed texture");
+
+        addedToStreamer = streamerAddedTo;
+        texture = existingTexture;
+    }
+
+    StreamedTexture::~StreamedTexture()
+    {
+        // Textures are destroyed alongside their streamer, so only remove while the streamer is alive
+        if (texture != nullptr)
+        {
+            if (const auto streamer = addedToStreamer.lock(); streamer != nullptr && streamer->streamer != nullptr)
+            {
+                ava::removeStreamedTexture(texture);
+            }
+        }
+    }
+
+    StreamedTexture::StreamedTexture(StreamedTexture&& other) noexcept
+    {
+        addedToStreamer = std::move(other.addedToStreamer);
+        texture = other.texture;
+        other.texture = nullptr;
+    }
+
+    StreamedTexture& StreamedTexture::operator=(StreamedTexture&& other) noexcept
+    {
+        if (this != &other)
+        {
+            addedToStreamer = std::move(other.addedToStreamer);
+            texture = other.texture;
+            other.texture = nullptr;
+        }
+        return *this;
+    }
+
+    void StreamedTexture::requestMip(const uint32_t mipLevel) const
+    {
+        ava::requestStreamedTextureMip(texture, mipLevel);
+    }
+
+    ava::Image StreamedTexture::getImage() const
+    {
+        return ava::getStreamedTextureImage(texture);
+    }
+
+    ava::ImageView StreamedTexture::getImageView() const
+    {
+        return ava::getStreamedTextureImageView(texture);
+    }
+
+    uint32_t StreamedTexture::getResidentMip() const
+    {
+        return ava::getStreamedTextureResidentMip(texture);
+    }
+
+    TextureInfo StreamedTexture::getInfo() const
+    {
+        return ava::getStreamedTextureInfo(texture);
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef AVA_RAII_TEXTURESTREAMER_HPP
+#define AVA_RAII_TEXTURESTREAMER_HPP
+
+#include "types.hpp"
+#include "ava/textureStreamer.hpp"
+
+namespace ava::raii
+{
+    class TextureStreamer : public std::enable_shared_from_this<TextureStreamer>
+    {
+    public:
+        using Ptr = Pointer<TextureStreamer>;
+
+        explicit TextureStreamer(const ava::TextureStreamer& existingStreamer);
+        ~TextureStreamer();
+
+        ava::TextureStreamer streamer;
+
+        TextureStreamer(const TextureStreamer& other) = delete;
+        TextureStreamer& operator=(TextureStreamer& other) = delete;
+        TextureStreamer(TextureStreamer&& other) noexcept;
+        TextureStreamer& operator=(TextureStreamer&& other) noexcept;
+
+        [[nodiscard]] Pointer<StreamedTexture> add(const Pointer<CommandBuffer>& commandBuffer, const std::string& fileName, vk::ImageUsageFlags usageFlags = vk::ImageUsageFlagBits::eSampled);
+        void update(const Pointer<CommandBuffer>& commandBuffer) const;
+
+        [[nodiscard]] TextureStreamerStatistics getStatistics() const;
+
+        static Pointer<TextureStreamer> create(const TextureStreamerCreationInfo& creationInfo = {});
+    };
+
+    class StreamedTexture
+    {
+    public:
+        using Ptr = Pointer<StreamedTexture>;
+
+        explicit StreamedTexture(const Pointer<TextureStreamer>& streamerAddedTo, const ava::StreamedTexture& existingTexture);
+        ~StreamedTexture();
+
+        WeakPointer<TextureStreamer> addedToStreamer;
+        ava::StreamedTexture texture;
+
+        StreamedTexture(const StreamedTexture& other) = delete;
+        StreamedTexture& operator=(StreamedTexture& other) = delete;
+        StreamedTexture(StreamedTexture&& other) noexcept;
+        StreamedTexture& operator=(StreamedTexture&& other) noexcept;
+
+        void requestMip(uint32_t mipLevel) const;
+
+        // Owned by the streamer, see ava::getStreamedTextureImage
+        [[nodiscard]] ava::Image getImage() const;
+        [[nodiscard]] ava::ImageView getImageView() const;
+        [[nodiscard]] uint32_t getResidentMip() const;
+        [[nodiscard]] TextureInfo getInfo() const;
+    };
+}
+
+#endif
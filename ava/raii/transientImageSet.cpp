@@ -0,0 +1,60 @@
+#include "transientImageSet.hpp"
+#include "ava/transientImageSet.hpp"
+
+#include "commandBuffer.hpp"
+#include "ava/detail/detail.hpp"
+
+namespace ava::raii
+{
+    TransientImageSet::TransientImageSet(const ava::TransientImageSet& existingTransientImageSet)
+    {
+        AVA_CHECK(existingTransientImageSet != nullptr, "Cannot create a RAII transient image set from an invalid transient image set");
+
+        transientImageSet = existingTransientImageSet;
+    }
+
+    TransientImageSet::~TransientImageSet()
+    {
+        if (transientImageSet != nullptr)
+        {
+            ava::destroyTransientImageSet(transientImageSet);
+        }
+    }
+
+    TransientImageSet::TransientImageSet(TransientImageSet&& other) noexcept
+    {
+        transientImageSet = other.transientImageSet;
+        other.transientImageSet = nullptr;
+    }
+
+    TransientImageSet& TransientImageSet::operator=(TransientImageSet&& other) noexcept
+    {
+        if (this != &other)
+        {
+            transientImageSet = other.transientImageSet;
+            other.transientImageSet = nullptr;
+        }
+        return *this;
+    }
+
+    ava::Image TransientImageSet::getImage(const uint32_t index) const
+    {
+        return ava::getTransientImage(transientImageSet, index);
+    }
+
+    void TransientImageSet::beginPass(const Pointer<CommandBuffer>& commandBuffer, const uint32_t passIndex) const
+    {
+        AVA_CHECK(commandBuffer != nullptr, "Cannot begin a transient pass with an invalid command buffer");
+        ava::beginTransientPass(commandBuffer->commandBuffer, transientImageSet, passIndex);
+    }
+
+    TransientImageSetStatistics TransientImageSet::getStatistics() const
+    {
+        return ava::getTransientImageSetStatistics(transientImageSet);
+    }
+
+    Pointer<TransientImageSet> TransientImageSet::create(const std::vector<TransientImageCreationInfo>& creationInfos)
+    {
+        return std::make_shared<TransientImageSet>(ava::createTransientImageSet(creationInfos));
+    }
+}
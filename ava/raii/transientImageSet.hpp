@@ -0,0 +1,33 @@
+#ifndef AVA_RAII_TRANSIENTIMAGESET_HPP
+#define AVA_RAII_TRANSIENTIMAGESET_HPP
+
+#include "types.hpp"
+#include "ava/transientImageSet.hpp"
+
+namespace ava::raii
+{
+    class TransientImageSet
+    {
+    public:
+        using Ptr = Pointer<TransientImageSet>;
+
+        explicit TransientImageSet(const ava::TransientImageSet& existingTransientImageSet);
+        ~TransientImageSet();
+
+        ava::TransientImageSet transientImageSet;
+
+        TransientImageSet(const TransientImageSet& other) = delete;
+        TransientImageSet& operator=(TransientImageSet& other) = delete;
+        TransientImageSet(TransientImageSet&& other) noexcept;
+        TransientImageSet& operator=(TransientImageSet&& other) noexcept;
+
+        // Owned by the set, see ava::getTransientImage
+        [[nodiscard]] ava::Image getImage(uint32_t index) const;
+        void beginPass(const Pointer<CommandBuffer>& commandBuffer, uint32_t passIndex) const;
+        [[nodiscard]] TransientImageSetStatistics getStatistics() const;
+
+        static Pointer<TransientImageSet> create(const std::vector<TransientImageCreationInfo>& creationInfos);
+    };
+}
+
+#endif
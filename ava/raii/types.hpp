@@ -25,6 +25,17 @@ namespace ava::raii
     class BLASInstance;
     class TLAS;
     class RayTracingPipeline;
+    class RayTracingPipelineLibrary;
+    class ShaderBindingTable;
+    class CullingPass;
+    class GeometryArena;
+    class ArenaMesh;
+    class InstanceBuffer;
+    class TextureStreamer;
+    class StreamedTexture;
+    class MemoryPool;
+    class Defragmentation;
+    class TransientImageSet;
 
     template <typename T>
     using Pointer = std::shared_ptr<T>;
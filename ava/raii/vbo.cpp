@@ -44,6 +44,20 @@ namespace ava::raii
         ava::bindVBO(commandBuffer->commandBuffer, vbo);
     }
 
+    void VBO::bind(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<VBO>>& vbos)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot bind VBOs to an invalid command buffer");
+
+        std::vector<ava::VBO> avaVBOs;
+        avaVBOs.reserve(vbos.size());
+        for (const auto& vbo : vbos)
+        {
+            AVA_CHECK(vbo != nullptr, "Cannot bind an invalid VBO");
+            avaVBOs.push_back(vbo->vbo);
+        }
+        ava::bindVBO(commandBuffer->commandBuffer, avaVBOs);
+    }
+
     Pointer<VBO> VBO::create(const Pointer<VAO>& vao, const void* data, const size_t size, const uint32_t binding)
     {
         AVA_CHECK(vao != nullptr && vao->vao != nullptr, "Cannot create a VBO with an invalid vao");
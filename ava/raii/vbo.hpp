@@ -21,6 +21,8 @@ namespace ava::raii
         VBO& operator=(VBO&& other) noexcept;
 
         void bind(const Pointer<CommandBuffer>& commandBuffer) const;
+        // Binds each VBO at its own binding, VBOs with consecutive bindings are bound in a single call
+        static void bind(const Pointer<CommandBuffer>& commandBuffer, const std::vector<Pointer<VBO>>& vbos);
 
         static Pointer<VBO> create(const Pointer<VAO>& vao, const void* data, size_t size, uint32_t binding = 0);
 
@@ -4,6 +4,9 @@
 #include "ava.hpp"
 #include "detail/detail.hpp"
 #include "detail/state.hpp"
+#include "detail/vbo.hpp"
+#include "detail/ibo.hpp"
+#include "detail/vibo.hpp"
 
 namespace ava
 {
@@ -154,31 +157,118 @@ namespace ava
         return detail::createBottomLevelAccelerationStructure(vbo, ibo);
     }
 
+    BLAS createBottomLevelAccelerationStructure(const std::vector<BLASGeometry>& geometries)
+    {
+        return detail::createBottomLevelAccelerationStructure(geometries);
+    }
+
+    BLAS createBottomLevelAccelerationStructure(const Buffer aabbBuffer, const uint32_t aabbCount, const vk::DeviceSize aabbOffset, const uint32_t aabbStride, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        return detail::createBottomLevelAccelerationStructure(aabbBuffer, aabbCount, aabbOffset, aabbStride, geometryFlags);
+    }
+
     void destroyBottomLevelAccelerationStructure(BLAS& blas)
     {
         detail::destroyBottomLevelAccelerationStructure(blas);
     }
 
+    BLASGeometry getBLASGeometry(const VBO vbo, const IBO ibo, const uint32_t positionOffset, const vk::Format positionFormat)
+    {
+        AVA_CHECK(vbo != nullptr && vbo->buffer != nullptr, "Cannot get BLAS geometry from an invalid VBO");
+        AVA_CHECK(vbo->topology == vk::PrimitiveTopology::eTriangleList, "Cannot get BLAS geometry from a VBO which is not a triangle list");
+
+        BLASGeometry geometry{};
+        geometry.vertexBuffer = vbo->buffer;
+        geometry.vertexOffset = positionOffset;
+        geometry.vertexStride = vbo->stride;
+        geometry.vertexCount = vbo->vertexCount;
+        geometry.vertexFormat = positionFormat;
+        if (ibo != nullptr)
+        {
+            AVA_CHECK(ibo->buffer != nullptr, "Cannot get BLAS geometry from an invalid IBO");
+            geometry.indexBuffer = ibo->buffer;
+            geometry.indexCount = ibo->indexCount;
+            geometry.indexType = ibo->indexType;
+        }
+        return geometry;
+    }
+
+    BLASGeometry getBLASGeometry(const VIBO vibo, const uint32_t positionOffset, const vk::Format positionFormat)
+    {
+        AVA_CHECK(vibo != nullptr && vibo->buffer != nullptr, "Cannot get BLAS geometry from an invalid VIBO");
+        AVA_CHECK(vibo->topology == vk::PrimitiveTopology::eTriangleList, "Cannot get BLAS geometry from a VIBO which is not a triangle list");
+
+        BLASGeometry geometry{};
+        geometry.vertexBuffer = vibo->buffer;
+        geometry.vertexOffset = vibo->vertexOffset + positionOffset;
+        geometry.vertexStride = vibo->stride;
+        geometry.vertexCount = vibo->vertexCount;
+        geometry.vertexFormat = positionFormat;
+        geometry.indexBuffer = vibo->buffer;
+        geometry.indexOffset = vibo->indexOffset;
+        geometry.indexCount = vibo->indexCount;
+        geometry.indexType = vibo->indexType;
+        return geometry;
+    }
+
     void rebuildBLAS(const BLAS blas, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags)
     {
         return detail::rebuildBLAS(blas, buildFlags, geometryFlags);
     }
 
+    void rebuildBLAS(const CommandBuffer& commandBuffer, const BLAS blas, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        detail::rebuildBLAS(commandBuffer, blas, buildFlags, geometryFlags);
+    }
+
+    void buildBLASes(const CommandBuffer& commandBuffer, const std::vector<BLAS>& blases, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags, const vk::DeviceSize maxScratchSize)
+    {
+        detail::buildBLASes(commandBuffer, blases, buildFlags, geometryFlags, maxScratchSize);
+    }
+
+    void buildBLASes(const std::vector<BLAS>& blases, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags, const vk::DeviceSize maxScratchSize)
+    {
+        detail::buildBLASes(blases, buildFlags, geometryFlags, maxScratchSize);
+    }
+
+    void refitBLASes(const CommandBuffer& commandBuffer, const std::vector<BLAS>& blases, const vk::DeviceSize maxScratchSize)
+    {
+        detail::refitBLASes(commandBuffer, blases, maxScratchSize);
+    }
+
+    void refitBLASes(const std::vector<BLAS>& blases, const vk::DeviceSize maxScratchSize)
+    {
+        detail::refitBLASes(blases, maxScratchSize);
+    }
+
+    BLASCompactionStatistics compactBLASes(const std::vector<BLAS>& blases, const uint32_t batchSize)
+    {
+        return detail::compactBLASes(blases, batchSize);
+    }
+
+    vk::DeviceSize getAccelerationStructureSize(const BLAS blas)
+    {
+        AVA_CHECK(blas != nullptr, "Cannot get acceleration structure size of an invalid BLAS");
+        if (blas->accelerationStructure == nullptr)
+            return 0;
+        return blas->accelerationStructure->buffer->size;
+    }
+
     vk::DeviceAddress getVertexBufferAddress(const BLAS blas)
     {
-        AVA_CHECK(blas != nullptr && blas->meshBuffer != nullptr, "Cannot get vertex buffer address from an invalid BLAS");
+        AVA_CHECK(blas != nullptr && blas->meshBuffer != nullptr, "Cannot get vertex buffer address from an invalid BLAS or one built from BLAS geometries");
         return blas->vertexDeviceAddress;
     }
 
     vk::DeviceAddress getIndexBufferAddress(const BLAS blas)
     {
-        AVA_CHECK(blas != nullptr && blas->meshBuffer != nullptr, "Cannot get index buffer address from an invalid BLAS");
+        AVA_CHECK(blas != nullptr && blas->meshBuffer != nullptr, "Cannot get index buffer address from an invalid BLAS or one built from BLAS geometries");
         return blas->indexDeviceAddress;
     }
 
     vk::IndexType getIndexBufferType(const BLAS blas)
     {
-        AVA_CHECK(blas != nullptr && blas->meshBuffer != nullptr, "Cannot get index type from an invalid BLAS");
+        AVA_CHECK(blas != nullptr && blas->meshBuffer != nullptr, "Cannot get index type from an invalid BLAS or one built from BLAS geometries");
         return blas->indexType;
     }
 
@@ -199,6 +289,44 @@ namespace ava
     {
         AVA_CHECK(blasInstance != nullptr, "Cannot update transform matrix of an invalid BLAS instance");
         blasInstance->transformMatrix = transformMatrix;
+        detail::markBLASInstanceDirty(blasInstance);
+    }
+
+    void updateShaderBindingTableRecordOffset(const BLASInstance& blasInstance, const uint32_t recordOffset)
+    {
+        AVA_CHECK(blasInstance != nullptr, "Cannot update shader binding table record offset of an invalid BLAS instance");
+        AVA_CHECK(recordOffset < (1u << 24), "Cannot update shader binding table record offset to a value which does not fit in 24 bits");
+        blasInstance->instanceShaderBindingTableRecordOffset = recordOffset;
+        detail::markBLASInstanceDirty(blasInstance);
+    }
+
+    void updateBoundingSphere(const BLASInstance& blasInstance, const float center[3], const float radius)
+    {
+        AVA_CHECK(blasInstance != nullptr, "Cannot update bounding sphere of an invalid BLAS instance");
+        AVA_CHECK(radius >= 0.0f, "Cannot update bounding sphere of a BLAS instance with a negative radius");
+        blasInstance->boundingSphere = {center[0], center[1], center[2], radius};
+    }
+
+    void updateLODs(const BLASInstance& blasInstance, const std::vector<BLASInstanceLOD>& lods)
+    {
+        AVA_CHECK(blasInstance != nullptr, "Cannot update LODs of an invalid BLAS instance");
+
+        std::vector<std::pair<detail::BLAS*, float>> instanceLODs;
+        instanceLODs.reserve(lods.size());
+        for (const auto& lod : lods)
+        {
+            AVA_CHECK(lod.blas != nullptr, "Cannot update LODs of a BLAS instance with an invalid LOD BLAS");
+            AVA_CHECK(instanceLODs.empty() || lod.minDistance >= instanceLODs.back().second, "Cannot update LODs of a BLAS instance when the LODs are not in increasing minDistance");
+            instanceLODs.emplace_back(lod.blas, lod.minDistance);
+        }
+        blasInstance->lods = std::move(instanceLODs);
+
+        // Back to full detail until the next cull selects a LOD
+        if (blasInstance->blas != blasInstance->baseBLAS)
+        {
+            blasInstance->blas = blasInstance->baseBLAS;
+            detail::markBLASInstanceDirty(blasInstance);
+        }
     }
 
     TLAS createTopLevelAccelerationStructure()
@@ -220,4 +348,51 @@ namespace ava
     {
         return detail::updateTLAS(tlas, blasInstances, buildFlags, geometryFlags);
     }
+
+    void rebuildTLAS(const CommandBuffer& commandBuffer, const TLAS tlas, const std::vector<BLASInstance>& blasInstances, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        detail::rebuildTLAS(commandBuffer, tlas, blasInstances, buildFlags, geometryFlags);
+    }
+
+    bool updateTLAS(const CommandBuffer& commandBuffer, const TLAS tlas, const std::vector<BLASInstance>& blasInstances, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        return detail::updateTLAS(commandBuffer, tlas, blasInstances, buildFlags, geometryFlags);
+    }
+
+    void refitTLAS(const CommandBuffer& commandBuffer, const TLAS tlas)
+    {
+        detail::refitTLAS(commandBuffer, tlas);
+    }
+
+    void rebuildTLAS(const CommandBuffer& commandBuffer, const TLAS tlas, const std::vector<BLASInstance>& blasInstances, const TLASCullingParameters& cullingParameters, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        AVA_CHECK(tlas != nullptr, "Cannot rebuild TLAS when TLAS is invalid");
+
+        std::vector<BLASInstance> visibleInstances;
+        std::vector<uint32_t> sourceIndices;
+        const auto statistics = detail::cullBLASInstances(blasInstances, cullingParameters, visibleInstances, sourceIndices);
+        detail::rebuildTLAS(commandBuffer, tlas, visibleInstances, buildFlags, geometryFlags, sourceIndices);
+        tlas->cullingStatistics = statistics;
+    }
+
+    bool updateTLAS(const CommandBuffer& commandBuffer, const TLAS tlas, const std::vector<BLASInstance>& blasInstances, const TLASCullingParameters& cullingParameters, const vk::BuildAccelerationStructureFlagsKHR buildFlags, const vk::GeometryFlagsKHR geometryFlags)
+    {
+        AVA_CHECK(tlas != nullptr, "Cannot update TLAS when TLAS is invalid");
+
+        std::vector<BLASInstance> visibleInstances;
+        std::vector<uint32_t> sourceIndices;
+        const auto statistics = detail::cullBLASInstances(blasInstances, cullingParameters, visibleInstances, sourceIndices);
+        const bool updated = detail::updateTLAS(commandBuffer, tlas, visibleInstances, buildFlags, geometryFlags, sourceIndices);
+        if (updated)
+        {
+            tlas->cullingStatistics = statistics;
+        }
+        return updated;
+    }
+
+    TLASCullingStatistics getTLASCullingStatistics(const TLAS tlas)
+    {
+        AVA_CHECK(tlas != nullptr, "Cannot get the culling statistics of an invalid TLAS");
+        return tlas->cullingStatistics;
+    }
 }
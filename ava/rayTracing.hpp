@@ -4,8 +4,69 @@
 #include "types.hpp"
 #include "version.hpp"
 
+#include <limits>
+
 namespace ava
 {
+    // One geometry of a multi-geometry BLAS, which references its buffers rather than copying them. The buffers must outlive the BLAS's builds
+    // Buffers need eAccelerationStructureBuildInputReadOnlyKHR usage, vertex and index buffers get it automatically when ray tracing is enabled
+    struct BLASGeometry
+    {
+        Buffer vertexBuffer = nullptr;
+        vk::DeviceSize vertexOffset = 0; // Byte offset of the first vertex's position, include the position's offset within a vertex
+        uint32_t vertexStride = 0;
+        uint32_t vertexCount = 0;
+        vk::Format vertexFormat = vk::Format::eR32G32B32Sfloat; // eR16G16B16A16Sfloat, eR16G16B16A16Snorm etc. are also accepted when the device supports them
+
+        Buffer indexBuffer = nullptr; // Optional, vertices are a triangle list when nullptr
+        vk::DeviceSize indexOffset = 0;
+        uint32_t indexCount = 0;
+        vk::IndexType indexType = vk::IndexType::eUint32;
+
+        std::optional<vk::TransformMatrixKHR> transform; // Transforms the geometry's vertices when building
+        vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque;
+    };
+
+    struct BLASCompactionResult
+    {
+        BLAS blas;
+        vk::DeviceSize originalSize; // Bytes of the acceleration structure before compaction
+        vk::DeviceSize compactedSize; // Bytes after compaction, equal to originalSize if compaction did not shrink it
+    };
+
+    struct BLASCompactionStatistics
+    {
+        std::vector<BLASCompactionResult> results;
+        vk::DeviceSize totalOriginalSize = 0;
+        vk::DeviceSize totalCompactedSize = 0;
+    };
+
+    // A less detailed BLAS for a BLAS instance, used from minDistance until the next LOD's minDistance
+    struct BLASInstanceLOD
+    {
+        BLAS blas = nullptr;
+        float minDistance = 0.0f;
+    };
+
+    struct TLASCullingParameters
+    {
+        float viewProjection[16]{}; // Column-major, depth range [0, 1]
+        float cameraPosition[3]{}; // World space, distances are measured from here to the instances' bounds
+        float maxDistance = std::numeric_limits<float>::infinity(); // Instances further away are culled
+        float lodDistanceScale = 1.0f; // Above 1 keeps detailed LODs further away
+        // Culled instances can no longer be hit by any ray, so off-screen instances stop casting shadows and appearing in reflections
+        // Disable, or pass a wider viewProjection, when that matters more than build time
+        bool frustumCulling = true;
+    };
+
+    struct TLASCullingStatistics
+    {
+        uint32_t visibleCount;
+        uint32_t frustumCulledCount;
+        uint32_t distanceCulledCount;
+        uint32_t totalCount;
+    };
+
     // Query ray tracing support before setting enableRayTracing in CreateInfo
     bool queryRayTracingSupport(Version apiVersion);
 
@@ -17,11 +78,44 @@ namespace ava
     // Has to assume position is first element and a float3/vec3 (R32G32B32Sfloat)
     BLAS createBottomLevelAccelerationStructure(ava::VIBO meshBuffer);
     BLAS createBottomLevelAccelerationStructure(ava::VBO vbo, std::optional<ava::IBO> ibo);
+    // Built from many geometries each with their own format, offsets, flags and transform, referencing their buffers without a copy
+    BLAS createBottomLevelAccelerationStructure(const std::vector<BLASGeometry>& geometries);
+    // Procedural geometry for intersection shader hit groups, from aabbCount vk::AabbPositionsKHR in aabbBuffer which is referenced without a copy
+    // aabbBuffer needs eAccelerationStructureBuildInputReadOnlyKHR usage and must outlive the BLAS's builds. Moved AABBs can be applied with refitBLASes
+    BLAS createBottomLevelAccelerationStructure(Buffer aabbBuffer, uint32_t aabbCount, vk::DeviceSize aabbOffset = 0, uint32_t aabbStride = sizeof(vk::AabbPositionsKHR), vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque);
     void destroyBottomLevelAccelerationStructure(BLAS& blas);
 
+    // positionOffset is the byte offset of the position within a vertex
+    BLASGeometry getBLASGeometry(VBO vbo, IBO ibo = nullptr, uint32_t positionOffset = 0, vk::Format positionFormat = vk::Format::eR32G32B32Sfloat);
+    BLASGeometry getBLASGeometry(VIBO vibo, uint32_t positionOffset = 0, vk::Format positionFormat = vk::Format::eR32G32B32Sfloat);
+
     // Builds one acceleration structure with a single time command and a scratch buffer
     void rebuildBLAS(BLAS blas, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque);
+    // Records the build into commandBuffer without stalling, the scratch and replaced acceleration structure are tracked by the command buffer
+    void rebuildBLAS(const CommandBuffer& commandBuffer, BLAS blas, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque);
+
+    // Default scratch size cap of batched BLAS builds and refits
+    constexpr vk::DeviceSize BLAS_BATCH_MAX_SCRATCH_SIZE = 64ull * 1024 * 1024;
+
+    // Builds many BLASes with one shared scratch buffer, splitting into batches that reuse the scratch when it would exceed maxScratchSize
+    // Recorded into commandBuffer, which keeps the scratch alive. Builds are made visible to later commands in the command buffer
+    void buildBLASes(const CommandBuffer& commandBuffer, const std::vector<BLAS>& blases, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque, vk::DeviceSize maxScratchSize = BLAS_BATCH_MAX_SCRATCH_SIZE);
+    // Builds many BLASes in one single time command with a pooled scratch buffer
+    void buildBLASes(const std::vector<BLAS>& blases, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, vk::GeometryFlagsKHR geometryFlags = vk::GeometryFlagBitsKHR::eOpaque, vk::DeviceSize maxScratchSize = BLAS_BATCH_MAX_SCRATCH_SIZE);
 
+    // Updates BLASes built with eAllowUpdate in place from their moved vertices or AABBs, keeping the flags of their last build
+    // Recorded into commandBuffer after a barrier for the inputs being written earlier in it, the scratch is tracked by the command buffer
+    void refitBLASes(const CommandBuffer& commandBuffer, const std::vector<BLAS>& blases, vk::DeviceSize maxScratchSize = BLAS_BATCH_MAX_SCRATCH_SIZE);
+    // Refits many BLASes in one single time command with a pooled scratch buffer
+    void refitBLASes(const std::vector<BLAS>& blases, vk::DeviceSize maxScratchSize = BLAS_BATCH_MAX_SCRATCH_SIZE);
+
+    // Shrinks BLASes built with eAllowCompaction into right-sized acceleration structures, releasing the originals
+    // Works batchSize BLASes at a time. BLASes which are not built, not built with eAllowCompaction or already compacted are skipped
+    BLASCompactionStatistics compactBLASes(const std::vector<BLAS>& blases, uint32_t batchSize = 64);
+    // Size in bytes of the BLAS's acceleration structure, 0 if not built
+    vk::DeviceSize getAccelerationStructureSize(BLAS blas);
+
+    // Only available for BLASes created from a VIBO or VBO, as their mesh is copied into the BLAS
     vk::DeviceAddress getVertexBufferAddress(BLAS blas);
     vk::DeviceAddress getIndexBufferAddress(BLAS blas);
     vk::IndexType getIndexBufferType(BLAS blas);
@@ -29,7 +123,14 @@ namespace ava
     BLASInstance createBLASInstance(BLAS blas, int32_t instanceCustomIndex = -1, uint8_t mask = 0xFF);
     void destroyBLASInstance(BLASInstance& blasInstance);
 
+    // Only the changed instance is rewritten into the instance buffers of the TLASes it was built into
     void updateTransformMatrix(const BLASInstance& blasInstance, const vk::TransformMatrixKHR& transformMatrix);
+    // Selects the instance's first hit record, with several ray types this is the material's record index times the ray type count
+    void updateShaderBindingTableRecordOffset(const BLASInstance& blasInstance, uint32_t recordOffset);
+    // Object space bounds for culling, instances without any are never frustum culled and are measured from their origin
+    void updateBoundingSphere(const BLASInstance& blasInstance, const float center[3], float radius);
+    // LODs in increasing minDistance. The instance's own BLAS is used closer than the first, selection happens when culled by rebuildTLAS or updateTLAS
+    void updateLODs(const BLASInstance& blasInstance, const std::vector<BLASInstanceLOD>& lods);
 
     TLAS createTopLevelAccelerationStructure();
     void destroyTopLevelAccelerationStructure(TLAS& tlas);
@@ -37,6 +138,22 @@ namespace ava
     // Builds one acceleration structure with a single time command and a scratch buffer
     void rebuildTLAS(TLAS tlas, const std::vector<BLASInstance>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {});
     [[nodiscard]] bool updateTLAS(TLAS tlas, const std::vector<BLASInstance>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {});
+    // Record the build into commandBuffer without stalling, replaced acceleration structures and buffers are tracked by the command buffer
+    // Builds are followed by a barrier, so later ray tracing and ray queries in the same command buffer see the result
+    void rebuildTLAS(const CommandBuffer& commandBuffer, TLAS tlas, const std::vector<BLASInstance>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {});
+    [[nodiscard]] bool updateTLAS(const CommandBuffer& commandBuffer, TLAS tlas, const std::vector<BLASInstance>& blasInstances, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {});
+    // Updates the TLAS in place with the instances changed since its last build, update or refit. Recorded into commandBuffer, no host stall
+    // The TLAS must have been built with eAllowUpdate. Instances keep their index, unless one was destroyed or its BLAS is not built
+    // Updates cannot deactivate instances, so then the TLAS is rebuilt from the remaining instances, which keep their custom index but not their index
+    void refitTLAS(const CommandBuffer& commandBuffer, TLAS tlas);
+
+    // Frustum and distance culls blasInstances on the host and selects their LODs, then builds the TLAS from the survivors only
+    // So build time and memory scale with the visible instances. Instances with a negative instanceCustomIndex keep their position in blasInstances
+    void rebuildTLAS(const CommandBuffer& commandBuffer, TLAS tlas, const std::vector<BLASInstance>& blasInstances, const TLASCullingParameters& cullingParameters, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {});
+    // Returns false when different instances survived than were last built, LOD switches of the same instances are updated in place
+    [[nodiscard]] bool updateTLAS(const CommandBuffer& commandBuffer, TLAS tlas, const std::vector<BLASInstance>& blasInstances, const TLASCullingParameters& cullingParameters, vk::BuildAccelerationStructureFlagsKHR buildFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate, vk::GeometryFlagsKHR geometryFlags = {});
+    // Of the TLAS's last culled rebuild or update
+    TLASCullingStatistics getTLASCullingStatistics(TLAS tlas);
 }
 
 #endif
@@ -14,78 +14,107 @@ namespace ava
     extern bool hasShaderType(const std::vector<Shader>& shaders, vk::ShaderStageFlagBits stage);
     extern std::vector<uint32_t> getShaderIndicesFromType(const std::vector<Shader>& shaders, vk::ShaderStageFlagBits stage);
 
-    detail::ShaderBindingTable* createShaderBindingTable(vk::Pipeline pipeline, const uint32_t missShaderCount, const uint32_t hitShaderCount, const uint32_t callableShaderCount)
+    static uint32_t getRegionIndex(const ShaderBindingTableRegion region)
     {
-        const uint32_t handleCount = 1 + missShaderCount + hitShaderCount + callableShaderCount;
-        const vk::DeviceSize bufferSize = detail::State.rayTracingPipelineProperties.shaderGroupBaseAlignment * handleCount;
-        const uint32_t handleSize = detail::State.rayTracingPipelineProperties.shaderGroupHandleSize;
-        const uint32_t handleSizeAligned = ava::detail::alignUp(handleSize, detail::State.rayTracingPipelineProperties.shaderGroupHandleAlignment);
-
-        const auto buffer = ava::createBuffer(bufferSize, vk::BufferUsageFlagBits::eShaderBindingTableKHR | vk::BufferUsageFlagBits::eTransferSrc, MemoryLocation::eCpuToGpu, detail::State.rayTracingPipelineProperties.shaderGroupHandleAlignment);
+        return static_cast<uint32_t>(region);
+    }
 
-        const auto bufferAddress = detail::getBufferDeviceAddress(buffer);
-        const vk::StridedDeviceAddressRegionKHR rayGenRegion{bufferAddress, handleSizeAligned, handleSizeAligned * 1};
+    static vk::StridedDeviceAddressRegionKHR& getRegion(detail::ShaderBindingTable* shaderBindingTable, const ShaderBindingTableRegion region)
+    {
+        switch (region)
+        {
+        case ShaderBindingTableRegion::eRayGen:
+            return shaderBindingTable->rayGenRegion;
+        case ShaderBindingTableRegion::eMiss:
+            return shaderBindingTable->missRegion;
+        case ShaderBindingTableRegion::eHit:
+            return shaderBindingTable->hitRegion;
+        case ShaderBindingTableRegion::eCallable:
+            return shaderBindingTable->callableRegion;
+        default:
+            throw std::runtime_error("Unhandled shader binding table region");
+        }
+    }
 
-        const auto missRegionStart = detail::alignUp(rayGenRegion.size, static_cast<vk::DeviceSize>(detail::State.rayTracingPipelineProperties.shaderGroupBaseAlignment));
-        const vk::StridedDeviceAddressRegionKHR missRegion{bufferAddress + missRegionStart, handleSizeAligned, handleSizeAligned * missShaderCount};
+    ShaderBindingTable createShaderBindingTable(const RayTracingPipeline& rayTracingPipeline, const ShaderBindingTableCreationInfo& creationInfo)
+    {
+        AVA_CHECK(rayTracingPipeline != nullptr && rayTracingPipeline->pipeline, "Cannot create a shader binding table from an invalid ray tracing pipeline");
+        AVA_CHECK(!creationInfo.missRecords.empty(), "Cannot create a shader binding table without any miss records");
 
-        const auto hitRegionStart = missRegionStart + detail::alignUp(missRegion.size, static_cast<vk::DeviceSize>(detail::State.rayTracingPipelineProperties.shaderGroupBaseAlignment));
-        const vk::StridedDeviceAddressRegionKHR hitRegion{bufferAddress + hitRegionStart, handleSizeAligned, handleSizeAligned * hitShaderCount};
+        const auto& properties = detail::State.rayTracingPipelineProperties;
+        const uint32_t handleSize = properties.shaderGroupHandleSize;
+        const vk::DeviceSize baseAlignment = properties.shaderGroupBaseAlignment;
 
-        const auto callableRegionStart = hitRegionStart + detail::alignUp(hitRegion.size, static_cast<vk::DeviceSize>(detail::State.rayTracingPipelineProperties.shaderGroupBaseAlignment));
-        const vk::StridedDeviceAddressRegionKHR callableRegion{bufferAddress + callableRegionStart, handleSizeAligned, handleSizeAligned * callableShaderCount};
+        // Group handles of each region start at these indices in the pipeline's handles
+        const std::array<const std::vector<ShaderBindingTableRecord>*, 4> regionRecords{nullptr, &creationInfo.missRecords, &creationInfo.hitRecords, &creationInfo.callableRecords};
+        const uint32_t rayGenGroupCount = rayTracingPipeline->rayGenGroupCount;
+        const std::array<uint32_t, 4> groupStarts{0, rayGenGroupCount, rayGenGroupCount + rayTracingPipeline->missGroupCount, rayGenGroupCount + rayTracingPipeline->missGroupCount + rayTracingPipeline->hitGroupCount};
+        const std::array<uint32_t, 4> groupCounts{rayGenGroupCount, rayTracingPipeline->missGroupCount, rayTracingPipeline->hitGroupCount, rayTracingPipeline->callableGroupCount};
+        const std::array<uint32_t, 4> reservedDataSizes{creationInfo.rayGenDataSize, creationInfo.missDataSize, creationInfo.hitDataSize, creationInfo.callableDataSize};
 
-        const size_t dataSize = handleCount * handleSize;
-        const auto handles = detail::State.device.getRayTracingShaderGroupHandlesKHR<uint8_t>(pipeline, 0u, handleCount, dataSize, detail::State.dispatchLoader);
-        auto getHandle = [&](const uint32_t i) { return handles.data() + i * handleSize; };
+        auto getRecords = [&](const uint32_t region) -> std::vector<ShaderBindingTableRecord>
+        {
+            return (region == 0) ? std::vector{creationInfo.rayGenRecord} : *regionRecords[region];
+        };
 
-        const auto bufferMappedStart = buffer->mapped;
-        uint32_t handleIndex = 0;
+        const auto outShaderBindingTable = new detail::ShaderBindingTable();
+        outShaderBindingTable->pipeline = rayTracingPipeline->pipeline;
+        outShaderBindingTable->handleSize = handleSize;
 
-        auto bufferMapped = bufferMappedStart;
-        auto incrementBufferMapped = [&](const uint32_t i) { bufferMapped = reinterpret_cast<void*>(reinterpret_cast<size_t>(bufferMappedStart) + i); };
+        // Each region is a run of records with a stride that fits the handle and the largest inline data
+        std::array<vk::StridedDeviceAddressRegionKHR, 4> regions{};
+        vk::DeviceSize bufferSize = 0;
+        for (uint32_t region = 0; region < 4; region++)
+        {
+            const auto records = getRecords(region);
+            uint32_t dataSize = reservedDataSizes[region];
+            for (const auto& record : records)
+            {
+                AVA_CHECK(record.groupIndex < groupCounts[region], "Cannot create a shader binding table with a record whose group index exceeds the pipeline's groups of that type");
+                dataSize = std::max(dataSize, static_cast<uint32_t>(record.data.size()));
+            }
 
-        // RayGen handles
-        std::memcpy(bufferMapped, getHandle(handleIndex++), handleSize);
+            const uint32_t stride = detail::alignUp(handleSize + dataSize, properties.shaderGroupHandleAlignment);
+            AVA_CHECK(stride <= properties.maxShaderGroupStride, "Cannot create a shader binding table when a record's data exceeds maxShaderGroupStride");
 
-        // Miss handles
-        bufferMapped = reinterpret_cast<void*>(reinterpret_cast<size_t>(bufferMappedStart) + missRegionStart);
-        for (uint32_t i = 0; i < missShaderCount; i++)
-        {
-            std::memcpy(bufferMapped, getHandle(handleIndex++), handleSize);
-            incrementBufferMapped(missRegion.stride);
+            bufferSize = detail::alignUp(bufferSize, baseAlignment);
+            outShaderBindingTable->regionOffsets[region] = bufferSize;
+            outShaderBindingTable->recordCounts[region] = static_cast<uint32_t>(records.size());
+            outShaderBindingTable->dataSizes[region] = stride - handleSize;
+            regions[region].stride = stride;
+            regions[region].size = static_cast<vk::DeviceSize>(stride) * records.size();
+            bufferSize += regions[region].size;
         }
 
-        // Hit handles
-        bufferMapped = reinterpret_cast<void*>(reinterpret_cast<size_t>(bufferMappedStart) + hitRegionStart);
-        for (uint32_t i = 0; i < hitShaderCount; i++)
-        {
-            std::memcpy(bufferMapped, getHandle(handleIndex++), handleSize);
-            incrementBufferMapped(hitRegion.stride);
-        }
+        outShaderBindingTable->buffer = ava::createBuffer(bufferSize, vk::BufferUsageFlagBits::eShaderBindingTableKHR | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst, MemoryLocation::eCpuToGpu, baseAlignment);
+        const auto bufferAddress = detail::getBufferDeviceAddress(outShaderBindingTable->buffer);
+        const auto bufferMapped = static_cast<uint8_t*>(outShaderBindingTable->buffer->mapped);
 
-        // Callable handles
-        bufferMapped = reinterpret_cast<void*>(reinterpret_cast<size_t>(bufferMappedStart) + callableRegionStart);
-        for (uint32_t i = 0; i < callableShaderCount; i++)
+        for (uint32_t region = 0; region < 4; region++)
         {
-            std::memcpy(bufferMapped, getHandle(handleIndex++), handleSize);
-            incrementBufferMapped(callableRegion.stride);
+            regions[region].deviceAddress = bufferAddress + outShaderBindingTable->regionOffsets[region];
+
+            const auto records = getRecords(region);
+            for (size_t i = 0; i < records.size(); i++)
+            {
+                const auto recordMapped = bufferMapped + outShaderBindingTable->regionOffsets[region] + i * regions[region].stride;
+                std::memcpy(recordMapped, rayTracingPipeline->groupHandles.data() + static_cast<size_t>(groupStarts[region] + records[i].groupIndex) * handleSize, handleSize);
+                std::memset(recordMapped + handleSize, 0, regions[region].stride - handleSize);
+                if (!records[i].data.empty())
+                {
+                    std::memcpy(recordMapped + handleSize, records[i].data.data(), records[i].data.size());
+                }
+            }
         }
 
-        const auto outShaderBindingTable = new detail::ShaderBindingTable();
-        outShaderBindingTable->rayGenRegion = rayGenRegion;
-        outShaderBindingTable->missRegion = missRegion;
-        outShaderBindingTable->hitRegion = hitRegion;
-        outShaderBindingTable->callableRegion = callableRegion;
-        outShaderBindingTable->handleCount = handleCount;
-        outShaderBindingTable->missShaderCount = missShaderCount;
-        outShaderBindingTable->hitShaderCount = hitShaderCount;
-        outShaderBindingTable->callbackShaderCount = callableRegionStart;
-        outShaderBindingTable->buffer = buffer;
+        outShaderBindingTable->rayGenRegion = regions[0];
+        outShaderBindingTable->missRegion = regions[1];
+        outShaderBindingTable->hitRegion = regions[2];
+        outShaderBindingTable->callableRegion = regions[3];
         return outShaderBindingTable;
     }
 
-    void destroyShaderBindingTable(detail::ShaderBindingTable*& shaderBindingTable)
+    void destroyShaderBindingTable(ShaderBindingTable& shaderBindingTable)
     {
         AVA_CHECK_NO_EXCEPT_RETURN(shaderBindingTable != nullptr, "Cannot destroy invalid shader binding table");
 
@@ -95,41 +124,96 @@ namespace ava
         shaderBindingTable = nullptr;
     }
 
-    RayTracingPipeline createRayTracingPipeline(const RayTracingPipelineCreationInfo& creationInfo)
+    // Returns the byte offset of the data in the table's buffer
+    static vk::DeviceSize getShaderBindingTableRecordDataOffset(const ShaderBindingTable& shaderBindingTable, const ShaderBindingTableRegion region, const uint32_t recordIndex, const uint32_t size, const uint32_t offset)
     {
-        AVA_CHECK(detail::State.device, "Cannot create a ray tracing pipeline when State's device is invalid");
-        AVA_CHECK(detail::State.rayTracingEnabled, "Cannot create a ray tracing pipeline when ray tracing is not enabled");
-        AVA_CHECK(!creationInfo.shaders.empty(), "Cannot create ray tracing pipeline without shaders");
-        const auto raygenShaderIndices = getShaderIndicesFromType(creationInfo.shaders, vk::ShaderStageFlagBits::eRaygenKHR);
-        AVA_CHECK(!raygenShaderIndices.empty(), "Cannot create a ray tracing pipeline with no raygen shader");
-        AVA_CHECK(raygenShaderIndices.size() == 1, "Cannot create a ray tracing pipeline with more than 1 raygen shader");
-        const auto closestHitShaderIndices = getShaderIndicesFromType(creationInfo.shaders, vk::ShaderStageFlagBits::eClosestHitKHR);
-        AVA_CHECK(!closestHitShaderIndices.empty(), "Cannot create a ray tracing pipeline without any closest hit shaders");
-        const auto missShaderIndices = getShaderIndicesFromType(creationInfo.shaders, vk::ShaderStageFlagBits::eMissKHR);
-        AVA_CHECK(!missShaderIndices.empty(), "Cannot create a ray tracing pipeline without any miss shaders");
+        AVA_CHECK(shaderBindingTable != nullptr && shaderBindingTable->buffer != nullptr, "Cannot update the record data of an invalid shader binding table");
+        const auto regionIndex = getRegionIndex(region);
+        AVA_CHECK(recordIndex < shaderBindingTable->recordCounts[regionIndex], "Cannot update the data of a shader binding table record which does not exist");
+        AVA_CHECK(static_cast<vk::DeviceSize>(offset) + size <= shaderBindingTable->dataSizes[regionIndex], "Cannot update shader binding table record data beyond the data size reserved for the region's records");
 
-        const auto anyHitShaderIndices = getShaderIndicesFromType(creationInfo.shaders, vk::ShaderStageFlagBits::eAnyHitKHR);
-        const auto intersectionShaderIndices = getShaderIndicesFromType(creationInfo.shaders, vk::ShaderStageFlagBits::eIntersectionKHR);
-        const auto callableShaderIndices = getShaderIndicesFromType(creationInfo.shaders, vk::ShaderStageFlagBits::eCallableKHR);
+        return shaderBindingTable->regionOffsets[regionIndex] + static_cast<vk::DeviceSize>(recordIndex) * getRegion(shaderBindingTable, region).stride + shaderBindingTable->handleSize + offset;
+    }
+
+    void updateShaderBindingTableRecordData(const ShaderBindingTable& shaderBindingTable, const ShaderBindingTableRegion region, const uint32_t recordIndex, const void* data, const uint32_t size, const uint32_t offset)
+    {
+        AVA_CHECK(data != nullptr && size > 0, "Cannot update shader binding table record data with no data");
+        const auto dataOffset = getShaderBindingTableRecordDataOffset(shaderBindingTable, region, recordIndex, size, offset);
+        ava::updateBuffer(shaderBindingTable->buffer, data, size, dataOffset);
+    }
 
-        auto maxRayRecursionDepth = creationInfo.maxRayRecursionDepth;
+    void updateShaderBindingTableRecordData(const CommandBuffer& commandBuffer, const ShaderBindingTable& shaderBindingTable, const ShaderBindingTableRegion region, const uint32_t recordIndex, const void* data, const uint32_t size, const uint32_t offset)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot update shader binding table record data with an invalid command buffer");
+        AVA_CHECK(data != nullptr && size > 0, "Cannot update shader binding table record data with no data");
+        AVA_CHECK(size % 4 == 0 && offset % 4 == 0, "Cannot update shader binding table record data in a command buffer when the size or offset is not a multiple of 4");
+        const auto dataOffset = getShaderBindingTableRecordDataOffset(shaderBindingTable, region, recordIndex, size, offset);
+
+        // Earlier traces in the command buffer read the old data, later ones the new
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eRayTracingShaderKHR, vk::PipelineStageFlagBits::eTransfer, {}, nullptr, nullptr, nullptr);
+        commandBuffer->commandBuffer.updateBuffer(shaderBindingTable->buffer->buffer, dataOffset, size, data);
+
+        vk::BufferMemoryBarrier bufferMemoryBarrier{};
+        bufferMemoryBarrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        bufferMemoryBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+        bufferMemoryBarrier.srcQueueFamilyIndex = vk::QueueFamilyIgnored;
+        bufferMemoryBarrier.dstQueueFamilyIndex = vk::QueueFamilyIgnored;
+        bufferMemoryBarrier.buffer = shaderBindingTable->buffer->buffer;
+        bufferMemoryBarrier.offset = dataOffset;
+        bufferMemoryBarrier.size = size;
+        commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eRayTracingShaderKHR, {}, nullptr, bufferMemoryBarrier, nullptr);
+    }
+
+    uint32_t getShaderBindingTableRecordCount(const ShaderBindingTable& shaderBindingTable, const ShaderBindingTableRegion region)
+    {
+        AVA_CHECK(shaderBindingTable != nullptr, "Cannot get the record count of an invalid shader binding table");
+        return shaderBindingTable->recordCounts[getRegionIndex(region)];
+    }
+
+    static double millisecondsBetween(const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end)
+    {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    static uint32_t clampRayRecursionDepth(const uint32_t maxRayRecursionDepth)
+    {
         if (maxRayRecursionDepth > detail::State.rayTracingPipelineProperties.maxRayRecursionDepth)
         {
             AVA_WARN("Ray tracing pipeline's maxRayRecursionDepth is greater than rayTracingPipelineProperties' maxRayRecursionDepth, clamping");
-            maxRayRecursionDepth = detail::State.rayTracingPipelineProperties.maxRayRecursionDepth;
+            return detail::State.rayTracingPipelineProperties.maxRayRecursionDepth;
         }
+        return maxRayRecursionDepth;
+    }
 
+    static std::vector<vk::PipelineShaderStageCreateInfo> getShaderStageCreateInfos(const std::vector<Shader>& shaders)
+    {
         std::vector<vk::PipelineShaderStageCreateInfo> shaderStageCreateInfos{};
-        shaderStageCreateInfos.reserve(creationInfo.shaders.size());
-        for (auto& shader : creationInfo.shaders)
+        shaderStageCreateInfos.reserve(shaders.size());
+        for (auto& shader : shaders)
         {
+            AVA_CHECK(shader != nullptr && shader->module, "Cannot create a ray tracing pipeline with an invalid shader");
             shaderStageCreateInfos.emplace_back(vk::PipelineShaderStageCreateFlags{}, shader->stage, shader->module, shader->entry.c_str(), nullptr, nullptr); // TODO: Allow specialization constants
         }
+        return shaderStageCreateInfos;
+    }
 
-        std::vector<vk::RayTracingShaderGroupCreateInfoKHR> shaderGroups;
-        shaderGroups.reserve(creationInfo.shaders.size());
-        // First is the raygen
-        shaderGroups.emplace_back(vk::RayTracingShaderGroupTypeKHR::eGeneral, raygenShaderIndices.at(0), vk::ShaderUnusedKHR, vk::ShaderUnusedKHR, vk::ShaderUnusedKHR);
+    // Groups are the raygens, misses, hits then callables. Returns the number of groups of each ShaderBindingTableRegion
+    static std::array<uint32_t, 4> getShaderGroups(const std::vector<Shader>& shaders, std::vector<vk::RayTracingShaderGroupCreateInfoKHR>& shaderGroups)
+    {
+        const auto raygenShaderIndices = getShaderIndicesFromType(shaders, vk::ShaderStageFlagBits::eRaygenKHR);
+        const auto missShaderIndices = getShaderIndicesFromType(shaders, vk::ShaderStageFlagBits::eMissKHR);
+        const auto closestHitShaderIndices = getShaderIndicesFromType(shaders, vk::ShaderStageFlagBits::eClosestHitKHR);
+        const auto anyHitShaderIndices = getShaderIndicesFromType(shaders, vk::ShaderStageFlagBits::eAnyHitKHR);
+        const auto intersectionShaderIndices = getShaderIndicesFromType(shaders, vk::ShaderStageFlagBits::eIntersectionKHR);
+        const auto callableShaderIndices = getShaderIndicesFromType(shaders, vk::ShaderStageFlagBits::eCallableKHR);
+
+        shaderGroups.clear();
+        shaderGroups.reserve(shaders.size());
+        // First are the raygens
+        for (auto currentShaderIndex : raygenShaderIndices)
+        {
+            shaderGroups.emplace_back(vk::RayTracingShaderGroupTypeKHR::eGeneral, currentShaderIndex, vk::ShaderUnusedKHR, vk::ShaderUnusedKHR, vk::ShaderUnusedKHR);
+        }
 
         // Add the miss shaders
         for (auto currentShaderIndex : missShaderIndices)
@@ -172,10 +256,13 @@ namespace ava
             shaderGroups.emplace_back(vk::RayTracingShaderGroupTypeKHR::eGeneral, currentShaderIndex, vk::ShaderUnusedKHR, vk::ShaderUnusedKHR, vk::ShaderUnusedKHR);
         }
 
-        const auto [layoutBindings, pushConstants] = detail::reflect(creationInfo.shaders);
+        return {static_cast<uint32_t>(raygenShaderIndices.size()), static_cast<uint32_t>(missShaderIndices.size()), static_cast<uint32_t>(closestHitShaderIndices.size()), static_cast<uint32_t>(callableShaderIndices.size())};
+    }
 
+    static vk::PipelineLayout createRayTracingPipelineLayout(const std::vector<std::vector<vk::DescriptorSetLayoutBinding>>& layoutBindings, const std::vector<vk::PushConstantRange>& pushConstants, std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts)
+    {
         // Create descriptor set layouts
-        std::vector<vk::DescriptorSetLayout> descriptorSetLayouts;
+        descriptorSetLayouts.clear();
         descriptorSetLayouts.reserve(layoutBindings.size());
         for (auto& setLayouts : layoutBindings)
         {
@@ -188,7 +275,59 @@ namespace ava
         pipelineLayoutCreateInfo.setSetLayouts(descriptorSetLayouts);
         pipelineLayoutCreateInfo.setPushConstantRanges(pushConstants);
 
-        const auto pipelineLayout = detail::State.device.createPipelineLayout(pipelineLayoutCreateInfo);
+        return detail::State.device.createPipelineLayout(pipelineLayoutCreateInfo);
+    }
+
+    static void destroyRayTracingPipelineLayout(const vk::PipelineLayout layout, const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts)
+    {
+        if (layout != nullptr)
+        {
+            detail::State.device.destroyPipelineLayout(layout);
+        }
+        for (const auto& setLayout : descriptorSetLayouts)
+        {
+            detail::State.device.destroyDescriptorSetLayout(setLayout);
+        }
+    }
+
+    // Creates the pipeline's default table of one data-less record per group in declaration order
+    static void createDefaultShaderBindingTable(detail::RayTracingPipeline* rayTracingPipeline)
+    {
+        ShaderBindingTableCreationInfo shaderBindingTableCreationInfo{};
+        for (uint32_t i = 0; i < rayTracingPipeline->missGroupCount; i++)
+        {
+            shaderBindingTableCreationInfo.missRecords.push_back({i});
+        }
+        for (uint32_t i = 0; i < rayTracingPipeline->hitGroupCount; i++)
+        {
+            shaderBindingTableCreationInfo.hitRecords.push_back({i});
+        }
+        for (uint32_t i = 0; i < rayTracingPipeline->callableGroupCount; i++)
+        {
+            shaderBindingTableCreationInfo.callableRecords.push_back({i});
+        }
+        rayTracingPipeline->shaderBindingTable = createShaderBindingTable(rayTracingPipeline, shaderBindingTableCreationInfo);
+    }
+
+    RayTracingPipeline createRayTracingPipeline(const RayTracingPipelineCreationInfo& creationInfo)
+    {
+        AVA_CHECK(detail::State.device, "Cannot create a ray tracing pipeline when State's device is invalid");
+        AVA_CHECK(detail::State.rayTracingEnabled, "Cannot create a ray tracing pipeline when ray tracing is not enabled");
+        AVA_CHECK(!creationInfo.shaders.empty(), "Cannot create ray tracing pipeline without shaders");
+        const auto raygenShaderIndices = getShaderIndicesFromType(creationInfo.shaders, vk::ShaderStageFlagBits::eRaygenKHR);
+        AVA_CHECK(!raygenShaderIndices.empty(), "Cannot create a ray tracing pipeline with no raygen shader");
+        AVA_CHECK(raygenShaderIndices.size() == 1, "Cannot create a ray tracing pipeline with more than 1 raygen shader");
+        AVA_CHECK(hasShaderType(creationInfo.shaders, vk::ShaderStageFlagBits::eClosestHitKHR), "Cannot create a ray tracing pipeline without any closest hit shaders");
+        AVA_CHECK(hasShaderType(creationInfo.shaders, vk::ShaderStageFlagBits::eMissKHR), "Cannot create a ray tracing pipeline without any miss shaders");
+
+        const auto maxRayRecursionDepth = clampRayRecursionDepth(creationInfo.maxRayRecursionDepth);
+        const auto shaderStageCreateInfos = getShaderStageCreateInfos(creationInfo.shaders);
+        std::vector<vk::RayTracingShaderGroupCreateInfoKHR> shaderGroups;
+        const auto groupCounts = getShaderGroups(creationInfo.shaders, shaderGroups);
+
+        const auto [layoutBindings, pushConstants] = detail::reflect(creationInfo.shaders);
+        std::vector<vk::DescriptorSetLayout> descriptorSetLayouts;
+        const auto pipelineLayout = createRayTracingPipelineLayout(layoutBindings, pushConstants, descriptorSetLayouts);
 
         vk::RayTracingPipelineCreateInfoKHR rayTracingPipelineCreateInfo{};
         rayTracingPipelineCreateInfo.flags = {};
@@ -200,14 +339,18 @@ namespace ava
         rayTracingPipelineCreateInfo.setGroups(shaderGroups);
         rayTracingPipelineCreateInfo.pDynamicState = nullptr;
 
+        const auto creationStartTime = std::chrono::steady_clock::now();
         auto pipeline = detail::State.device.createRayTracingPipelineKHR(nullptr, nullptr, rayTracingPipelineCreateInfo, nullptr, detail::State.dispatchLoader);
+        const auto creationEndTime = std::chrono::steady_clock::now();
         if (pipeline.result != vk::Result::eSuccess)
         {
-            detail::State.device.destroyPipelineLayout(pipelineLayout);
+            destroyRayTracingPipelineLayout(pipelineLayout, descriptorSetLayouts);
             vk::detail::resultCheck(pipeline.result, "Failed to create ray tracing pipeline");
         }
 
-        auto shaderBindingTable = createShaderBindingTable(pipeline.value, missShaderIndices.size(), closestHitShaderIndices.size(), callableShaderIndices.size());
+        // Kept so shader binding tables can be created later without querying the handles again
+        const size_t groupHandlesSize = shaderGroups.size() * detail::State.rayTracingPipelineProperties.shaderGroupHandleSize;
+        const auto groupHandles = detail::State.device.getRayTracingShaderGroupHandlesKHR<uint8_t>(pipeline.value, 0u, static_cast<uint32_t>(shaderGroups.size()), groupHandlesSize, detail::State.dispatchLoader);
 
         auto outPipeline = new detail::RayTracingPipeline();
         outPipeline->layout = pipelineLayout;
@@ -215,26 +358,219 @@ namespace ava
         outPipeline->layoutBindings = layoutBindings;
         outPipeline->pushConstants = pushConstants;
         outPipeline->descriptorSetLayouts = descriptorSetLayouts;
-        outPipeline->shaderBindingTable = shaderBindingTable;
+        outPipeline->groupHandles = groupHandles;
+        outPipeline->rayGenGroupCount = groupCounts[0];
+        outPipeline->missGroupCount = groupCounts[1];
+        outPipeline->hitGroupCount = groupCounts[2];
+        outPipeline->callableGroupCount = groupCounts[3];
+        outPipeline->creationTime = millisecondsBetween(creationStartTime, creationEndTime);
+        outPipeline->libraryCreationTime = 0.0;
+
+        createDefaultShaderBindingTable(outPipeline);
         return outPipeline;
     }
 
-    void destroyRayTracingPipeline(RayTracingPipeline& rayTracingPipeline)
+    RayTracingPipelineLibrary createRayTracingPipelineLibrary(const RayTracingPipelineLibraryCreationInfo& creationInfo)
     {
-        AVA_CHECK_NO_EXCEPT_RETURN(rayTracingPipeline != nullptr, "Cannot destroy an invalid ray tracing pipeline");
+        AVA_CHECK(detail::State.device, "Cannot create a ray tracing pipeline library when State's device is invalid");
+        AVA_CHECK(detail::State.rayTracingEnabled, "Cannot create a ray tracing pipeline library when ray tracing is not enabled");
+        AVA_CHECK(detail::State.rayTracingPipelineLibraryEnabled, "Cannot create a ray tracing pipeline library when " + std::string(vk::KHRPipelineLibraryExtensionName) + " is not supported");
+        AVA_CHECK(!creationInfo.shaders.empty(), "Cannot create a ray tracing pipeline library without shaders");
+        AVA_CHECK(creationInfo.maxRayHitAttributeSize <= detail::State.rayTracingPipelineProperties.maxRayHitAttributeSize, "Cannot create a ray tracing pipeline library when maxRayHitAttributeSize exceeds rayTracingPipelineProperties' maxRayHitAttributeSize");
+        if (hasShaderType(creationInfo.shaders, vk::ShaderStageFlagBits::eAnyHitKHR) || hasShaderType(creationInfo.shaders, vk::ShaderStageFlagBits::eIntersectionKHR))
+        {
+            AVA_CHECK(hasShaderType(creationInfo.shaders, vk::ShaderStageFlagBits::eClosestHitKHR), "Cannot create a ray tracing pipeline library with any hit or intersection shaders but no closest hit shader to group them with");
+        }
 
-        if (rayTracingPipeline->pipeline != nullptr)
+        const auto maxRayRecursionDepth = clampRayRecursionDepth(creationInfo.maxRayRecursionDepth);
+        const auto shaderStageCreateInfos = getShaderStageCreateInfos(creationInfo.shaders);
+        std::vector<vk::RayTracingShaderGroupCreateInfoKHR> shaderGroups;
+        const auto groupCounts = getShaderGroups(creationInfo.shaders, shaderGroups);
+
+        // Every library linked into a pipeline needs a layout compatible with the pipeline's, so it is reflected from the shared layout shaders
+        const auto [layoutBindings, pushConstants] = detail::reflect(creationInfo.layoutShaders.empty() ? creationInfo.shaders : creationInfo.layoutShaders);
+        std::vector<vk::DescriptorSetLayout> descriptorSetLayouts;
+        const auto pipelineLayout = createRayTracingPipelineLayout(layoutBindings, pushConstants, descriptorSetLayouts);
+
+        vk::RayTracingPipelineInterfaceCreateInfoKHR libraryInterface{};
+        libraryInterface.maxPipelineRayPayloadSize = creationInfo.maxRayPayloadSize;
+        libraryInterface.maxPipelineRayHitAttributeSize = creationInfo.maxRayHitAttributeSize;
+
+        vk::RayTracingPipelineCreateInfoKHR rayTracingPipelineCreateInfo{};
+        rayTracingPipelineCreateInfo.flags = vk::PipelineCreateFlagBits::eLibraryKHR;
+        rayTracingPipelineCreateInfo.layout = pipelineLayout;
+        rayTracingPipelineCreateInfo.maxPipelineRayRecursionDepth = maxRayRecursionDepth;
+        rayTracingPipelineCreateInfo.basePipelineHandle = nullptr;
+        rayTracingPipelineCreateInfo.basePipelineIndex = -1;
+        rayTracingPipelineCreateInfo.setStages(shaderStageCreateInfos);
+        rayTracingPipelineCreateInfo.setGroups(shaderGroups);
+        rayTracingPipelineCreateInfo.pLibraryInterface = &libraryInterface;
+        rayTracingPipelineCreateInfo.pDynamicState = nullptr;
+
+        const auto creationStartTime = std::chrono::steady_clock::now();
+        auto pipeline = detail::State.device.createRayTracingPipelineKHR(nullptr, nullptr, rayTracingPipelineCreateInfo, nullptr, detail::State.dispatchLoader);
+        const auto creationEndTime = std::chrono::steady_clock::now();
+        if (pipeline.result != vk::Result::eSuccess)
         {
-            detail::State.device.destroyPipeline(rayTracingPipeline->pipeline);
+            destroyRayTracingPipelineLayout(pipelineLayout, descriptorSetLayouts);
+            vk::detail::resultCheck(pipeline.result, "Failed to create ray tracing pipeline library");
+        }
+
+        auto outLibrary = new detail::RayTracingPipelineLibrary();
+        outLibrary->pipeline = pipeline.value;
+        outLibrary->layout = pipelineLayout;
+        outLibrary->layoutBindings = layoutBindings;
+        outLibrary->pushConstants = pushConstants;
+        outLibrary->descriptorSetLayouts = descriptorSetLayouts;
+        outLibrary->groupCounts = groupCounts;
+        outLibrary->maxRayRecursionDepth = maxRayRecursionDepth;
+        outLibrary->maxRayPayloadSize = creationInfo.maxRayPayloadSize;
+        outLibrary->maxRayHitAttributeSize = creationInfo.maxRayHitAttributeSize;
+        outLibrary->creationTime = millisecondsBetween(creationStartTime, creationEndTime);
+        return outLibrary;
+    }
+
+    void destroyRayTracingPipelineLibrary(RayTracingPipelineLibrary& rayTracingPipelineLibrary)
+    {
+        AVA_CHECK_NO_EXCEPT_RETURN(rayTracingPipelineLibrary != nullptr, "Cannot destroy an invalid ray tracing pipeline library");
+
+        if (rayTracingPipelineLibrary->pipeline != nullptr)
+        {
+            detail::State.device.destroyPipeline(rayTracingPipelineLibrary->pipeline);
         }
-        if (rayTracingPipeline->layout != nullptr)
+        destroyRayTracingPipelineLayout(rayTracingPipelineLibrary->layout, rayTracingPipelineLibrary->descriptorSetLayouts);
+
+        delete rayTracingPipelineLibrary;
+        rayTracingPipelineLibrary = nullptr;
+    }
+
+    RayTracingPipeline linkRayTracingPipeline(const std::vector<RayTracingPipelineLibrary>& libraries)
+    {
+        AVA_CHECK(detail::State.device, "Cannot link a ray tracing pipeline when State's device is invalid");
+        AVA_CHECK(!libraries.empty(), "Cannot link a ray tracing pipeline without any libraries");
+
+        std::vector<vk::Pipeline> libraryPipelines;
+        libraryPipelines.reserve(libraries.size());
+        std::array<uint32_t, 4> groupCounts{};
+        double libraryCreationTime = 0.0;
+        for (const auto& library : libraries)
         {
-            detail::State.device.destroyPipelineLayout(rayTracingPipeline->layout);
+            AVA_CHECK(library != nullptr && library->pipeline, "Cannot link a ray tracing pipeline from an invalid library");
+            // The libraries' layouts must be compatible with the linked pipeline's, which is created from the first library's
+            AVA_CHECK(library->layoutBindings == libraries.front()->layoutBindings && library->pushConstants == libraries.front()->pushConstants, "Cannot link a ray tracing pipeline from libraries with different layouts, create them with the same layoutShaders");
+            AVA_CHECK(library->maxRayRecursionDepth == libraries.front()->maxRayRecursionDepth, "Cannot link a ray tracing pipeline from libraries with different maxRayRecursionDepths");
+            AVA_CHECK(library->maxRayPayloadSize == libraries.front()->maxRayPayloadSize && library->maxRayHitAttributeSize == libraries.front()->maxRayHitAttributeSize, "Cannot link a ray tracing pipeline from libraries with different ray payload or hit attribute sizes");
+
+            libraryPipelines.push_back(library->pipeline);
+            for (uint32_t region = 0; region < 4; region++)
+            {
+                groupCounts[region] += library->groupCounts[region];
+            }
+            libraryCreationTime += library->creationTime;
         }
-        for (const auto& setLayout : rayTracingPipeline->descriptorSetLayouts)
+        AVA_CHECK(groupCounts[0] > 0, "Cannot link a ray tracing pipeline from libraries with no raygen shader");
+        AVA_CHECK(groupCounts[1] > 0, "Cannot link a ray tracing pipeline from libraries without any miss shaders");
+
+        const auto& layoutBindings = libraries.front()->layoutBindings;
+        const auto& pushConstants = libraries.front()->pushConstants;
+        std::vector<vk::DescriptorSetLayout> descriptorSetLayouts;
+        const auto pipelineLayout = createRayTracingPipelineLayout(layoutBindings, pushConstants, descriptorSetLayouts);
+
+        vk::PipelineLibraryCreateInfoKHR libraryInfo{};
+        libraryInfo.setLibraries(libraryPipelines);
+
+        vk::RayTracingPipelineInterfaceCreateInfoKHR libraryInterface{};
+        libraryInterface.maxPipelineRayPayloadSize = libraries.front()->maxRayPayloadSize;
+        libraryInterface.maxPipelineRayHitAttributeSize = libraries.front()->maxRayHitAttributeSize;
+
+        // No stages or groups of its own, linking only composes the already compiled libraries
+        vk::RayTracingPipelineCreateInfoKHR rayTracingPipelineCreateInfo{};
+        rayTracingPipelineCreateInfo.flags = {};
+        rayTracingPipelineCreateInfo.layout = pipelineLayout;
+        rayTracingPipelineCreateInfo.maxPipelineRayRecursionDepth = libraries.front()->maxRayRecursionDepth;
+        rayTracingPipelineCreateInfo.basePipelineHandle = nullptr;
+        rayTracingPipelineCreateInfo.basePipelineIndex = -1;
+        rayTracingPipelineCreateInfo.pLibraryInfo = &libraryInfo;
+        rayTracingPipelineCreateInfo.pLibraryInterface = &libraryInterface;
+        rayTracingPipelineCreateInfo.pDynamicState = nullptr;
+
+        const auto linkStartTime = std::chrono::steady_clock::now();
+        auto pipeline = detail::State.device.createRayTracingPipelineKHR(nullptr, nullptr, rayTracingPipelineCreateInfo, nullptr, detail::State.dispatchLoader);
+        const auto linkEndTime = std::chrono::steady_clock::now();
+        if (pipeline.result != vk::Result::eSuccess)
         {
-            detail::State.device.destroyDescriptorSetLayout(setLayout);
+            destroyRayTracingPipelineLayout(pipelineLayout, descriptorSetLayouts);
+            vk::detail::resultCheck(pipeline.result, "Failed to link ray tracing pipeline");
         }
+
+        // The linked pipeline's groups are each library's groups in library order, so gather them back into raygen, miss, hit then callable order
+        const uint32_t handleSize = detail::State.rayTracingPipelineProperties.shaderGroupHandleSize;
+        const uint32_t groupCount = groupCounts[0] + groupCounts[1] + groupCounts[2] + groupCounts[3];
+        const auto linkedGroupHandles = detail::State.device.getRayTracingShaderGroupHandlesKHR<uint8_t>(pipeline.value, 0u, groupCount, static_cast<size_t>(groupCount) * handleSize, detail::State.dispatchLoader);
+
+        std::vector<uint8_t> groupHandles;
+        groupHandles.reserve(linkedGroupHandles.size());
+        for (uint32_t region = 0; region < 4; region++)
+        {
+            uint32_t libraryGroupStart = 0;
+            for (const auto& library : libraries)
+            {
+                uint32_t regionStart = libraryGroupStart;
+                for (uint32_t previousRegion = 0; previousRegion < region; previousRegion++)
+                {
+                    regionStart += library->groupCounts[previousRegion];
+                }
+
+                const auto handlesBegin = linkedGroupHandles.begin() + static_cast<ptrdiff_t>(regionStart) * handleSize;
+                groupHandles.insert(groupHandles.end(), handlesBegin, handlesBegin + static_cast<ptrdiff_t>(library->groupCounts[region]) * handleSize);
+                libraryGroupStart += library->groupCounts[0] + library->groupCounts[1] + library->groupCounts[2] + library->groupCounts[3];
+            }
+        }
+
+        auto outPipeline = new detail::RayTracingPipeline();
+        outPipeline->layout = pipelineLayout;
+        outPipeline->pipeline = pipeline.value;
+        outPipeline->layoutBindings = layoutBindings;
+        outPipeline->pushConstants = pushConstants;
+        outPipeline->descriptorSetLayouts = descriptorSetLayouts;
+        outPipeline->groupHandles = groupHandles;
+        outPipeline->rayGenGroupCount = groupCounts[0];
+        outPipeline->missGroupCount = groupCounts[1];
+        outPipeline->hitGroupCount = groupCounts[2];
+        outPipeline->callableGroupCount = groupCounts[3];
+        outPipeline->creationTime = millisecondsBetween(linkStartTime, linkEndTime);
+        outPipeline->libraryCreationTime = libraryCreationTime;
+
+        createDefaultShaderBindingTable(outPipeline);
+        return outPipeline;
+    }
+
+    RayTracingPipelineCreationTimes getRayTracingPipelineCreationTimes(const RayTracingPipeline& rayTracingPipeline)
+    {
+        AVA_CHECK(rayTracingPipeline != nullptr, "Cannot get the creation times of an invalid ray tracing pipeline");
+
+        RayTracingPipelineCreationTimes creationTimes{};
+        creationTimes.creationTime = rayTracingPipeline->creationTime;
+        creationTimes.libraryCreationTime = rayTracingPipeline->libraryCreationTime;
+        creationTimes.savedTime = (rayTracingPipeline->libraryCreationTime > 0.0) ? rayTracingPipeline->libraryCreationTime - rayTracingPipeline->creationTime : 0.0;
+        return creationTimes;
+    }
+
+    double getRayTracingPipelineLibraryCreationTime(const RayTracingPipelineLibrary& rayTracingPipelineLibrary)
+    {
+        AVA_CHECK(rayTracingPipelineLibrary != nullptr, "Cannot get the creation time of an invalid ray tracing pipeline library");
+        return rayTracingPipelineLibrary->creationTime;
+    }
+
+    void destroyRayTracingPipeline(RayTracingPipeline& rayTracingPipeline)
+    {
+        AVA_CHECK_NO_EXCEPT_RETURN(rayTracingPipeline != nullptr, "Cannot destroy an invalid ray tracing pipeline");
+
+        if (rayTracingPipeline->pipeline != nullptr)
+        {
+            detail::State.device.destroyPipeline(rayTracingPipeline->pipeline);
+        }
+        destroyRayTracingPipelineLayout(rayTracingPipeline->layout, rayTracingPipeline->descriptorSetLayouts);
         if (rayTracingPipeline->shaderBindingTable != nullptr)
         {
             destroyShaderBindingTable(rayTracingPipeline->shaderBindingTable);
@@ -249,6 +585,12 @@ namespace ava
         rayTracingPipelineCreationInfo.shaders = shaders;
     }
 
+    void populateRayTracingPipelineLibraryCreationInfo(RayTracingPipelineLibraryCreationInfo& rayTracingPipelineLibraryCreationInfo, const std::vector<Shader>& shaders, const std::vector<Shader>& layoutShaders)
+    {
+        rayTracingPipelineLibraryCreationInfo.shaders = shaders;
+        rayTracingPipelineLibraryCreationInfo.layoutShaders = layoutShaders;
+    }
+
     void bindRayTracingPipeline(const CommandBuffer& commandBuffer, const RayTracingPipeline& rayTracingPipeline)
     {
         AVA_CHECK(rayTracingPipeline != nullptr, "Cannot bind an invalid ray tracing pipeline to a command buffer");
@@ -270,4 +612,14 @@ namespace ava
         const auto& shaderBindingTable = commandBuffer->lastRayTracingPipeline->shaderBindingTable;
         commandBuffer->commandBuffer.traceRaysKHR(shaderBindingTable->rayGenRegion, shaderBindingTable->missRegion, shaderBindingTable->hitRegion, shaderBindingTable->callableRegion, width, height, depth, detail::State.dispatchLoader);
     }
+
+    void traceRays(const CommandBuffer& commandBuffer, const ShaderBindingTable& shaderBindingTable, const uint32_t width, const uint32_t height, const uint32_t depth)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot trace rays with an invalid command buffer");
+        AVA_CHECK(commandBuffer->pipelineCurrentlyBound && commandBuffer->currentPipelineBindPoint == vk::PipelineBindPoint::eRayTracingKHR, "Cannot trace rays when a ray tracing pipeline has not been bound");
+        AVA_CHECK(shaderBindingTable != nullptr, "Cannot trace rays with an invalid shader binding table");
+        AVA_CHECK(commandBuffer->lastRayTracingPipeline != nullptr && commandBuffer->lastRayTracingPipeline->pipeline == shaderBindingTable->pipeline, "Cannot trace rays with a shader binding table created from a different ray tracing pipeline than the bound one");
+
+        commandBuffer->commandBuffer.traceRaysKHR(shaderBindingTable->rayGenRegion, shaderBindingTable->missRegion, shaderBindingTable->hitRegion, shaderBindingTable->callableRegion, width, height, depth, detail::State.dispatchLoader);
+    }
 }
@@ -12,13 +12,89 @@ namespace ava
         uint32_t maxRayRecursionDepth = 1; // AMD's limits specify 1
     };
 
+    // Libraries compile their shader groups once so pipelines can be linked from them without recompiling, e.g. when adding a material's hit shader
+    struct RayTracingPipelineLibraryCreationInfo
+    {
+        // Grouped the same way as RayTracingPipelineCreationInfo's shaders, though a library can leave out any kind of shader
+        std::vector<ava::Shader> shaders{};
+        // Shaders the library's layout is reflected from, which must be the same for every library linked together. Usually every shader that will be linked, empty uses shaders
+        std::vector<ava::Shader> layoutShaders{};
+        // The following must match across linked libraries
+        uint32_t maxRayRecursionDepth = 1;
+        uint32_t maxRayPayloadSize = 64; // Bytes of the largest rayPayloadEXT
+        uint32_t maxRayHitAttributeSize = 8; // Bytes of the largest hitAttributeEXT, 8 fits the built-in triangle barycentrics
+    };
+
+    struct RayTracingPipelineCreationTimes
+    {
+        double creationTime; // Milliseconds spent creating the pipeline, or linking it when linked from libraries
+        double libraryCreationTime; // Milliseconds the linked libraries took to create, roughly what creating the pipeline monolithically costs
+        double savedTime; // libraryCreationTime less creationTime, 0 when not linked
+    };
+
+    enum class ShaderBindingTableRegion
+    {
+        eRayGen,
+        eMiss,
+        eHit,
+        eCallable,
+    };
+
+    // A group handle followed by inline data, which shaders read through shaderRecordEXT
+    struct ShaderBindingTableRecord
+    {
+        uint32_t groupIndex = 0; // Index of the group within its region in the pipeline, e.g. 1 is the pipeline's second hit group
+        std::vector<uint8_t> data{}; // Optional, such as material indices or buffer device addresses
+    };
+
+    // Records are laid out in the order given, so the same group can back any number of records
+    // Hits use hitRecords[instanceShaderBindingTableRecordOffset + geometryIndex * sbtRecordStride + sbtRecordOffset], where traceRayEXT's
+    // sbtRecordStride is the number of ray types and sbtRecordOffset the ray type. So each instance's records are one per ray type, in ray type order
+    struct ShaderBindingTableCreationInfo
+    {
+        ShaderBindingTableRecord rayGenRecord{};
+        std::vector<ShaderBindingTableRecord> missRecords{};
+        std::vector<ShaderBindingTableRecord> hitRecords{};
+        std::vector<ShaderBindingTableRecord> callableRecords{};
+        // Inline data bytes reserved per record, 0 uses the largest data of the region's records. Reserve more if updates grow the data
+        uint32_t rayGenDataSize = 0;
+        uint32_t missDataSize = 0;
+        uint32_t hitDataSize = 0;
+        uint32_t callableDataSize = 0;
+    };
+
     RayTracingPipeline createRayTracingPipeline(const RayTracingPipelineCreationInfo& creationInfo);
     void destroyRayTracingPipeline(RayTracingPipeline& rayTracingPipeline);
 
     void populateRayTracingPipelineCreationInfo(RayTracingPipelineCreationInfo& rayTracingPipelineCreationInfo, const std::vector<Shader>& shaders);
 
+    // Requires VK_KHR_pipeline_library, which is enabled alongside ray tracing when supported
+    RayTracingPipelineLibrary createRayTracingPipelineLibrary(const RayTracingPipelineLibraryCreationInfo& creationInfo);
+    void destroyRayTracingPipelineLibrary(RayTracingPipelineLibrary& rayTracingPipelineLibrary);
+    void populateRayTracingPipelineLibraryCreationInfo(RayTracingPipelineLibraryCreationInfo& rayTracingPipelineLibraryCreationInfo, const std::vector<Shader>& shaders, const std::vector<Shader>& layoutShaders = {});
+
+    // Links a pipeline from already compiled libraries, which together need a raygen and a miss shader. The libraries must outlive the pipeline
+    // Groups of each type are ordered by library, so hit group 0 is the first library's first hit group and the second library's hit groups follow the first's
+    RayTracingPipeline linkRayTracingPipeline(const std::vector<RayTracingPipelineLibrary>& libraries);
+
+    RayTracingPipelineCreationTimes getRayTracingPipelineCreationTimes(const RayTracingPipeline& rayTracingPipeline);
+    double getRayTracingPipelineLibraryCreationTime(const RayTracingPipelineLibrary& rayTracingPipelineLibrary);
+
+    // Pipelines come with a table of one data-less record per group in declaration order, which traceRays uses when not given a table
+    ShaderBindingTable createShaderBindingTable(const RayTracingPipeline& rayTracingPipeline, const ShaderBindingTableCreationInfo& creationInfo);
+    void destroyShaderBindingTable(ShaderBindingTable& shaderBindingTable);
+
+    // Rewrites part of a record's inline data in place, without recreating the table's buffer
+    // Writes through the table's mapping, so the table must not be in use by any command buffer still executing
+    void updateShaderBindingTableRecordData(const ShaderBindingTable& shaderBindingTable, ShaderBindingTableRegion region, uint32_t recordIndex, const void* data, uint32_t size, uint32_t offset = 0);
+    // Recorded into commandBuffer outside of a render pass, so traces already submitted keep the old data. size and offset must be multiples of 4
+    void updateShaderBindingTableRecordData(const CommandBuffer& commandBuffer, const ShaderBindingTable& shaderBindingTable, ShaderBindingTableRegion region, uint32_t recordIndex, const void* data, uint32_t size, uint32_t offset = 0);
+    uint32_t getShaderBindingTableRecordCount(const ShaderBindingTable& shaderBindingTable, ShaderBindingTableRegion region);
+
     void bindRayTracingPipeline(const CommandBuffer& commandBuffer, const RayTracingPipeline& rayTracingPipeline);
     void traceRays(const CommandBuffer& commandBuffer, uint32_t width, uint32_t height, uint32_t depth = 1);
+    // The table must have been created from the bound pipeline
+    void traceRays(const CommandBuffer& commandBuffer, const ShaderBindingTable& shaderBindingTable, uint32_t width, uint32_t height, uint32_t depth = 1);
 }
 
 #endif
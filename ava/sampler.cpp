@@ -31,11 +31,21 @@ ava::Sampler ava::createSampler(vk::Filter minMagFilter, vk::SamplerMipmapMode m
     samplerInfo.maxLod = vk::LodClampNone;
     samplerInfo.unnormalizedCoordinates = false;
 
+    for (const auto existingSampler : detail::State.samplerCache)
+    {
+        if (existingSampler->createInfo == samplerInfo)
+        {
+            existingSampler->referenceCount++;
+            return existingSampler;
+        }
+    }
+
     const auto sampler = detail::State.device.createSampler(samplerInfo);
 
     const auto outSampler = new detail::Sampler();
     outSampler->sampler = sampler;
     outSampler->createInfo = samplerInfo;
+    detail::State.samplerCache.push_back(outSampler);
     return outSampler;
 }
 
@@ -44,6 +54,12 @@ void ava::destroySampler(Sampler& sampler)
     AVA_CHECK_NO_EXCEPT_RETURN(sampler != nullptr, "Cannot destroy invalid sampler");
     AVA_CHECK_NO_EXCEPT_RETURN(detail::State.device, "Cannot destroy sampler when State's device is invalid");
 
+    if (--sampler->referenceCount > 0)
+    {
+        sampler = nullptr;
+        return;
+    }
+    std::erase(detail::State.samplerCache, sampler);
     if (sampler->sampler != nullptr)
     {
         detail::State.device.destroySampler(sampler->sampler);
@@ -6,6 +6,7 @@
 
 namespace ava
 {
+    // Identical create infos return the same reference counted sampler, which is destroyed once every destroySampler of it has been called
     [[nodiscard]] Sampler createSampler(vk::Filter minMagFilter = vk::Filter::eLinear, vk::SamplerMipmapMode mipFilter = vk::SamplerMipmapMode::eLinear, vk::SamplerAddressMode repeat = vk::SamplerAddressMode::eRepeat, float maxAnisotropy = 8.0f, std::optional<vk::CompareOp> compareOp = {});
     void destroySampler(Sampler& sampler);
     vk::Sampler getSampler(const Sampler& sampler);
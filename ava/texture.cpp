@@ -0,0 +1,108 @@
+#include "texture.hpp"
+
+#include "buffer.hpp"
+#include "commandBuffer.hpp"
+#include "detail/buffer.hpp"
+#include "detail/commandBuffer.hpp"
+#include "detail/detail.hpp"
+#include "detail/image.hpp"
+#include "detail/state.hpp"
+#include "detail/texture.hpp"
+#include "detail/utility.hpp"
+
+namespace ava
+{
+    static bool readTextureContainer(const detail::MappedFile& file, detail::TextureContainer& outContainer)
+    {
+        return detail::parseKTX2(file.data, file.size, outContainer) || detail::parseDDS(file.data, file.size, outContainer);
+    }
+
+    std::optional<TextureInfo> getTextureInfo(const std::string& fileName)
+    {
+        detail::MappedFile file;
+        if (!detail::mapFile(fileName, file))
+        {
+            return std::nullopt;
+        }
+
+        detail::TextureContainer container;
+        const bool valid = readTextureContainer(file, container);
+        detail::unmapFile(file);
+        if (!valid)
+        {
+            return std::nullopt;
+        }
+        return container.info;
+    }
+
+    bool isTextureFormatSupported(const vk::Format format, const vk::ImageUsageFlags usageFlags)
+    {
+        AVA_CHECK(detail::State.physicalDevice, "Cannot check texture format support when State's physical device is invalid");
+
+        const auto features = detail::State.physicalDevice.getFormatProperties(format).optimalTilingFeatures;
+        vk::FormatFeatureFlags requiredFeatures = vk::FormatFeatureFlagBits::eTransferDst;
+        if (usageFlags & vk::ImageUsageFlagBits::eSampled)
+        {
+            requiredFeatures |= vk::FormatFeatureFlagBits::eSampledImage;
+        }
+        if (usageFlags & vk::ImageUsageFlagBits::eStorage)
+        {
+            requiredFeatures |= vk::FormatFeatureFlagBits::eStorageImage;
+        }
+        if (usageFlags & vk::ImageUsageFlagBits::eTransferSrc)
+        {
+            requiredFeatures |= vk::FormatFeatureFlagBits::eTransferSrc;
+        }
+        return (features & requiredFeatures) == requiredFeatures;
+    }
+
+    Image loadTexture(const CommandBuffer& commandBuffer, const std::string& fileName, const vk::ImageUsageFlags usageFlags, const vk::ImageLayout finalLayout)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot load texture with an invalid command buffer");
+
+        detail::MappedFile file;
+        AVA_CHECK(detail::mapFile(fileName, file), "Cannot load texture when " + fileName + " cannot be opened");
+
+        detail::TextureContainer container;
+        const bool valid = readTextureContainer(file, container);
+        const auto& info = container.info;
+        const bool supported = valid && isTextureFormatSupported(info.format, usageFlags);
+
+        ava::Buffer stagingBuffer = nullptr;
+        std::vector<vk::BufferImageCopy> regions;
+        if (supported)
+        {
+            std::vector<detail::TextureSubresource> subresources;
+            const auto stagingSize = detail::getTextureUploadRegions(container, 0, info.mipLevels, 0, regions, subresources);
+
+            stagingBuffer = createBuffer(stagingSize, vk::BufferUsageFlagBits::eTransferSrc, MemoryLocation::eCpuToGpu, 0);
+            detail::copyTextureSubresources(file.data, subresources, regions, static_cast<uint8_t*>(stagingBuffer->mapped));
+            detail::State.allocator.flushAllocation(stagingBuffer->allocation, 0, stagingSize);
+        }
+        detail::unmapFile(file);
+
+        AVA_CHECK(valid, "Cannot load texture when " + fileName + " is not a KTX2 or DDS file, or its data is supercompressed or in an unsupported format");
+        AVA_CHECK(supported, "Cannot load texture " + fileName + " as its format " + vk::to_string(info.format) + " is not supported by the device");
+
+        const auto createFlags = info.cubeMap ? vk::ImageCreateFlags{vk::ImageCreateFlagBits::eCubeCompatible} : vk::ImageCreateFlags{};
+        auto image = createImage(info.extent, info.format, usageFlags | vk::ImageUsageFlagBits::eTransferDst, info.imageType, vk::ImageTiling::eOptimal, info.mipLevels, info.arrayLayers, vk::SampleCountFlagBits::e1, MemoryLocation::eGpuOnly, InitialImageLayout::eUndefined, createFlags);
+
+        transitionImageLayout(commandBuffer, image, vk::ImageLayout::eTransferDstOptimal, vk::ImageAspectFlagBits::eColor, vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer);
+        commandBuffer->commandBuffer.copyBufferToImage(stagingBuffer->buffer, image->image, vk::ImageLayout::eTransferDstOptimal, regions);
+        transitionImageLayout(commandBuffer, image, finalLayout, vk::ImageAspectFlagBits::eColor, vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands);
+
+        trackObject(commandBuffer, std::shared_ptr<void>(nullptr, [stagingBuffer](void*) mutable
+        {
+            destroyBuffer(stagingBuffer);
+        }));
+        return image;
+    }
+
+    Image loadTexture(const std::string& fileName, const vk::ImageUsageFlags usageFlags, const vk::ImageLayout finalLayout)
+    {
+        const auto commandBuffer = beginSingleTimeCommands(vk::QueueFlagBits::eTransfer);
+        auto image = loadTexture(commandBuffer, fileName, usageFlags, finalLayout);
+        endSingleTimeCommands(commandBuffer);
+        return image;
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef AVA_TEXTURE_HPP
+#define AVA_TEXTURE_HPP
+
+#include "types.hpp"
+#include "image.hpp"
+
+namespace ava
+{
+    struct TextureInfo
+    {
+        vk::Format format;
+        vk::Extent3D extent;
+        vk::ImageType imageType;
+        uint32_t mipLevels;
+        uint32_t arrayLayers; // Includes the 6 faces of each cube
+        bool cubeMap;
+    };
+
+    // Reads the header of a KTX2 or DDS file. Returns std::nullopt when the file cannot be read or its data cannot be uploaded as is, such as supercompressed KTX2
+    std::optional<TextureInfo> getTextureInfo(const std::string& fileName);
+    // Whether the device can copy to and use optimally tiled images of format with usageFlags, check before picking between BCn and ASTC variants of a texture
+    bool isTextureFormatSupported(vk::Format format, vk::ImageUsageFlags usageFlags = DEFAULT_IMAGE_SAMPLED_USAGE_FLAGS);
+
+    // Loads a KTX2 or DDS texture without decompressing it. The file is memory mapped and every mip and layer is copied into one staging buffer, then uploaded with one region per subresource
+    // Cube maps are created cube compatible. The image is left in finalLayout and the staging buffer is destroyed once commandBuffer has completed
+    [[nodiscard]] Image loadTexture(const CommandBuffer& commandBuffer, const std::string& fileName, vk::ImageUsageFlags usageFlags = DEFAULT_IMAGE_SAMPLED_USAGE_FLAGS, vk::ImageLayout finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal);
+    [[nodiscard]] Image loadTexture(const std::string& fileName, vk::ImageUsageFlags usageFlags = DEFAULT_IMAGE_SAMPLED_USAGE_FLAGS, vk::ImageLayout finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal);
+}
+
+#endif
@@ -0,0 +1,482 @@
+#include "textureStreamer.hpp"
+#include "detail/textureStreamer.hpp"
+
+#include <algorithm>
+#include "buffer.hpp"
+#include "commandBuffer.hpp"
+#include "image.hpp"
+#include "detail/buffer.hpp"
+#include "detail/commandBuffer.hpp"
+#include "detail/detail.hpp"
+#include "detail/image.hpp"
+#include "detail/state.hpp"
+#include "detail/utility.hpp"
+
+namespace ava
+{
+    static vk::ImageUsageFlags getStreamedImageUsage(const detail::StreamedTexture* texture)
+    {
+        return texture->usageFlags | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc;
+    }
+
+    // Memory requirements of images with no memory bound, as the budget has to count what the device allocates rather than the file's (often compressed) sizes
+    static std::vector<vk::DeviceSize> getMipMemorySizes(const detail::StreamedTexture* texture)
+    {
+        const auto& info = texture->container.info;
+        std::vector<vk::DeviceSize> sizes;
+        for (uint32_t firstMip = 0; firstMip < info.mipLevels; firstMip++)
+        {
+            vk::ImageCreateInfo createInfo{};
+            createInfo.flags = info.cubeMap ? vk::ImageCreateFlags{vk::ImageCreateFlagBits::eCubeCompatible} : vk::ImageCreateFlags{};
+            createInfo.imageType = info.imageType;
+            createInfo.format = info.format;
+            createInfo.extent = detail::getMipExtent(info.extent, firstMip);
+            createInfo.mipLevels = info.mipLevels - firstMip;
+            createInfo.arrayLayers = info.arrayLayers;
+            createInfo.samples = vk::SampleCountFlagBits::e1;
+            createInfo.tiling = vk::ImageTiling::eOptimal;
+            createInfo.usage = getStreamedImageUsage(texture);
+            // createImage drops the usage the same way
+            if ((createInfo.usage & vk::ImageUsageFlagBits::eHostTransferEXT) && !isHostImageCopySupported(info.format))
+            {
+                createInfo.usage &= ~vk::ImageUsageFlags{vk::ImageUsageFlagBits::eHostTransferEXT};
+            }
+            createInfo.sharingMode = vk::SharingMode::eExclusive;
+            createInfo.initialLayout = vk::ImageLayout::eUndefined;
+
+            const auto image = detail::State.device.createImage(createInfo);
+            sizes.push_back(detail::State.device.getImageMemoryRequirements(image).size);
+            detail::State.device.destroyImage(image);
+        }
+        return sizes;
+    }
+
+    // Growth of the texture's resident size were mips [firstMip, mipLevels) resident
+    static vk::DeviceSize getExtraSize(const detail::StreamedTexture* texture, const uint32_t firstMip)
+    {
+        const auto size = texture->mipMemorySizes.at(firstMip);
+        return size > texture->residentSize ? size - texture->residentSize : 0;
+    }
+
+    // Replaces the texture's image with one holding mips [newResidentMip, mipLevels). Mips both images hold are copied across, the rest come from the staging buffer
+    static void setResidentMips(const CommandBuffer& commandBuffer, detail::StreamedTexture* texture, const uint32_t newResidentMip, ava::Buffer stagingBuffer, const std::vector<vk::BufferImageCopy>& regions)
+    {
+        const auto& info = texture->container.info;
+        const auto createFlags = info.cubeMap ? vk::ImageCreateFlags{vk::ImageCreateFlagBits::eCubeCompatible} : vk::ImageCreateFlags{};
+        const auto usageFlags = getStreamedImageUsage(texture);
+        auto image = createImage(detail::getMipExtent(info.extent, newResidentMip), info.format, usageFlags, info.imageType, vk::ImageTiling::eOptimal, info.mipLevels - newResidentMip, info.arrayLayers,
+                                 vk::SampleCountFlagBits::e1, MemoryLocation::eGpuOnly, InitialImageLayout::eUndefined, createFlags);
+        transitionImageLayout(commandBuffer, image, vk::ImageLayout::eTransferDstOptimal, vk::ImageAspectFlagBits::eColor, vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer);
+
+        auto oldImage = texture->image;
+        auto oldImageView = texture->imageView;
+        if (oldImage != nullptr)
+        {
+            transitionImageLayout(commandBuffer, oldImage, vk::ImageLayout::eTransferSrcOptimal, vk::ImageAspectFlagBits::eColor, vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer);
+
+            std::vector<vk::ImageCopy> copies;
+            for (uint32_t mip = std::max(newResidentMip, texture->residentMip); mip < info.mipLevels; mip++)
+            {
+                vk::ImageCopy copy{};
+                copy.srcSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, mip - texture->residentMip, 0, info.arrayLayers};
+                copy.dstSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, mip - newResidentMip, 0, info.arrayLayers};
+                copy.extent = detail::getMipExtent(info.extent, mip);
+                copies.push_back(copy);
+            }
+            commandBuffer->commandBuffer.copyImage(oldImage->image, vk::ImageLayout::eTransferSrcOptimal, image->image, vk::ImageLayout::eTransferDstOptimal, copies);
+        }
+        if (stagingBuffer != nullptr && !regions.empty())
+        {
+            commandBuffer->commandBuffer.copyBufferToImage(stagingBuffer->buffer, image->image, vk::ImageLayout::eTransferDstOptimal, regions);
+        }
+        transitionImageLayout(commandBuffer, image, vk::ImageLayout::eShaderReadOnlyOptimal, vk::ImageAspectFlagBits::eColor, vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands);
+
+        trackObject(commandBuffer, std::shared_ptr<void>(nullptr, [oldImage, oldImageView, stagingBuffer](void*) mutable
+        {
+            if (oldImageView != nullptr)
+            {
+                destroyImageView(oldImageView);
+            }
+            if (oldImage != nullptr)
+            {
+                destroyImage(oldImage);
+            }
+            if (stagingBuffer != nullptr)
+            {
+                destroyBuffer(stagingBuffer);
+            }
+        }));
+
+        const auto newResidentSize = image->allocationInfo.size;
+        texture->streamer->residentSize = texture->streamer->residentSize - texture->residentSize + newResidentSize;
+        texture->residentSize = newResidentSize;
+        texture->residentMip = newResidentMip;
+        texture->image = image;
+        texture->imageView = createImageView(image, vk::ImageAspectFlagBits::eColor, detail::getTextureImageViewType(info));
+    }
+
+    // Body of the I/O thread, reads queued loads into their staging buffers
+    static void streamTextures(detail::TextureStreamer* streamer)
+    {
+        while (true)
+        {
+            std::shared_ptr<detail::StreamingLoad> load;
+            bool cancelled;
+            {
+                std::unique_lock lock(streamer->mutex);
+                streamer->condition.wait(lock, [streamer] { return streamer->stopping || !streamer->queuedLoads.empty(); });
+                if (streamer->stopping)
+                {
+                    return;
+                }
+                load = std::move(streamer->queuedLoads.front());
+                streamer->queuedLoads.pop_front();
+                cancelled = load->cancelled;
+            }
+
+            if (!cancelled)
+            {
+                detail::MappedFile file;
+                load->failed = !detail::mapFile(load->fileName, file);
+                if (!load->failed)
+                {
+                    // The file could have changed since it was added
+                    load->failed = std::ranges::any_of(load->subresources, [&file](const detail::TextureSubresource& subresource)
+                    {
+                        return subresource.offset + subresource.size > file.size;
+                    });
+                    if (!load->failed)
+                    {
+                        detail::copyTextureSubresources(file.data, load->subresources, load->regions, static_cast<uint8_t*>(load->stagingBuffer->mapped));
+                        detail::State.allocator.flushAllocation(load->stagingBuffer->allocation, 0, load->stagingBuffer->size);
+                    }
+                    detail::unmapFile(file);
+                }
+            }
+
+            std::scoped_lock lock(streamer->mutex);
+            streamer->completedLoads.push_back(std::move(load));
+        }
+    }
+
+    TextureStreamer createTextureStreamer(const TextureStreamerCreationInfo& creationInfo)
+    {
+        AVA_CHECK(detail::State.device, "Cannot create a texture streamer when State's device is invalid");
+        AVA_CHECK(creationInfo.maxPendingLoads > 0, "Cannot create a texture streamer with a maxPendingLoads of 0");
+
+        const auto outStreamer = new detail::TextureStreamer();
+        outStreamer->memoryBudget = creationInfo.memoryBudget;
+        outStreamer->tailMaxExtent = std::max(creationInfo.tailMaxExtent, 1u);
+        outStreamer->maxPendingLoads = creationInfo.maxPendingLoads;
+        outStreamer->evictionDelay = creationInfo.evictionDelay;
+        outStreamer->residentSize = 0;
+        outStreamer->pendingSize = 0;
+        outStreamer->pendingLoadCount = 0;
+        outStreamer->updateIndex = 0;
+        outStreamer->loadsCompleted = 0;
+        outStreamer->texturesLowered = 0;
+        outStreamer->stopping = false;
+        outStreamer->ioThread = std::thread(streamTextures, outStreamer);
+        return outStreamer;
+    }
+
+    void destroyTextureStreamer(TextureStreamer& streamer)
+    {
+        AVA_CHECK_NO_EXCEPT_RETURN(streamer != nullptr, "Cannot destroy an invalid texture streamer");
+        AVA_CHECK_NO_EXCEPT_RETURN(detail::State.device, "Cannot destroy texture streamer when State's device is invalid");
+
+        {
+            std::scoped_lock lock(streamer->mutex);
+            streamer->stopping = true;
+        }
+        streamer->condition.notify_all();
+        if (streamer->ioThread.joinable())
+        {
+            streamer->ioThread.join();
+        }
+
+        for (auto& load : streamer->queuedLoads)
+        {
+            destroyBuffer(load->stagingBuffer);
+        }
+        for (auto& load : streamer->completedLoads)
+        {
+            destroyBuffer(load->stagingBuffer);
+        }
+        streamer->queuedLoads.clear();
+        streamer->completedLoads.clear();
+
+        for (auto& texture : streamer->textures)
+        {
+            destroyImageView(texture->imageView);
+            destroyImage(texture->image);
+            delete texture;
+        }
+        streamer->textures.clear();
+        for (auto& [image, imageView] : streamer->retiredImages)
+        {
+            destroyImageView(imageView);
+            destroyImage(image);
+        }
+        streamer->retiredImages.clear();
+
+        delete streamer;
+        streamer = nullptr;
+    }
+
+    StreamedTexture addStreamedTexture(const CommandBuffer& commandBuffer, const TextureStreamer& streamer, const std::string& fileName, const vk::ImageUsageFlags usageFlags)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot add a streamed texture with an invalid command buffer");
+        AVA_CHECK(streamer != nullptr, "Cannot add a streamed texture to an invalid texture streamer");
+
+        detail::MappedFile file;
+        AVA_CHECK(detail::mapFile(fileName, file), "Cannot add streamed texture when " + fileName + " cannot be opened");
+
+        detail::TextureContainer container;
+        const bool valid = detail::parseKTX2(file.data, file.size, container) || detail::parseDDS(file.data, file.size, container);
+        if (!valid)
+        {
+            detail::unmapFile(file);
+        }
+        AVA_CHECK(valid, "Cannot add streamed texture when " + fileName + " is not a KTX2 or DDS file, or its data is supercompressed or in an unsupported format");
+
+        const auto& info = container.info;
+        const bool supported = isTextureFormatSupported(info.format, usageFlags | vk::ImageUsageFlagBits::eTransferSrc);
+
+        uint32_t tailMip = 0;
+        ava::Buffer stagingBuffer = nullptr;
+        std::vector<vk::BufferImageCopy> regions;
+        if (supported)
+        {
+            // The tail is every mip no larger than tailMaxExtent, or the last mip when none are
+            tailMip = info.mipLevels - 1;
+            while (tailMip > 0 && std::max(info.extent.width >> (tailMip - 1), info.extent.height >> (tailMip - 1)) <= streamer->tailMaxExtent)
+            {
+                tailMip--;
+            }
+
+            std::vector<detail::TextureSubresource> subresources;
+            const auto stagingSize = detail::getTextureUploadRegions(container, tailMip, info.mipLevels - tailMip, tailMip, regions, subresources);
+
+            stagingBuffer = createBuffer(stagingSize, vk::BufferUsageFlagBits::eTransferSrc, MemoryLocation::eCpuToGpu, 0);
+            detail::copyTextureSubresources(file.data, subresources, regions, static_cast<uint8_t*>(stagingBuffer->mapped));
+            detail::State.allocator.flushAllocation(stagingBuffer->allocation, 0, stagingSize);
+        }
+        detail::unmapFile(file);
+
+        AVA_CHECK(supported, "Cannot add streamed texture " + fileName + " as its format " + vk::to_string(info.format) + " is not supported by the device");
+
+        const auto outTexture = new detail::StreamedTexture();
+        outTexture->container = std::move(container);
+        outTexture->streamer = streamer;
+        outTexture->fileName = fileName;
+        outTexture->usageFlags = usageFlags;
+        outTexture->image = nullptr;
+        outTexture->imageView = nullptr;
+        outTexture->residentMip = outTexture->container.info.mipLevels;
+        outTexture->tailMip = tailMip;
+        outTexture->residentSize = 0;
+        outTexture->requestedMip = detail::STREAMED_TEXTURE_NO_REQUEST;
+        outTexture->lastRequestedUpdate = streamer->updateIndex;
+        outTexture->mipMemorySizes = getMipMemorySizes(outTexture);
+        setResidentMips(commandBuffer, outTexture, tailMip, stagingBuffer, regions);
+
+        streamer->textures.push_back(outTexture);
+        return outTexture;
+    }
+
+    void removeStreamedTexture(StreamedTexture& texture)
+    {
+        AVA_CHECK_NO_EXCEPT_RETURN(texture != nullptr && texture->streamer != nullptr, "Cannot remove an invalid streamed texture");
+
+        const auto streamer = texture->streamer;
+        if (texture->pendingLoad != nullptr)
+        {
+            std::scoped_lock lock(streamer->mutex);
+            texture->pendingLoad->cancelled = true;
+            texture->pendingLoad->texture = nullptr;
+        }
+
+        streamer->retiredImages.emplace_back(texture->image, texture->imageView);
+        streamer->residentSize -= texture->residentSize;
+        std::erase(streamer->textures, texture);
+
+        delete texture;
+        texture = nullptr;
+    }
+
+    void requestStreamedTextureMip(const StreamedTexture& texture, const uint32_t mipLevel)
+    {
+        AVA_CHECK(texture != nullptr, "Cannot request a mip of an invalid streamed texture");
+        texture->requestedMip = std::min(texture->requestedMip, mipLevel);
+    }
+
+    void updateTextureStreamer(const CommandBuffer& commandBuffer, const TextureStreamer& streamer)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot update a texture streamer with an invalid command buffer");
+        AVA_CHECK(streamer != nullptr, "Cannot update an invalid texture streamer");
+
+        streamer->updateIndex++;
+        streamer->loadsCompleted = 0;
+        streamer->texturesLowered = 0;
+
+        if (!streamer->retiredImages.empty())
+        {
+            trackObject(commandBuffer, std::shared_ptr<void>(nullptr, [retiredImages = std::move(streamer->retiredImages)](void*) mutable
+            {
+                for (auto& [image, imageView] : retiredImages)
+                {
+                    destroyImageView(imageView);
+                    destroyImage(image);
+                }
+            }));
+            streamer->retiredImages.clear();
+        }
+
+        // Raise the residency of textures whose loads have been read
+        std::vector<std::shared_ptr<detail::StreamingLoad>> completedLoads;
+        {
+            std::scoped_lock lock(streamer->mutex);
+            completedLoads.swap(streamer->completedLoads);
+        }
+        for (auto& load : completedLoads)
+        {
+            streamer->pendingLoadCount--;
+            streamer->pendingSize -= load->extraSize;
+
+            const auto texture = load->texture;
+            if (texture == nullptr || load->failed)
+            {
+                if (texture != nullptr)
+                {
+                    AVA_WARN("Failed to stream mips of texture " + texture->fileName + ", its residency is unchanged");
+                    texture->pendingLoad = nullptr;
+                }
+                destroyBuffer(load->stagingBuffer);
+                continue;
+            }
+
+            texture->pendingLoad = nullptr;
+            setResidentMips(commandBuffer, texture, load->firstMip, load->stagingBuffer, load->regions);
+            load->stagingBuffer = nullptr;
+            streamer->loadsCompleted++;
+        }
+
+        // The mip each texture wants, textures not requested for evictionDelay updates only want their tail
+        std::vector<std::pair<detail::StreamedTexture*, uint32_t>> wantedMips;
+        wantedMips.reserve(streamer->textures.size());
+        for (const auto texture : streamer->textures)
+        {
+            uint32_t wantedMip = texture->residentMip;
+            if (texture->requestedMip != detail::STREAMED_TEXTURE_NO_REQUEST)
+            {
+                wantedMip = std::min(texture->requestedMip, texture->tailMip);
+                texture->lastRequestedUpdate = streamer->updateIndex;
+            }
+            else if (streamer->updateIndex - texture->lastRequestedUpdate > streamer->evictionDelay)
+            {
+                wantedMip = texture->tailMip;
+            }
+            texture->requestedMip = detail::STREAMED_TEXTURE_NO_REQUEST;
+            wantedMips.emplace_back(texture, wantedMip);
+        }
+
+        // Lower textures resident finer than they want, least recently requested first. Recently requested ones are only lowered while over budget
+        std::ranges::sort(wantedMips, {}, [](const auto& wanted) { return wanted.first->lastRequestedUpdate; });
+        for (const auto& [texture, wantedMip] : wantedMips)
+        {
+            if (wantedMip <= texture->residentMip || texture->pendingLoad != nullptr)
+            {
+                continue;
+            }
+            const bool evicted = streamer->updateIndex - texture->lastRequestedUpdate > streamer->evictionDelay;
+            if (!evicted && streamer->residentSize <= streamer->memoryBudget)
+            {
+                continue;
+            }
+            setResidentMips(commandBuffer, texture, wantedMip, nullptr, {});
+            streamer->texturesLowered++;
+        }
+
+        // Queue loads of the textures missing the most mips first, stepping a load's first mip coarser until it fits the budget
+        std::ranges::stable_sort(wantedMips, std::ranges::greater{}, [](const auto& wanted) { return static_cast<int64_t>(wanted.first->residentMip) - static_cast<int64_t>(wanted.second); });
+        for (const auto& [texture, wantedMip] : wantedMips)
+        {
+            if (streamer->pendingLoadCount >= streamer->maxPendingLoads)
+            {
+                break;
+            }
+            if (wantedMip >= texture->residentMip || texture->pendingLoad != nullptr)
+            {
+                continue;
+            }
+
+            uint32_t firstMip = wantedMip;
+            vk::DeviceSize extraSize = getExtraSize(texture, firstMip);
+            while (firstMip < texture->residentMip && streamer->residentSize + streamer->pendingSize + extraSize > streamer->memoryBudget)
+            {
+                firstMip++;
+                extraSize = getExtraSize(texture, firstMip);
+            }
+            if (firstMip >= texture->residentMip)
+            {
+                continue;
+            }
+
+            const auto load = std::make_shared<detail::StreamingLoad>();
+            load->texture = texture;
+            load->fileName = texture->fileName;
+            load->firstMip = firstMip;
+            load->extraSize = extraSize;
+            const auto stagingSize = detail::getTextureUploadRegions(texture->container, firstMip, texture->residentMip - firstMip, firstMip, load->regions, load->subresources);
+            load->stagingBuffer = createBuffer(stagingSize, vk::BufferUsageFlagBits::eTransferSrc, MemoryLocation::eCpuToGpu, 0);
+
+            texture->pendingLoad = load;
+            streamer->pendingLoadCount++;
+            streamer->pendingSize += extraSize;
+            {
+                std::scoped_lock lock(streamer->mutex);
+                streamer->queuedLoads.push_back(load);
+            }
+            streamer->condition.notify_one();
+        }
+    }
+
+    Image getStreamedTextureImage(const StreamedTexture& texture)
+    {
+        AVA_CHECK(texture != nullptr, "Cannot get the image of an invalid streamed texture");
+        return texture->image;
+    }
+
+    ImageView getStreamedTextureImageView(const StreamedTexture& texture)
+    {
+        AVA_CHECK(texture != nullptr, "Cannot get the image view of an invalid streamed texture");
+        return texture->imageView;
+    }
+
+    uint32_t getStreamedTextureResidentMip(const StreamedTexture& texture)
+    {
+        AVA_CHECK(texture != nullptr, "Cannot get the resident mip of an invalid streamed texture");
+        return texture->residentMip;
+    }
+
+    TextureInfo getStreamedTextureInfo(const StreamedTexture& texture)
+    {
+        AVA_CHECK(texture != nullptr, "Cannot get the info of an invalid streamed texture");
+        return texture->container.info;
+    }
+
+    TextureStreamerStatistics getTextureStreamerStatistics(const TextureStreamer& streamer)
+    {
+        AVA_CHECK(streamer != nullptr, "Cannot get statistics of an invalid texture streamer");
+
+        TextureStreamerStatistics statistics{};
+        statistics.textureCount = static_cast<uint32_t>(streamer->textures.size());
+        statistics.residentSize = streamer->residentSize;
+        statistics.memoryBudget = streamer->memoryBudget;
+        statistics.pendingLoads = streamer->pendingLoadCount;
+        statistics.loadsCompleted = streamer->loadsCompleted;
+        statistics.texturesLowered = streamer->texturesLowered;
+        return statistics;
+    }
+}
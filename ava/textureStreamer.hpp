@@ -0,0 +1,52 @@
+#ifndef AVA_TEXTURESTREAMER_HPP
+#define AVA_TEXTURESTREAMER_HPP
+
+#include "types.hpp"
+#include "texture.hpp"
+
+namespace ava
+{
+    struct TextureStreamerCreationInfo
+    {
+        vk::DeviceSize memoryBudget = 256ull * 1024 * 1024; // Bytes of image memory of resident mips across all textures. Tail mips stay resident even over budget
+        uint32_t tailMaxExtent = 64; // Textures start with, and are never lowered past, the mips no larger than this
+        uint32_t maxPendingLoads = 8; // Loads queued on the I/O thread at once
+        uint32_t evictionDelay = 120; // Updates a texture goes without requests before its streamed mips are evicted
+    };
+
+    struct TextureStreamerStatistics
+    {
+        uint32_t textureCount;
+        vk::DeviceSize residentSize;
+        vk::DeviceSize memoryBudget;
+        uint32_t pendingLoads;
+        uint32_t loadsCompleted; // During the last update
+        uint32_t texturesLowered; // During the last update
+    };
+
+    // Streams the mips of KTX2 and DDS textures in and out on a background I/O thread, as they are requested and within a memory budget
+    [[nodiscard]] TextureStreamer createTextureStreamer(const TextureStreamerCreationInfo& creationInfo = {});
+    // Waits for the I/O thread, then destroys every texture still in the streamer. None of them can be in use by the GPU
+    void destroyTextureStreamer(TextureStreamer& streamer);
+
+    // Uploads only the texture's tail mips into commandBuffer, finer mips are streamed in once requested
+    [[nodiscard]] StreamedTexture addStreamedTexture(const CommandBuffer& commandBuffer, const TextureStreamer& streamer, const std::string& fileName, vk::ImageUsageFlags usageFlags = vk::ImageUsageFlagBits::eSampled);
+    // The texture's image is destroyed once the streamer's next update has completed
+    void removeStreamedTexture(StreamedTexture& texture);
+
+    // LOD feedback of the finest mip the texture is sampled at, several requests between updates keep the finest
+    void requestStreamedTextureMip(const StreamedTexture& texture, uint32_t mipLevel);
+    // Once per frame on a graphics command buffer, before the streamed textures are bound. Never waits on I/O
+    // Applies loads the I/O thread has finished, lowers textures no longer requested and queues loads of requested mips while within budget
+    void updateTextureStreamer(const CommandBuffer& commandBuffer, const TextureStreamer& streamer);
+
+    // Both change whenever the resident mips do, so rebind them after each update. Old ones stay valid until the update's command buffer completes
+    // Mip 0 of the image and view is the finest resident mip, so sampling never reaches mips which are not resident
+    Image getStreamedTextureImage(const StreamedTexture& texture);
+    ImageView getStreamedTextureImageView(const StreamedTexture& texture);
+    uint32_t getStreamedTextureResidentMip(const StreamedTexture& texture);
+    TextureInfo getStreamedTextureInfo(const StreamedTexture& texture);
+    TextureStreamerStatistics getTextureStreamerStatistics(const TextureStreamer& streamer);
+}
+
+#endif
@@ -0,0 +1,221 @@
+#include "transientImageSet.hpp"
+#include "detail/transientImageSet.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include "detail/commandBuffer.hpp"
+#include "detail/detail.hpp"
+#include "detail/image.hpp"
+#include "detail/state.hpp"
+#include "detail/utility.hpp"
+
+namespace ava
+{
+    static bool doPassesOverlap(const detail::TransientImage& a, const detail::TransientImage& b)
+    {
+        return a.firstPass <= b.lastPass && b.firstPass <= a.lastPass;
+    }
+
+    // First fit below, between or above the placed images of the block whose passes overlap
+    static vk::DeviceSize findTransientImageOffset(const detail::TransientImageSet* transientImageSet, const std::vector<size_t>& placedImages, const detail::TransientImage& image, const vk::DeviceSize alignment)
+    {
+        std::vector<const detail::TransientImage*> overlapping;
+        for (const auto index : placedImages)
+        {
+            const auto& other = transientImageSet->images[index];
+            if (other.block == image.block && doPassesOverlap(image, other))
+            {
+                overlapping.push_back(&other);
+            }
+        }
+        std::ranges::sort(overlapping, {}, &detail::TransientImage::offset);
+
+        vk::DeviceSize offset = 0;
+        for (const auto other : overlapping)
+        {
+            if (detail::alignUp(offset, alignment) + image.size <= other->offset)
+            {
+                break;
+            }
+            offset = std::max(offset, other->offset + other->size);
+        }
+        return detail::alignUp(offset, alignment);
+    }
+
+    TransientImageSet createTransientImageSet(const std::vector<TransientImageCreationInfo>& creationInfos)
+    {
+        AVA_CHECK(!creationInfos.empty(), "Cannot create a transient image set without any images");
+        AVA_CHECK(detail::State.device, "Cannot create a transient image set when State's device is invalid");
+        AVA_CHECK(detail::State.allocator, "Cannot create a transient image set without a valid State allocator");
+        for (const auto& creationInfo : creationInfos)
+        {
+            AVA_CHECK(creationInfo.extent.width > 0 && creationInfo.extent.height > 0 && creationInfo.extent.depth > 0, "Invalid image extent when creating transient image set");
+            AVA_CHECK(creationInfo.firstPass <= creationInfo.lastPass, "Cannot create a transient image whose first pass is after its last pass");
+        }
+
+        const auto outSet = new detail::TransientImageSet();
+        outSet->blockBytes = 0;
+        outSet->imageBytes = 0;
+        outSet->images.resize(creationInfos.size());
+
+        // Images are created unbound first, as their memory requirements are needed to place them
+        std::vector<vk::MemoryRequirements> memoryRequirements(creationInfos.size());
+        for (size_t i = 0; i < creationInfos.size(); i++)
+        {
+            const auto& creationInfo = creationInfos[i];
+            vk::ImageCreateInfo createInfo;
+            createInfo.imageType = creationInfo.imageType;
+            createInfo.extent = creationInfo.extent;
+            createInfo.tiling = vk::ImageTiling::eOptimal;
+            createInfo.mipLevels = creationInfo.mipLevels;
+            createInfo.arrayLayers = creationInfo.arrayLayers;
+            createInfo.format = creationInfo.format;
+            createInfo.initialLayout = vk::ImageLayout::eUndefined;
+            createInfo.usage = creationInfo.usageFlags;
+            createInfo.samples = creationInfo.samples;
+            createInfo.sharingMode = vk::SharingMode::eExclusive;
+
+            const auto image = new detail::Image();
+            image->image = detail::State.device.createImage(createInfo);
+            image->allocation = nullptr;
+            image->imageLayout = vk::ImageLayout::eUndefined;
+            image->creationInfo = createInfo;
+
+            memoryRequirements[i] = detail::State.device.getImageMemoryRequirements(image->image);
+            auto& transientImage = outSet->images[i];
+            transientImage.image = image;
+            transientImage.firstPass = creationInfo.firstPass;
+            transientImage.lastPass = creationInfo.lastPass;
+            transientImage.size = memoryRequirements[i].size;
+            image->allocationInfo.size = memoryRequirements[i].size;
+            outSet->imageBytes += memoryRequirements[i].size;
+        }
+
+        // Largest first, so smaller images fill the gaps between them
+        std::vector<size_t> order(creationInfos.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::stable_sort(order, std::greater{}, [&](const size_t index) { return memoryRequirements[index].size; });
+
+        std::vector<vk::MemoryRequirements> blockRequirements;
+        std::vector<size_t> placedImages;
+        for (const auto index : order)
+        {
+            const auto& requirements = memoryRequirements[index];
+            auto& transientImage = outSet->images[index];
+
+            // Blocks are shared by images with a common memory type
+            uint32_t block = 0;
+            while (block < blockRequirements.size() && !(blockRequirements[block].memoryTypeBits & requirements.memoryTypeBits))
+            {
+                block++;
+            }
+            if (block == blockRequirements.size())
+            {
+                blockRequirements.push_back(vk::MemoryRequirements{0, requirements.alignment, requirements.memoryTypeBits});
+            }
+
+            transientImage.block = block;
+            transientImage.offset = findTransientImageOffset(outSet, placedImages, transientImage, requirements.alignment);
+            placedImages.push_back(index);
+
+            auto& blockRequirement = blockRequirements[block];
+            blockRequirement.size = std::max(blockRequirement.size, transientImage.offset + transientImage.size);
+            blockRequirement.alignment = std::max(blockRequirement.alignment, requirements.alignment);
+            blockRequirement.memoryTypeBits &= requirements.memoryTypeBits;
+        }
+
+        vma::AllocationCreateInfo allocInfo;
+        allocInfo.usage = getMemoryUsageFromBufferLocation(MemoryLocation::eGpuOnly);
+        for (const auto& requirements : blockRequirements)
+        {
+            vma::AllocationInfo allocationInfo;
+            outSet->blocks.push_back(detail::State.allocator.allocateMemory(requirements, allocInfo, &allocationInfo));
+            outSet->blockBytes += allocationInfo.size;
+        }
+        for (const auto& transientImage : outSet->images)
+        {
+            detail::State.allocator.bindImageMemory2(outSet->blocks[transientImage.block], transientImage.offset, transientImage.image->image, nullptr);
+        }
+
+        detail::State.imageMemory.count += static_cast<uint32_t>(outSet->images.size());
+        detail::State.imageMemory.bytes += outSet->blockBytes;
+        return outSet;
+    }
+
+    void destroyTransientImageSet(TransientImageSet& transientImageSet)
+    {
+        AVA_CHECK_NO_EXCEPT_RETURN(transientImageSet != nullptr, "Cannot destroy an invalid transient image set");
+        AVA_CHECK_NO_EXCEPT_RETURN(detail::State.device, "Cannot destroy transient image set when State's device is invalid");
+
+        // The images have no allocation of their own, so destroyImage only destroys their handles
+        for (auto& transientImage : transientImageSet->images)
+        {
+            destroyImage(transientImage.image);
+        }
+        for (const auto block : transientImageSet->blocks)
+        {
+            detail::State.allocator.freeMemory(block);
+        }
+        detail::State.imageMemory.count -= static_cast<uint32_t>(transientImageSet->images.size());
+        detail::State.imageMemory.bytes -= transientImageSet->blockBytes;
+
+        delete transientImageSet;
+        transientImageSet = nullptr;
+    }
+
+    ava::Image getTransientImage(const TransientImageSet& transientImageSet, const uint32_t index)
+    {
+        AVA_CHECK(transientImageSet != nullptr, "Cannot get a transient image from an invalid transient image set");
+        AVA_CHECK(index < transientImageSet->images.size(), "Cannot get transient image " + std::to_string(index) + " when the transient image set has " + std::to_string(transientImageSet->images.size()) + " images");
+
+        return transientImageSet->images[index].image;
+    }
+
+    void beginTransientPass(const CommandBuffer& commandBuffer, const TransientImageSet& transientImageSet, const uint32_t passIndex)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot begin a transient pass with an invalid command buffer");
+        AVA_CHECK(transientImageSet != nullptr, "Cannot begin a transient pass with an invalid transient image set");
+
+        std::vector<vk::ImageMemoryBarrier> barriers;
+        for (const auto& transientImage : transientImageSet->images)
+        {
+            if (transientImage.firstPass != passIndex)
+            {
+                continue;
+            }
+
+            const auto image = transientImage.image;
+            const auto& createInfo = image->creationInfo;
+            image->imageLayout = getOptimalImageLayout(createInfo.usage, createInfo.format);
+
+            // Discards the contents of whichever image used the memory last, this frame or the frame before
+            vk::ImageMemoryBarrier barrier{};
+            barrier.srcAccessMask = vk::AccessFlagBits::eMemoryWrite;
+            barrier.dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite;
+            barrier.oldLayout = vk::ImageLayout::eUndefined;
+            barrier.newLayout = image->imageLayout;
+            barrier.srcQueueFamilyIndex = vk::QueueFamilyIgnored;
+            barrier.dstQueueFamilyIndex = vk::QueueFamilyIgnored;
+            barrier.image = image->image;
+            barrier.subresourceRange = vk::ImageSubresourceRange{getImageAspectFlagsForFormat(createInfo.format), 0, createInfo.mipLevels, 0, createInfo.arrayLayers};
+            barriers.push_back(barrier);
+        }
+
+        if (!barriers.empty())
+        {
+            commandBuffer->commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eAllCommands, {}, nullptr, nullptr, barriers);
+        }
+    }
+
+    TransientImageSetStatistics getTransientImageSetStatistics(const TransientImageSet& transientImageSet)
+    {
+        AVA_CHECK(transientImageSet != nullptr, "Cannot get statistics of an invalid transient image set");
+
+        TransientImageSetStatistics statistics{};
+        statistics.imageCount = static_cast<uint32_t>(transientImageSet->images.size());
+        statistics.blockCount = static_cast<uint32_t>(transientImageSet->blocks.size());
+        statistics.blockBytes = transientImageSet->blockBytes;
+        statistics.imageBytes = transientImageSet->imageBytes;
+        return statistics;
+    }
+}
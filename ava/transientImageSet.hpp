@@ -0,0 +1,49 @@
+#ifndef AVA_TRANSIENTIMAGESET_HPP
+#define AVA_TRANSIENTIMAGESET_HPP
+
+#include "types.hpp"
+#include "image.hpp"
+
+namespace ava
+{
+    struct TransientImageCreationInfo
+    {
+        vk::Extent3D extent;
+        vk::Format format;
+        vk::ImageUsageFlags usageFlags = DEFAULT_IMAGE_COLOR_ATTACHMENT_USAGE_FLAGS;
+        vk::ImageType imageType = vk::ImageType::e2D;
+        uint32_t mipLevels = 1;
+        uint32_t arrayLayers = 1;
+        vk::SampleCountFlagBits samples = vk::SampleCountFlagBits::e1;
+
+        // Indices of the first and last passes of the frame using the image, both inclusive
+        // Images whose passes do not overlap can share memory
+        uint32_t firstPass = 0;
+        uint32_t lastPass = 0;
+    };
+
+    struct TransientImageSetStatistics
+    {
+        uint32_t imageCount;
+        uint32_t blockCount;
+        vk::DeviceSize blockBytes; // Device memory the set holds
+        vk::DeviceSize imageBytes; // Memory the images would hold with an allocation each
+    };
+
+    // Places images whose contents only live within a frame, such as G-buffers and depth or MSAA targets, in shared blocks of memory
+    // Images with overlapping passes never share memory. Their contents are undefined at the start of their first pass each frame
+    // The images are owned by the set, so they must not be destroyed with destroyImage nor moved by defragmentation
+    [[nodiscard]] TransientImageSet createTransientImageSet(const std::vector<TransientImageCreationInfo>& creationInfos);
+    void destroyTransientImageSet(TransientImageSet& transientImageSet);
+
+    // In the order of the creation infos
+    ava::Image getTransientImage(const TransientImageSet& transientImageSet, uint32_t index);
+
+    // Call before recording each pass, including passes which use no transient images
+    // Records the aliasing barriers of images whose first pass is passIndex, which wait on earlier users of their memory and transition them from eUndefined to their optimal layout
+    void beginTransientPass(const CommandBuffer& commandBuffer, const TransientImageSet& transientImageSet, uint32_t passIndex);
+
+    TransientImageSetStatistics getTransientImageSetStatistics(const TransientImageSet& transientImageSet);
+}
+
+#endif
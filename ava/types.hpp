@@ -28,6 +28,17 @@ namespace ava
         struct BLASInstance;
         struct TLAS;
         struct RayTracingPipeline;
+        struct RayTracingPipelineLibrary;
+        struct ShaderBindingTable;
+        struct CullingPass;
+        struct GeometryArena;
+        struct ArenaMesh;
+        struct InstanceBuffer;
+        struct TextureStreamer;
+        struct StreamedTexture;
+        struct MemoryPool;
+        struct Defragmentation;
+        struct TransientImageSet;
     }
 
     using CommandBuffer = std::shared_ptr<detail::CommandBuffer>;
@@ -50,6 +61,17 @@ namespace ava
     using BLASInstance = detail::BLASInstance*;
     using TLAS = detail::TLAS*;
     using RayTracingPipeline = detail::RayTracingPipeline*;
+    using RayTracingPipelineLibrary = detail::RayTracingPipelineLibrary*;
+    using ShaderBindingTable = detail::ShaderBindingTable*;
+    using CullingPass = detail::CullingPass*;
+    using GeometryArena = detail::GeometryArena*;
+    using ArenaMesh = detail::ArenaMesh*;
+    using InstanceBuffer = detail::InstanceBuffer*;
+    using TextureStreamer = detail::TextureStreamer*;
+    using StreamedTexture = detail::StreamedTexture*;
+    using MemoryPool = detail::MemoryPool*;
+    using Defragmentation = detail::Defragmentation*;
+    using TransientImageSet = detail::TransientImageSet*;
 }
 
 #endif
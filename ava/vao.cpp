@@ -2,6 +2,7 @@
 #include "detail/vao.hpp"
 
 #include "detail/detail.hpp"
+#include <optional>
 
 namespace ava
 {
@@ -33,6 +34,21 @@ namespace ava
         return bindings;
     }
 
+    static vk::VertexInputRate getVertexBindingInputRate(const std::vector<VertexAttribute>& attributes, const uint32_t binding)
+    {
+        std::optional<vk::VertexInputRate> inputRate;
+        for (const auto& attribute : attributes)
+        {
+            if (attribute.binding != binding)
+            {
+                continue;
+            }
+            AVA_CHECK(!inputRate.has_value() || inputRate.value() == attribute.inputRate, "Vertex attributes of binding " + std::to_string(binding) + " have mismatching input rates");
+            inputRate = attribute.inputRate;
+        }
+        return inputRate.value_or(vk::VertexInputRate::eVertex);
+    }
+
     static std::vector<VertexAttribute> fixupVertexAttributes(const std::vector<VertexAttribute>& attributes, std::vector<uint32_t>* strides)
     {
         AVA_CHECK(!attributes.empty(), "Vertex attribute vector is empty, cannot create VAO");
@@ -44,17 +60,20 @@ namespace ava
         attributeIndices.resize(maxBinding + 1, 0u);
         attributeOffsets.resize(maxBinding + 1, 0u);
 
+        // Locations are shared across bindings, so automatic locations continue on from the previous attribute
+        uint32_t nextLocation = 0;
         std::vector<VertexAttribute> result;
         for (const auto& attribute : attributes)
         {
             const auto binding = attribute.binding;
             AVA_CHECK(attribute.format != vk::Format::eUndefined, "Vertex attribute " + std::to_string(attributeIndices.at(binding)) + " has an invalid format");
-            uint32_t location = attribute.location == VertexAttribute::AUTO_LOCATION ? attributeIndices[binding] : attribute.location;
+            uint32_t location = attribute.location == VertexAttribute::AUTO_LOCATION ? nextLocation : attribute.location;
             uint32_t offset = attribute.offset == VertexAttribute::AUTO_OFFSET ? attributeOffsets[binding] : attribute.offset;
 
-            result.emplace_back(attribute.format, location, offset, binding);
+            result.emplace_back(attribute.format, location, offset, binding, attribute.inputRate);
 
             attributeIndices[binding]++;
+            nextLocation = location + 1;
             attributeOffsets[binding] += vertexAttributeByteWidth(attribute);
         }
 
@@ -81,7 +100,7 @@ namespace ava
         uint32_t strideIndex = 0;
         for (auto& binding : bindings)
         {
-            bindingDescriptions.emplace_back(binding, strides[strideIndex++], vk::VertexInputRate::eVertex);
+            bindingDescriptions.emplace_back(binding, strides[strideIndex++], getVertexBindingInputRate(vertexAttributes, binding));
         }
 
         auto outVAO = new detail::VAO;
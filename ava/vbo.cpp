@@ -7,6 +7,7 @@
 #include "detail/detail.hpp"
 #include "detail/vao.hpp"
 #include "detail/state.hpp"
+#include <algorithm>
 
 namespace ava
 {
@@ -53,4 +54,40 @@ namespace ava
 
         commandBuffer->commandBuffer.bindVertexBuffers(vbo->binding, vbo->buffer->buffer, {0u});
     }
+
+    void bindVBO(const CommandBuffer& commandBuffer, const std::vector<VBO>& vbos)
+    {
+        AVA_CHECK(commandBuffer != nullptr && commandBuffer->commandBuffer, "Cannot bind VBOs to an invalid command buffer");
+        AVA_CHECK(commandBuffer->pipelineCurrentlyBound, "Cannot bind VBOs when a pipeline has not yet been bound");
+        for (const auto& vbo : vbos)
+        {
+            AVA_CHECK(vbo != nullptr && vbo->buffer && vbo->buffer->buffer, "Cannot bind an invalid VBO");
+        }
+
+        auto sorted = vbos;
+        std::ranges::sort(sorted, {}, &detail::VBO::binding);
+
+        std::vector<vk::Buffer> buffers;
+        std::vector<vk::DeviceSize> offsets;
+        uint32_t firstBinding = 0;
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            if (buffers.empty())
+            {
+                firstBinding = sorted[i]->binding;
+            }
+            AVA_CHECK(i == 0 || sorted[i - 1]->binding != sorted[i]->binding, "Cannot bind multiple VBOs to the same binding (" + std::to_string(sorted[i]->binding) + ")");
+
+            buffers.push_back(sorted[i]->buffer->buffer);
+            offsets.push_back(0u);
+
+            // Flush the run when the next VBO's binding is not consecutive
+            if (i + 1 == sorted.size() || sorted[i + 1]->binding != sorted[i]->binding + 1)
+            {
+                commandBuffer->commandBuffer.bindVertexBuffers(firstBinding, buffers, offsets);
+                buffers.clear();
+                offsets.clear();
+            }
+        }
+    }
 }
@@ -23,6 +23,8 @@ namespace ava
     void destroyVBO(VBO& vbo);
 
     void bindVBO(const CommandBuffer& commandBuffer, const VBO& vbo);
+    // Binds each VBO at its own binding, VBOs with consecutive bindings are bound in a single call
+    void bindVBO(const CommandBuffer& commandBuffer, const std::vector<VBO>& vbos);
 }
 
 #endif
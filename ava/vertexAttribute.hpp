@@ -14,6 +14,16 @@ namespace ava
         uint32_t location = AUTO_LOCATION;
         uint32_t offset = AUTO_OFFSET;
         uint32_t binding = 0;
+        // Every attribute sharing a binding must use the same input rate
+        vk::VertexInputRate inputRate = vk::VertexInputRate::eVertex;
+
+        // Returns a copy of this attribute that advances once per instance rather than once per vertex
+        [[nodiscard]] constexpr VertexAttribute perInstance() const
+        {
+            VertexAttribute result = *this;
+            result.inputRate = vk::VertexInputRate::eInstance;
+            return result;
+        }
 
         constexpr static VertexAttribute CreateFloat(const uint32_t location = AUTO_LOCATION, const uint32_t offset = AUTO_OFFSET, const uint32_t binding = 0)
         {
@@ -0,0 +1,5 @@
+# Writes the bytes of a SPIR-V file as a comma separated list, to be #included into a std::vector<uint8_t> initializer
+# cmake -DINPUT=<file.spv> -DOUTPUT=<file.spv.inl> -P embed_spirv.cmake
+file(READ "${INPUT}" SPIRV_HEX HEX)
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," SPIRV_BYTES "${SPIRV_HEX}")
+file(WRITE "${OUTPUT}" "${SPIRV_BYTES}\n")
@@ -1,3 +1,5 @@
+set(AVA_EMBED_SPIRV_SCRIPT "${CMAKE_CURRENT_LIST_DIR}/embed_spirv.cmake")
+
 function(compile_shaders_glslc TARGET_NAME BINRELOUTDIR)
     set(SHADER_SOURCE_FILES ${ARGN})
 
@@ -31,4 +33,31 @@ function(compile_shaders_glslc TARGET_NAME BINRELOUTDIR)
             BYPRODUCTS ${SHADER_PRODUCTS})
     add_dependencies(${TARGET_NAME} "${TARGET_NAME}GLSLShaders")
 
-endfunction()
\ No newline at end of file
+endfunction()
+
+# Compiles shaders into the target's build directory as <shader>.spv.inl, for #including into a std::vector<uint8_t> initializer
+function(embed_shaders_glslc TARGET_NAME)
+    set(SHADER_SOURCE_FILES ${ARGN})
+    set(EMBED_OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/embedded_shaders")
+
+    set(EMBED_PRODUCTS)
+    foreach (SHADER_SOURCE IN LISTS SHADER_SOURCE_FILES)
+        cmake_path(ABSOLUTE_PATH SHADER_SOURCE NORMALIZE)
+        cmake_path(GET SHADER_SOURCE FILENAME SHADER_NAME)
+
+        set(SHADER_SPIRV "${EMBED_OUTPUT_DIR}/${SHADER_NAME}.spv")
+        add_custom_command(
+                OUTPUT "${SHADER_SPIRV}.inl"
+                COMMAND ${CMAKE_COMMAND} -E make_directory "${EMBED_OUTPUT_DIR}"
+                COMMAND Vulkan::glslc "--target-env=vulkan1.2" "-O" "${SHADER_SOURCE}" "-o" "${SHADER_SPIRV}"
+                COMMAND ${CMAKE_COMMAND} "-DINPUT=${SHADER_SPIRV}" "-DOUTPUT=${SHADER_SPIRV}.inl" -P "${AVA_EMBED_SPIRV_SCRIPT}"
+                DEPENDS "${SHADER_SOURCE}" "${AVA_EMBED_SPIRV_SCRIPT}"
+                BYPRODUCTS "${SHADER_SPIRV}"
+                COMMENT "Embedding GLSL Shader ${SHADER_NAME} [${TARGET_NAME}]")
+
+        list(APPEND EMBED_PRODUCTS "${SHADER_SPIRV}.inl")
+    endforeach ()
+
+    target_sources(${TARGET_NAME} PRIVATE ${EMBED_PRODUCTS})
+    target_include_directories(${TARGET_NAME} PRIVATE "${EMBED_OUTPUT_DIR}")
+endfunction()
@@ -146,6 +146,7 @@ public:
     void resize() override
     {
         AvaFramework::resize();
+        ava::raii::retire(std::move(framebuffers));
         framebuffers = ava::raii::Framebuffer::createSwapchain(renderPass);
     }
 };
@@ -31,6 +31,8 @@ class Deferred final : public AvaFramework
 public:
     Deferred() : AvaFramework("AVA Deferred")
     {
+        // resize() rebinds descriptor sets which frames in flight are still using
+        idleOnResize = true;
     }
 
     ~Deferred() override = default;
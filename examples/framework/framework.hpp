@@ -32,6 +32,9 @@ public:
     VkSurfaceKHR surface = nullptr;
     bool vsync = true;
     vk::Format surfaceFormat = vk::Format::eB8G8R8A8Unorm;
+    // Resizing retires the old swapchain instead of idling the device, resize() overrides retire what they replace with ava::raii::retire
+    // Set when resize() rewrites objects frames in flight still use, such as descriptor sets
+    bool idleOnResize = false;
 
     void run()
     {
@@ -87,7 +90,10 @@ public:
 
             if (ava::resizeNeeded() || extent.width != width || extent.height != height)
             {
-                ava::deviceWaitIdle();
+                if (idleOnResize)
+                {
+                    ava::deviceWaitIdle();
+                }
                 resize();
             }
 
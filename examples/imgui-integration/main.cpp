@@ -121,6 +121,7 @@ public:
     {
         AvaFramework::resize();
 
+        ava::raii::retire(std::move(framebuffers));
         framebuffers = ava::raii::Framebuffer::createSwapchain(renderPass);
     }
 };
@@ -1,7 +1,9 @@
 #include <framework.hpp>
 #define TINYOBJLOADER_IMPLEMENTATION
 #define TINYOBJLOADER_USE_MAPBOX_EARCUT
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <tiny_obj_loader.h>
 
@@ -30,6 +32,13 @@ public:
 
     ~MultisampledMonkeys() override = default;
 
+    void configure(ava::CreateInfo& createInfo) override
+    {
+        // Culled monkeys are drawn with one indirect draw per surviving monkey
+        createInfo.deviceFeatures.multiDrawIndirect = true;
+        createInfo.deviceVulkan12Features.drawIndirectCount = true;
+    }
+
     ava::raii::RenderPass::Ptr renderPass;
     ava::raii::GraphicsPipeline::Ptr graphicsPipeline;
     std::vector<ava::raii::Framebuffer::Ptr> framebuffers;
@@ -48,6 +57,11 @@ public:
     ava::raii::Image::Ptr depthImage;
     ava::raii::ImageView::Ptr depthImageView;
 
+    ava::raii::CullingPass::Ptr cullingPass;
+    ava::raii::Buffer::Ptr cullingInstanceBuffer;
+    glm::vec4 monkeyBoundingSphere{};
+    glm::mat4 viewProjection{1.0f};
+
     void init() override
     {
         const auto vao = ava::raii::VAO::create({ava::VertexAttribute::CreateVec3(), ava::VertexAttribute::CreateVec3(), ava::VertexAttribute::CreateVec2()}); // Vertex
@@ -150,6 +164,22 @@ public:
 
             monkeyVertexCount = vertices.size();
             monkeyModel = ava::raii::VBO::create(vao, vertices);
+
+            // Bounding sphere around the model's bounding box
+            glm::vec3 minPosition{std::numeric_limits<float>::max()};
+            glm::vec3 maxPosition{std::numeric_limits<float>::lowest()};
+            for (const auto& vertex : vertices)
+            {
+                minPosition = glm::min(minPosition, vertex.position);
+                maxPosition = glm::max(maxPosition, vertex.position);
+            }
+            const auto center = (minPosition + maxPosition) * 0.5f;
+            float radius = 0.0f;
+            for (const auto& vertex : vertices)
+            {
+                radius = std::max(radius, glm::length(vertex.position - center));
+            }
+            monkeyBoundingSphere = glm::vec4(center, radius);
         }
 
         {
@@ -172,6 +202,16 @@ public:
         // Monkey descriptor set
         ubo = ava::raii::Buffer::create(sizeof(MVP) * MAX_MONKEYS, ava::DEFAULT_STORAGE_BUFFER_USAGE);
         set0->bindBuffer(0, ubo, sizeof(MVP) * MAX_MONKEYS, 0);
+
+        // Culling with the built-in shaders, depth here is multisampled and transient so only frustum culling is used (no Hi-Z pyramid)
+        {
+            ava::CullingPassCreationInfo creationInfo{};
+            ava::raii::populateCullingPassCreationInfo(creationInfo, nullptr, nullptr, MAX_MONKEYS, 1, false);
+            cullingPass = ava::raii::CullingPass::create(creationInfo);
+            cullingPass->updateDrawTemplates({ava::CullingDrawTemplate{monkeyVertexCount, 0, 0}});
+
+            cullingInstanceBuffer = ava::raii::Buffer::create(sizeof(ava::CullingInstance) * MAX_MONKEYS, ava::DEFAULT_STORAGE_BUFFER_USAGE);
+        }
     }
 
     void update() override
@@ -181,27 +221,40 @@ public:
         const auto view = glm::lookAt(glm::vec3{0.0f, 0.0f, -12.0f}, glm::vec3{0.0f, 0.0f, 0.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
         const auto projection = glm::perspective(glm::radians(45.0f), static_cast<float>(windowWidth) / static_cast<float>(windowHeight), 0.01f, 100.0f);
 
+        viewProjection = projection * view;
+
         std::vector<MVP> ubos(MAX_MONKEYS, MVP{});
+        std::vector<ava::CullingInstance> cullingInstances(MAX_MONKEYS, ava::CullingInstance{});
         for (uint32_t i = 0; i < MAX_MONKEYS; i++)
         {
             const auto t = time + static_cast<float>(i) * 0.5f;
             const auto rotation = glm::eulerAngleYXZ(std::sin(t + 0.125f) * glm::pi<float>() * 2.0f, std::cos(t * 0.7025f) * glm::pi<float>() * 2.0f, 0.0f);
             const auto model = monkeyStartMatrix[i] * rotation;
 
-            ubos[i].mvp = projection * view * model;
+            ubos[i].mvp = viewProjection * model;
+
+            std::memcpy(cullingInstances[i].transform, glm::value_ptr(model), sizeof(cullingInstances[i].transform));
+            std::memcpy(cullingInstances[i].boundingSphere, glm::value_ptr(monkeyBoundingSphere), sizeof(cullingInstances[i].boundingSphere));
+            cullingInstances[i].drawIndex = 0;
         }
         ubo->update(ubos);
+        cullingInstanceBuffer->update(cullingInstances);
     }
 
     void draw(const ava::raii::CommandBuffer::Ptr& commandBuffer, const uint32_t currentFrame, const uint32_t imageIndex) override
     {
+        const auto statistics = cullingPass->getStatistics();
+        glfwSetWindowTitle(window, (appTitle + " - " + std::to_string(statistics.visibleCount) + "/" + std::to_string(statistics.totalCount) + " visible").c_str());
+
+        cullingPass->record(commandBuffer, cullingInstanceBuffer, MAX_MONKEYS, glm::value_ptr(viewProjection), true, false);
+
         vk::ClearValue colorClearValue{{0.0f, 0.0f, 0.0f, 1.0f}};
         vk::ClearValue depthClearValue{{1.0f, 0u}};
         commandBuffer->beginRenderPass(renderPass, framebuffers.at(imageIndex), {colorClearValue, colorClearValue, depthClearValue});
         commandBuffer->bindGraphicsPipeline(graphicsPipeline);
         commandBuffer->bindVBO(monkeyModel);
         commandBuffer->bindDescriptorSet(set0);
-        commandBuffer->draw(monkeyVertexCount, MAX_MONKEYS);
+        cullingPass->draw(commandBuffer);
         commandBuffer->endRenderPass();
     }
 
@@ -218,12 +271,21 @@ public:
         pool.reset();
         monkeyModel.reset();
         ubo.reset();
+        cullingInstanceBuffer.reset();
+        cullingPass.reset();
     }
 
     void resize() override
     {
         AvaFramework::resize();
 
+        // Frames in flight may still be rendering with the old attachments
+        ava::raii::retire(std::move(framebuffers));
+        ava::raii::retire(std::move(msaaImageView));
+        ava::raii::retire(std::move(msaaImage));
+        ava::raii::retire(std::move(depthImageView));
+        ava::raii::retire(std::move(depthImage));
+
         const auto extent = vk::Extent3D{ava::getSwapchainExtent(), 1};
         msaaImage = ava::raii::Image::create(extent, surfaceFormat, ava::DEFAULT_IMAGE_COLOR_ATTACHMENT_USAGE_FLAGS | vk::ImageUsageFlagBits::eTransientAttachment, vk::ImageType::e2D, vk::ImageTiling::eOptimal, 1, 1, sampleCount, ava::MemoryLocation::eLazyGpu);
         msaaImageView = msaaImage->createImageView(vk::ImageAspectFlagBits::eColor);
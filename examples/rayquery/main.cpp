@@ -167,8 +167,7 @@ public:
 
             planeBLAS = ava::raii::BLAS::create(planeModel);
             cubeBLAS = ava::raii::BLAS::create(cubeModel);
-            planeBLAS->rebuild();
-            cubeBLAS->rebuild();
+            ava::raii::BLAS::buildBatch({planeBLAS, cubeBLAS});
 
             planeInstance = planeBLAS->createInstance();
             cubeInstances.reserve(cubeCount);
@@ -226,16 +225,7 @@ public:
             cubeInstances[i]->updateTransformMatrix(ava::getTransformMatrix44(glm::value_ptr(glm::transpose(model))));
         }
 
-        auto blasInstances = cubeInstances;
-        blasInstances.push_back(planeInstance);
-
         const auto currentFrame = ava::getCurrentFrame();
-        if (!tlases[currentFrame]->update(blasInstances))
-        {
-            std::cerr << "Failed to update TLAS, rebuilding\n";
-            tlases[currentFrame]->rebuild(blasInstances);
-        }
-
         for (int i = 0; i < cubeCount; i++)
         {
             cubeSets[i]->bindTLAS(1, tlases[currentFrame]);
@@ -247,6 +237,10 @@ public:
     {
         vk::ClearValue colorClearValue{{0.0f, 0.0f, 0.0f, 1.0f}};
         vk::ClearValue depthClearValue{{1.0f, 0u}};
+
+        // Only the instances moved in update() are written, the refit is recorded ahead of the render pass
+        tlases[currentFrame]->refit(commandBuffer);
+
         commandBuffer->beginRenderPass(renderPass, framebuffers.at(imageIndex), {colorClearValue, depthClearValue});
 
         commandBuffer->bindGraphicsPipeline(graphicsPipeline);
@@ -291,6 +285,11 @@ public:
         AvaFramework::resize();
         const auto extent = ava::getSwapchainExtent();
 
+        // Frames in flight may still be rendering with the old attachments
+        ava::raii::retire(std::move(framebuffers));
+        ava::raii::retire(std::move(depthImageView));
+        ava::raii::retire(std::move(depthImage));
+
         depthImage = ava::raii::Image::create2D(extent, depthFormat, ava::DEFAULT_IMAGE_DEPTH_ATTACHMENT_USAGE_FLAGS);
         depthImageView = depthImage->createImageView(vk::ImageAspectFlagBits::eDepth);
 
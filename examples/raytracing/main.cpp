@@ -33,6 +33,8 @@ class RayTracing : public AvaFramework
 public:
     RayTracing() : AvaFramework("AVA Ray Tracing")
     {
+        // resize() rebinds descriptor sets which frames in flight are still using
+        idleOnResize = true;
     }
 
     ~RayTracing() override = default;
@@ -156,7 +158,9 @@ public:
             const auto model = ava::raii::VBO::create(vao, vertices, 0);
 
             blas = ava::raii::BLAS::create(model);
-            blas->rebuild();
+            blas->rebuild(vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace | vk::BuildAccelerationStructureFlagBitsKHR::eAllowCompaction);
+
+            ava::raii::BLAS::compactBatch({blas});
         }
 
         objectBuffer = ava::raii::Buffer::create(sizeof(Object), vk::BufferUsageFlagBits::eStorageBuffer | ava::DEFAULT_TRANSFER_BUFFER_USAGE);
@@ -209,6 +209,11 @@ public:
     {
         AvaFramework::resize();
 
+        // Frames in flight may still be rendering with the old attachments
+        ava::raii::retire(std::move(framebuffers));
+        ava::raii::retire(std::move(depthImageView));
+        ava::raii::retire(std::move(depthImage));
+
         depthImage = ava::raii::Image::create2D(ava::getSwapchainExtent(), depthFormat, ava::DEFAULT_IMAGE_DEPTH_ATTACHMENT_USAGE_FLAGS);
         depthImageView = depthImage->createImageView(vk::ImageAspectFlagBits::eDepth);
 